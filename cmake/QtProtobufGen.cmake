@@ -5,7 +5,7 @@ function(qtprotobuf_link_target TARGET GENERATED_TARGET)
 endfunction()
 
 function(qtprotobuf_generate)
-    set(options MULTI QML COMMENTS FOLDER)
+    set(options MULTI QML COMMENTS FOLDER GADGET SHARED_DATA CONTIGUOUS_REPEATED HASH_MAPS COMPACT)
     set(oneValueArgs OUT_DIR TARGET GENERATED_TARGET)
     set(multiValueArgs GENERATED_HEADERS EXCLUDE_HEADERS PROTO_FILES PROTO_INCLUDES)
     cmake_parse_arguments(qtprotobuf_generate "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
@@ -47,6 +47,31 @@ function(qtprotobuf_generate)
         set(FOLDER_ENABLED "FOLDER")
     endif()
 
+    if(qtprotobuf_generate_GADGET)
+        message(STATUS "Enabled GADGET generation for ${GENERATED_TARGET_NAME}")
+        set(GENERATION_OPTIONS "${GENERATION_OPTIONS}:GADGET")
+    endif()
+
+    if(qtprotobuf_generate_SHARED_DATA)
+        message(STATUS "Enabled SHARED_DATA generation for ${GENERATED_TARGET_NAME}")
+        set(GENERATION_OPTIONS "${GENERATION_OPTIONS}:SHARED_DATA")
+    endif()
+
+    if(qtprotobuf_generate_CONTIGUOUS_REPEATED)
+        message(STATUS "Enabled CONTIGUOUS_REPEATED generation for ${GENERATED_TARGET_NAME}")
+        set(GENERATION_OPTIONS "${GENERATION_OPTIONS}:CONTIGUOUS_REPEATED")
+    endif()
+
+    if(qtprotobuf_generate_HASH_MAPS)
+        message(STATUS "Enabled HASH_MAPS generation for ${GENERATED_TARGET_NAME}")
+        set(GENERATION_OPTIONS "${GENERATION_OPTIONS}:HASH_MAPS")
+    endif()
+
+    if(qtprotobuf_generate_COMPACT)
+        message(STATUS "Enabled COMPACT generation for ${GENERATED_TARGET_NAME}")
+        set(GENERATION_OPTIONS "${GENERATION_OPTIONS}:COMPACT")
+    endif()
+
 
     if(WIN32)
         set(PROTOC_COMMAND set QT_PROTOBUF_OPTIONS=${GENERATION_OPTIONS}&& $<TARGET_FILE:protobuf::protoc>)
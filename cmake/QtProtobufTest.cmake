@@ -3,7 +3,7 @@ find_package(QtProtobufProject COMPONENTS QtProtobuf QtGrpc REQUIRED)
 include(${QT_PROTOBUF_CMAKE_DIR}/QtProtobufCommon.cmake)
 
 function(add_test_target)
-    set(options MULTI QML)
+    set(options MULTI QML GADGET SHARED_DATA CONTIGUOUS_REPEATED HASH_MAPS COMPACT)
     set(oneValueArgs QML_DIR TARGET)
     set(multiValueArgs SOURCES GENERATED_HEADERS EXCLUDE_HEADERS PROTO_FILES PROTO_INCLUDES)
     cmake_parse_arguments(add_test_target "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
@@ -33,6 +33,21 @@ function(add_test_target)
     if(add_test_target_QML)
         set(EXTRA_OPTIONS ${EXTRA_OPTIONS} QML)
     endif()
+    if(add_test_target_GADGET)
+        set(EXTRA_OPTIONS ${EXTRA_OPTIONS} GADGET)
+    endif()
+    if(add_test_target_SHARED_DATA)
+        set(EXTRA_OPTIONS ${EXTRA_OPTIONS} SHARED_DATA)
+    endif()
+    if(add_test_target_CONTIGUOUS_REPEATED)
+        set(EXTRA_OPTIONS ${EXTRA_OPTIONS} CONTIGUOUS_REPEATED)
+    endif()
+    if(add_test_target_HASH_MAPS)
+        set(EXTRA_OPTIONS ${EXTRA_OPTIONS} HASH_MAPS)
+    endif()
+    if(add_test_target_COMPACT)
+        set(EXTRA_OPTIONS ${EXTRA_OPTIONS} COMPACT)
+    endif()
 
     qtprotobuf_generate(TARGET ${add_test_target_TARGET}
         OUT_DIR ${GENERATED_SOURCES_DIR}
@@ -51,3 +66,18 @@ function(add_test_target)
         target_link_libraries(${add_test_target_TARGET} PUBLIC Qt5::Qml)
     endif()
 endfunction(add_test_target)
+
+# Adds test of generator options: builds TARGET from SOURCES and protobuf files of proto/ subdirectory, that are
+# generated with OPTIONS, and registers it in ctest
+function(add_option_test_target)
+    set(oneValueArgs TARGET)
+    set(multiValueArgs SOURCES OPTIONS)
+    cmake_parse_arguments(add_option_test_target "" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+    add_test_target(TARGET ${add_option_test_target_TARGET}
+        SOURCES ${add_option_test_target_SOURCES}
+        ${add_option_test_target_OPTIONS})
+    add_target_windeployqt(TARGET ${add_option_test_target_TARGET})
+
+    add_test(NAME ${add_option_test_target_TARGET} COMMAND ${add_option_test_target_TARGET})
+endfunction(add_option_test_target)
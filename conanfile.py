@@ -21,7 +21,6 @@ class QtProtobufConan(ConanFile):
         "protobuf/3.9.1",
         "protoc_installer/3.9.1@bincrafters/stable",
         "qt/5.14.2@bincrafters/stable",
-        "microjson/0.1.0@semlanik/stable",
     ]
     scm = {
         "type": "git",
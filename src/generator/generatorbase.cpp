@@ -85,7 +85,7 @@ void GeneratorBase::printInclude(const std::shared_ptr<::google::protobuf::io::P
     switch (field->type()) {
     case FieldDescriptor::TYPE_MESSAGE:
         if (field->is_map()) {
-            newInclude = "QMap";
+            newInclude = GeneratorOptions::instance().isHashMaps() ? "QHash" : "QMap";
             assert(field->message_type() != nullptr);
             assert(field->message_type()->field_count() == 2);
             printInclude(printer, message, field->message_type()->field(0), existingIncludes);
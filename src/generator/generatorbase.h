@@ -139,6 +139,9 @@ public:
                              ::google::protobuf::compiler::GeneratorContext *generatorContext,
                              std::string *error) const override;
     bool HasGenerateAll() const override { return true; }
+#if GOOGLE_PROTOBUF_VERSION >= 3012000
+    uint64_t GetSupportedFeatures() const override { return FEATURE_PROTO3_OPTIONAL; }
+#endif
 
     static void printDisclaimer(const std::shared_ptr<::google::protobuf::io::Printer> printer);
     static void printPreamble(const std::shared_ptr<::google::protobuf::io::Printer> printer);
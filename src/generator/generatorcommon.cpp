@@ -28,6 +28,7 @@
 
 #include "templates.h"
 #include <assert.h>
+#include <cstdio>
 
 using namespace ::QtProtobuf::generator;
 using namespace ::google::protobuf;
@@ -266,6 +267,115 @@ bool common::isPureMessage(const ::google::protobuf::FieldDescriptor *field)
     return field->type() == FieldDescriptor::TYPE_MESSAGE && !field->is_map() && !field->is_repeated() && !common::isQtType(field);
 }
 
+bool common::hasExplicitPresence(const ::google::protobuf::FieldDescriptor *field)
+{
+    //Active oneof field is serialized even if it holds default value
+    if (realOneof(field) != nullptr) {
+        return true;
+    }
+#if GOOGLE_PROTOBUF_VERSION >= 3012000
+    //Message fields are serialized when set, even if they hold default value
+    return field->has_optional_keyword() && field->type() != FieldDescriptor::TYPE_MESSAGE;
+#else
+    return false;
+#endif
+}
+
+bool common::isAlwaysPresent(const ::google::protobuf::FieldDescriptor *field)
+{
+    //Qt type fields are stored by value and always serialized, presence of message fields is set by their setters
+    return field->type() == FieldDescriptor::TYPE_MESSAGE && !field->is_repeated() && realOneof(field) == nullptr
+            && !isPureMessage(field);
+}
+
+bool common::isMovableType(const ::google::protobuf::FieldDescriptor *field)
+{
+    //Strings, byte arrays, containers and messages are moved cheaper than copied
+    return field->is_repeated()
+            || field->type() == FieldDescriptor::TYPE_MESSAGE
+            || field->type() == FieldDescriptor::TYPE_STRING
+            || field->type() == FieldDescriptor::TYPE_BYTES;
+}
+
+PropertyMap common::produceRvaluePropertyMap(const PropertyMap &propertyMap)
+{
+    PropertyMap rvalueMap(propertyMap);
+    const std::string &propertyName = propertyMap.at("property_name");
+    rvalueMap["setter_parameter"] = propertyMap.at("setter_type") + " &&" + propertyName;
+    rvalueMap["setter_value"] = "std::move(" + propertyName + ")";
+    return rvalueMap;
+}
+
+const OneofDescriptor *common::realOneof(const ::google::protobuf::FieldDescriptor *field)
+{
+#if GOOGLE_PROTOBUF_VERSION >= 3012000
+    //Fields of synthetic oneofs, that are generated for proto3 optional fields, are handled as regular fields
+    return field->real_containing_oneof();
+#else
+    return field->containing_oneof();
+#endif
+}
+
+bool common::isFirstOneofField(const ::google::protobuf::FieldDescriptor *field)
+{
+    const OneofDescriptor *oneof = realOneof(field);
+    return oneof != nullptr && oneof->field(0) == field;
+}
+
+PropertyMap common::produceOneofMap(const OneofDescriptor *oneof, const Descriptor *scope)
+{
+    assert(oneof != nullptr);
+
+    std::string oneofName;
+    bool capitalizeNext = false;
+    for (char symbol : oneof->name()) {
+        if (symbol == '_') {
+            capitalizeNext = !oneofName.empty();
+            continue;
+        }
+        oneofName += capitalizeNext ? static_cast<char>(::toupper(symbol)) : symbol;
+        capitalizeNext = false;
+    }
+    oneofName = utils::lowerCaseName(oneofName);
+
+    PropertyMap oneofMap;
+    oneofMap["oneof_name"] = oneofName;
+    oneofMap["oneof_name_cap"] = utils::upperCaseName(oneofName);
+    oneofMap["oneof_first_index"] = std::to_string(oneof->field(0)->index());
+    oneofMap["oneof_field_count"] = std::to_string(oneof->field_count());
+    //Fields of oneof are read from shared data without detaching
+    if (GeneratorOptions::instance().isSharedData()) {
+        oneofMap["oneof_storage"] = "d_ptr->m_" + oneofName;
+        oneofMap["oneof_const_storage"] = "d_ptr.constData()->m_" + oneofName;
+    } else {
+        oneofMap["oneof_storage"] = "m_" + oneofName;
+        oneofMap["oneof_const_storage"] = "m_" + oneofName;
+    }
+    oneofMap["classname"] = scope != nullptr ? utils::upperCaseName(scope->name()) : "";
+    return oneofMap;
+}
+
+std::string common::producePresenceWords(const ::google::protobuf::Descriptor *message, const std::function<bool(const ::google::protobuf::FieldDescriptor *)> &isSet)
+{
+    std::vector<uint32_t> words(static_cast<size_t>((message->field_count() + 31) / 32), 0);
+    for (int i = 0; i < message->field_count(); i++) {
+        if (isSet(message->field(i))) {
+            words[static_cast<size_t>(i / 32)] |= 1u << (i % 32);
+        }
+    }
+
+    std::string result;
+    for (uint32_t word : words) {
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "0x%x", word);
+        if (!result.empty()) {
+            result += ", ";
+        }
+        result += buffer;
+    }
+    return result;
+}
+
 TypeMap common::produceTypeMap(const FieldDescriptor *field, const Descriptor *scope)
 {
     TypeMap typeMap;
@@ -314,6 +424,13 @@ PropertyMap common::producePropertyMap(const FieldDescriptor *field, const Descr
     propertyMap["property_name"] = propertyName;
     propertyMap["property_name_cap"] = propertyNameCap;
     propertyMap["scriptable"] = scriptable;
+    propertyMap["field_index"] = std::to_string(field->index());
+    //Fields with implicit presence are marked as set only while they hold non-default value
+    if (hasExplicitPresence(field) || isPureMessage(field) || isAlwaysPresent(field)) {
+        propertyMap["presence_update"] = "set(" + propertyMap["field_index"] + ")";
+    } else {
+        propertyMap["presence_update"] = "update(" + propertyMap["field_index"] + ", " + propertyName + ")";
+    }
 
     propertyMap["key_type"] = "";
     propertyMap["value_type"] = "";
@@ -330,6 +447,15 @@ PropertyMap common::producePropertyMap(const FieldDescriptor *field, const Descr
         propertyMap["getter_type"] = propertyMap["scope_list_type"];
         propertyMap["setter_type"] = propertyMap["scope_list_type"];
     }
+    propertyMap["setter_parameter"] = "const " + propertyMap["setter_type"] + " &" + propertyName;
+    propertyMap["setter_value"] = propertyName;
+
+    const OneofDescriptor *oneof = realOneof(field);
+    if (oneof != nullptr) {
+        auto oneofMap = produceOneofMap(oneof, scope);
+        propertyMap.insert(oneofMap.begin(), oneofMap.end());
+        propertyMap["field_number"] = std::to_string(field->number());
+    }
 
     return propertyMap;
 }
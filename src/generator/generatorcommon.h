@@ -75,6 +75,14 @@ struct common {
     static bool hasQmlAlias(const ::google::protobuf::FieldDescriptor *field);
     static bool isQtType(const ::google::protobuf::FieldDescriptor *field);
     static bool isPureMessage(const ::google::protobuf::FieldDescriptor *field);
+    static bool hasExplicitPresence(const ::google::protobuf::FieldDescriptor *field);
+    static bool isAlwaysPresent(const ::google::protobuf::FieldDescriptor *field);
+    static bool isMovableType(const ::google::protobuf::FieldDescriptor *field);
+    static PropertyMap produceRvaluePropertyMap(const PropertyMap &propertyMap);
+    static const ::google::protobuf::OneofDescriptor *realOneof(const ::google::protobuf::FieldDescriptor *field);
+    static bool isFirstOneofField(const ::google::protobuf::FieldDescriptor *field);
+    static PropertyMap produceOneofMap(const ::google::protobuf::OneofDescriptor *oneof, const ::google::protobuf::Descriptor *scope);
+    static std::string producePresenceWords(const ::google::protobuf::Descriptor *message, const std::function<bool(const ::google::protobuf::FieldDescriptor *)> &isSet);
 
     using InterateMessageLogic = std::function<void(const ::google::protobuf::FieldDescriptor *, PropertyMap &)>;
     static void iterateMessageFields(const ::google::protobuf::Descriptor *message, InterateMessageLogic callback) {
@@ -85,6 +93,18 @@ struct common {
         }
     }
 
+    using IterateOneofLogic = std::function<void(const ::google::protobuf::OneofDescriptor *, PropertyMap &)>;
+    static void iterateOneofs(const ::google::protobuf::Descriptor *message, IterateOneofLogic callback) {
+        for (int i = 0; i < message->oneof_decl_count(); i++) {
+            const ::google::protobuf::OneofDescriptor *oneof = message->oneof_decl(i);
+            if (oneof->field_count() <= 0 || realOneof(oneof->field(0)) != oneof) {
+                continue; //Synthetic oneof of proto3 optional field
+            }
+            auto oneofMap = common::produceOneofMap(oneof, message);
+            callback(oneof, oneofMap);
+        }
+    }
+
     static MethodMap produceMethodMap(const ::google::protobuf::MethodDescriptor *method, const std::string &scope); //TODO: scope should be ServiceDescriptor
 
     static void iterateMessages(const ::google::protobuf::FileDescriptor *file, std::function<void(const ::google::protobuf::Descriptor *)> callback);
@@ -33,6 +33,11 @@ static const std::string MultifileBuildOption("MULTI");
 static const std::string QmlPluginOption("QML");
 static const std::string CommentsGenerationOption("COMMENTS");
 static const std::string FolderGenerationOption("FOLDER");
+static const std::string GadgetGenerationOption("GADGET");
+static const std::string SharedDataGenerationOption("SHARED_DATA");
+static const std::string ContiguousRepeatedGenerationOption("CONTIGUOUS_REPEATED");
+static const std::string HashMapsGenerationOption("HASH_MAPS");
+static const std::string CompactGenerationOption("COMPACT");
 
 
 using namespace ::QtProtobuf::generator;
@@ -41,6 +46,11 @@ GeneratorOptions::GeneratorOptions() : mIsMulti(false)
   , mHasQml(false)
   , mGenerateComments(false)
   , mIsFolder(false)
+  , mIsGadget(false)
+  , mIsSharedData(false)
+  , mIsContiguousRepeated(false)
+  , mIsHashMaps(false)
+  , mIsCompact(false)
 {
 }
 
@@ -61,6 +71,31 @@ void GeneratorOptions::parseFromEnv(const std::string &options)
         } else if (option.compare(FolderGenerationOption) == 0) {
             QT_PROTOBUF_DEBUG("set mIsFolder: true");
             mIsFolder = true;
+        } else if (option.compare(GadgetGenerationOption) == 0) {
+            QT_PROTOBUF_DEBUG("set mIsGadget: true");
+            mIsGadget = true;
+        } else if (option.compare(SharedDataGenerationOption) == 0) {
+            QT_PROTOBUF_DEBUG("set mIsSharedData: true");
+            mIsSharedData = true;
+        } else if (option.compare(ContiguousRepeatedGenerationOption) == 0) {
+            QT_PROTOBUF_DEBUG("set mIsContiguousRepeated: true");
+            mIsContiguousRepeated = true;
+        } else if (option.compare(HashMapsGenerationOption) == 0) {
+            QT_PROTOBUF_DEBUG("set mIsHashMaps: true");
+            mIsHashMaps = true;
+        } else if (option.compare(CompactGenerationOption) == 0) {
+            QT_PROTOBUF_DEBUG("set mIsCompact: true");
+            mIsCompact = true;
         }
     }
 }
+
+bool GeneratorOptions::checkCompatibility(std::string *error) const
+{
+    //QVector relocates its elements, while QObject messages are referred by address from QML and parent objects
+    if (mIsContiguousRepeated && !mIsGadget) {
+        *error = "CONTIGUOUS_REPEATED option is supported only in combination with GADGET option";
+        return false;
+    }
+    return true;
+}
@@ -45,17 +45,32 @@ public:
     }
 
     void parseFromEnv(const std::string &options);
+    bool checkCompatibility(std::string *error) const;
 
     bool isMulti() const { return mIsMulti; }
     bool hasQml() const { return mHasQml; }
     bool generateComments() const { return mGenerateComments; }
     bool isFolder() const { return mIsFolder; }
+    bool isGadget() const { return mIsGadget; }
+    bool isSharedData() const { return mIsSharedData; }
+    bool isContiguousRepeated() const { return mIsContiguousRepeated; }
+    /*!
+     * \brief Returns true if map fields are generated as QHash. Map entries are serialized in QHash iteration
+     *        order, that depends on hash seed, so serialized output of map fields is not deterministic
+     */
+    bool isHashMaps() const { return mIsHashMaps; }
+    bool isCompact() const { return mIsCompact; }
 
 private:
     bool mIsMulti;
     bool mHasQml;
     bool mGenerateComments;
     bool mIsFolder;
+    bool mIsGadget;
+    bool mIsSharedData;
+    bool mIsContiguousRepeated;
+    bool mIsHashMaps;
+    bool mIsCompact;
 };
 
 }}
@@ -55,7 +55,7 @@ void MessageDeclarationPrinter::printClassForwardDeclarationPrivate()
     }
 
     mPrinter->Print({{"classname", mName}}, Templates::ProtoClassForwardDeclarationTemplate);
-    mPrinter->Print({{"classname", mName}}, Templates::ComplexListTypeUsingTemplate);
+    printListType();
 }
 
 void MessageDeclarationPrinter::printClassForwardDeclaration()
@@ -124,31 +124,38 @@ void MessageDeclarationPrinter::printConstructors()
     }
 
     if (mDescriptor->full_name() == std::string("google.protobuf.Timestamp")) {
-        mPrinter->Print("Timestamp(const QDateTime &datetime, QObject *parent = nullptr);\n"
-                        "operator QDateTime() const;\n");
+        if (GeneratorOptions::instance().isGadget()) {
+            mPrinter->Print("Timestamp(const QDateTime &datetime);\n"
+                            "operator QDateTime() const;\n");
+        } else {
+            mPrinter->Print("Timestamp(const QDateTime &datetime, QObject *parent = nullptr);\n"
+                            "operator QDateTime() const;\n");
+        }
     }
 }
 
 void MessageDeclarationPrinter::printConstructor(int fieldCount)
 {
-    std::vector<std::string> parameterList;
+    bool isGadget = GeneratorOptions::instance().isGadget();
     mPrinter->Print({{"classname", mName}}, Templates::ProtoConstructorBeginTemplate);
     for (int i = 0; i < fieldCount; i++) {
+        //Gadget constructors have no trailing QObject *parent parameter
+        if (i != 0 && isGadget) {
+            mPrinter->Print(", ");
+        }
         const FieldDescriptor *field = mDescriptor->field(i);
+        //Parameters are taken by value, so temporaries are moved to fields without copying
         const char *parameterTemplate = Templates::ConstructorParameterTemplate;
-        FieldDescriptor::Type fieldType = field->type();
         if (field->is_repeated() && !field->is_map()) {
             parameterTemplate = Templates::ConstructorRepeatedParameterTemplate;
-        } else if (fieldType == FieldDescriptor::TYPE_BYTES
-                  || fieldType == FieldDescriptor::TYPE_STRING
-                  || fieldType == FieldDescriptor::TYPE_MESSAGE
-                  || field->is_map()) {
-            parameterTemplate = Templates::ConstructorMessageParameterTemplate;
         }
         mPrinter->Print(common::producePropertyMap(field, mDescriptor), parameterTemplate);
+        if (!isGadget) {
+            mPrinter->Print(",");
+        }
     }
 
-    mPrinter->Print({{"classname", mName}}, Templates::ProtoConstructorEndTemplate);
+    mPrinter->Print({{"classname", mName}}, isGadget ? Templates::GadgetConstructorEndTemplate : Templates::ProtoConstructorEndTemplate);
 }
 
 void MessageDeclarationPrinter::printMaps()
@@ -158,7 +165,12 @@ void MessageDeclarationPrinter::printMaps()
         const FieldDescriptor *field = mDescriptor->field(i);
         if (field->is_map()) {
             const Descriptor *type = field->message_type();
-            const char *mapTemplate = type->field(1)->type() == FieldDescriptor::TYPE_MESSAGE ? Templates::MessageMapTypeUsingTemplate : Templates::MapTypeUsingTemplate;
+            bool isMessageValue = type->field(1)->type() == FieldDescriptor::TYPE_MESSAGE
+                    && !GeneratorOptions::instance().isGadget();
+            const char *mapTemplate = isMessageValue ? Templates::MessageMapTypeUsingTemplate : Templates::MapTypeUsingTemplate;
+            if (GeneratorOptions::instance().isHashMaps()) {
+                mapTemplate = isMessageValue ? Templates::MessageHashMapTypeUsingTemplate : Templates::HashMapTypeUsingTemplate;
+            }
             mPrinter->Print(common::producePropertyMap(field, mDescriptor), mapTemplate);
         }
     }
@@ -176,7 +188,8 @@ void MessageDeclarationPrinter::printNested()
 
 void MessageDeclarationPrinter::printClassDeclarationBegin()
 {
-    mPrinter->Print({{"classname", mName}}, Templates::ProtoClassDeclarationBeginTemplate);
+    mPrinter->Print({{"classname", mName}}, GeneratorOptions::instance().isGadget() ? Templates::GadgetClassDeclarationBeginTemplate
+                                                                                    : Templates::ProtoClassDeclarationBeginTemplate);
 }
 
 void MessageDeclarationPrinter::printMetaTypesDeclaration()
@@ -186,7 +199,7 @@ void MessageDeclarationPrinter::printMetaTypesDeclaration()
     mPrinter->Print(mTypeMap,
                    Templates::DeclareComplexListTypeTemplate);
 
-    if (GeneratorOptions::instance().hasQml()) {
+    if (GeneratorOptions::instance().hasQml() && !GeneratorOptions::instance().isGadget()) {
         mPrinter->Print(mTypeMap,
                         Templates::DeclareComplexQmlListTypeTemplate);
     }
@@ -218,6 +231,12 @@ void MessageDeclarationPrinter::printProperties()
     //private section
     Indent();
 
+    if (GeneratorOptions::instance().isGadget()) {
+        printGadgetProperties();
+        Outdent();
+        return;
+    }
+
     for (int i = 0; i < mDescriptor->field_count(); i++) {
         const FieldDescriptor *field = mDescriptor->field(i);
         const char *propertyTemplate = Templates::PropertyTemplate;
@@ -245,24 +264,60 @@ void MessageDeclarationPrinter::printProperties()
     Outdent();
 }
 
+void MessageDeclarationPrinter::printGadgetProperties()
+{
+    //Gadget properties are value-typed and have no NOTIFY signals
+    for (int i = 0; i < mDescriptor->field_count(); i++) {
+        const FieldDescriptor *field = mDescriptor->field(i);
+        const char *propertyTemplate = Templates::GadgetPropertyTemplate;
+        if (common::hasQmlAlias(field)) {
+            propertyTemplate = Templates::GadgetNonScriptablePropertyTemplate;
+        } else if (field->is_repeated() && !field->is_map()) {
+            propertyTemplate = Templates::GadgetRepeatedPropertyTemplate;
+        }
+        mPrinter->Print(common::producePropertyMap(field, mDescriptor), propertyTemplate);
+    }
+
+    for (int i = 0; i < mDescriptor->field_count(); i++) {
+        const FieldDescriptor *field = mDescriptor->field(i);
+        if (common::hasQmlAlias(field)) {
+            mPrinter->Print(common::producePropertyMap(field, mDescriptor), Templates::GadgetNonScriptableAliasPropertyTemplate);
+        }
+    }
+}
+
 void MessageDeclarationPrinter::printGetters()
 {
+    bool isGadget = GeneratorOptions::instance().isGadget();
+    bool isSharedData = GeneratorOptions::instance().isSharedData();
     Indent();
 
     common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, const PropertyMap &propertyMap) {
         printComments(field);
         mPrinter->Print("\n");
+        if (common::realOneof(field) != nullptr) {
+            printOneofGetters(field, propertyMap);
+            return;
+        }
         if (common::isPureMessage(field)) {
-            mPrinter->Print(propertyMap, Templates::GetterPrivateMessageDeclarationTemplate);
+            if (!isGadget) {
+                mPrinter->Print(propertyMap, Templates::GetterPrivateMessageDeclarationTemplate);
+            }
             mPrinter->Print(propertyMap, Templates::GetterMessageDeclarationTemplate);
+            //Unset message fields are read as default instance, presence is tracked in presence bitmap
+            mPrinter->Print(propertyMap, Templates::HasFieldTemplate);
         } else {
-            mPrinter->Print(propertyMap, Templates::GetterTemplate);
+            mPrinter->Print(propertyMap, isSharedData ? Templates::SharedGetterTemplate : Templates::GetterTemplate);
+            if (common::hasExplicitPresence(field)) {
+                mPrinter->Print(propertyMap, Templates::HasFieldTemplate);
+            }
         }
 
         if (field->is_repeated()) {
-            mPrinter->Print(propertyMap, Templates::GetterContainerExtraTemplate);
+            mPrinter->Print(propertyMap, isSharedData ? Templates::SharedGetterContainerExtraTemplate
+                                                      : Templates::GetterContainerExtraTemplate);
             if (field->type() == FieldDescriptor::TYPE_MESSAGE && !field->is_map()
-                    && GeneratorOptions::instance().hasQml()) {
+                    && GeneratorOptions::instance().hasQml() && !isGadget) {
                 mPrinter->Print(propertyMap, Templates::GetterQmlListDeclarationTemplate);
             }
         }
@@ -270,27 +325,130 @@ void MessageDeclarationPrinter::printGetters()
     Outdent();
 }
 
+void MessageDeclarationPrinter::printOneofGetters(const FieldDescriptor *field, const PropertyMap &propertyMap)
+{
+    //Value of oneof field is stored in QVariant, so accessors are defined in source file, where all meta types are declared
+    if (common::isPureMessage(field)) {
+        if (!GeneratorOptions::instance().isGadget()) {
+            mPrinter->Print(propertyMap, Templates::GetterPrivateMessageDeclarationTemplate);
+        }
+        mPrinter->Print(propertyMap, Templates::GetterMessageDeclarationTemplate);
+    } else {
+        mPrinter->Print(propertyMap, Templates::OneofGetterDeclarationTemplate);
+    }
+    mPrinter->Print(propertyMap, Templates::OneofHasFieldTemplate);
+}
+
 void MessageDeclarationPrinter::printSetters()
 {
     Indent();
+    if (GeneratorOptions::instance().isGadget()) {
+        printGadgetSetters();
+        Outdent();
+        return;
+    }
     common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, const PropertyMap &propertyMap) {
+        if (common::realOneof(field) != nullptr) {
+            if (common::isPureMessage(field)) {
+                mPrinter->Print(propertyMap, Templates::SetterPrivateTemplateDeclarationMessageType);
+            }
+            printSetter(field, propertyMap, Templates::SetterTemplateDeclarationComplexType);
+            printClearer(field, propertyMap);
+            return;
+        }
         switch (field->type()) {
         case FieldDescriptor::TYPE_MESSAGE:
             if (!field->is_map() && !field->is_repeated() && !common::isQtType(field)) {
                 mPrinter->Print(propertyMap, Templates::SetterPrivateTemplateDeclarationMessageType);
-                mPrinter->Print(propertyMap, Templates::SetterTemplateDeclarationMessageType);
+                printSetter(field, propertyMap, Templates::SetterTemplateDeclarationMessageType);
             } else {
-                mPrinter->Print(propertyMap, Templates::SetterTemplateDeclarationComplexType);
+                printSetter(field, propertyMap, Templates::SetterTemplateDeclarationComplexType);
             }
             break;
         case FieldDescriptor::FieldDescriptor::TYPE_STRING:
         case FieldDescriptor::FieldDescriptor::TYPE_BYTES:
-            mPrinter->Print(propertyMap, Templates::SetterTemplateDeclarationComplexType);
+            printSetter(field, propertyMap, Templates::SetterTemplateDeclarationComplexType);
             break;
         default:
-            mPrinter->Print(propertyMap, Templates::SetterTemplate);
+            printSetter(field, propertyMap, GeneratorOptions::instance().isSharedData() ? Templates::SharedSetterTemplate
+                                                                                        : Templates::SetterTemplate);
             break;
         }
+        printClearer(field, propertyMap);
+    });
+    Outdent();
+}
+
+void MessageDeclarationPrinter::printGadgetSetters()
+{
+    common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, const PropertyMap &propertyMap) {
+        if (common::realOneof(field) != nullptr) {
+            printSetter(field, propertyMap, Templates::SetterTemplateDeclarationComplexType);
+            printClearer(field, propertyMap);
+            return;
+        }
+        switch (field->type()) {
+        case FieldDescriptor::TYPE_MESSAGE:
+            if (!field->is_map() && !field->is_repeated() && !common::isQtType(field)) {
+                //Complete message type is not known here, setter is defined in source file
+                printSetter(field, propertyMap, Templates::SetterTemplateDeclarationMessageType);
+            } else {
+                printSetter(field, propertyMap, Templates::SetterTemplateDeclarationComplexType);
+            }
+            break;
+        case FieldDescriptor::FieldDescriptor::TYPE_STRING:
+        case FieldDescriptor::FieldDescriptor::TYPE_BYTES:
+            printSetter(field, propertyMap, Templates::SetterTemplateDeclarationComplexType);
+            break;
+        default:
+            printSetter(field, propertyMap, GeneratorOptions::instance().isSharedData() ? Templates::SharedGadgetSetterTemplate
+                                                                                        : Templates::GadgetSetterTemplate);
+            break;
+        }
+        printClearer(field, propertyMap);
+    });
+}
+
+void MessageDeclarationPrinter::printSetter(const FieldDescriptor *field, const PropertyMap &propertyMap, const char *setterTemplate)
+{
+    mPrinter->Print(propertyMap, setterTemplate);
+    if (common::isMovableType(field)) {
+        mPrinter->Print(common::produceRvaluePropertyMap(propertyMap), setterTemplate);
+    }
+}
+
+void MessageDeclarationPrinter::printClearer(const FieldDescriptor *field, const PropertyMap &propertyMap)
+{
+    if (common::realOneof(field) != nullptr) {
+        mPrinter->Print(propertyMap, Templates::OneofClearFieldTemplate);
+    } else if (common::isPureMessage(field)) {
+        //Complete message type is not known here, field is released in source file
+        mPrinter->Print(propertyMap, Templates::ClearMessageFieldDeclarationTemplate);
+    } else if (common::isAlwaysPresent(field)) {
+        mPrinter->Print(propertyMap, Templates::ClearQtTypeFieldTemplate);
+    } else {
+        mPrinter->Print(propertyMap, Templates::ClearFieldTemplate);
+    }
+}
+
+void MessageDeclarationPrinter::printOneofs()
+{
+    Indent();
+    common::iterateOneofs(mDescriptor, [&](const OneofDescriptor *oneof, const PropertyMap &oneofMap) {
+        //Enumerators of oneof case are field numbers, so case is read directly from oneof storage
+        mPrinter->Print(oneofMap, Templates::OneofCaseEnumTemplate);
+        Indent();
+        mPrinter->Print({{"enumvalue", "NotSet"}, {"value", "0"}}, Templates::EnumFieldTemplate);
+        for (int i = 0; i < oneof->field_count(); i++) {
+            const FieldDescriptor *field = oneof->field(i);
+            mPrinter->Print({{"enumvalue", common::producePropertyMap(field, mDescriptor)["property_name_cap"]},
+                             {"value", std::to_string(field->number())}}, Templates::EnumFieldTemplate);
+        }
+        Outdent();
+        mPrinter->Print(Templates::SemicolonBlockEnclosureTemplate);
+        mPrinter->Print("\n");
+        mPrinter->Print(oneofMap, Templates::OneofCaseGetterTemplate);
+        mPrinter->Print(oneofMap, Templates::OneofClearTemplate);
     });
     Outdent();
 }
@@ -307,11 +465,23 @@ void MessageDeclarationPrinter::printSignals()
 
 void MessageDeclarationPrinter::printPrivateMethods()
 {
+    bool isGadget = GeneratorOptions::instance().isGadget();
+    bool isSharedData = GeneratorOptions::instance().isSharedData();
     Indent();
     common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, const PropertyMap &propertyMap) {
-        if (common::hasQmlAlias(field)) {
-            mPrinter->Print(propertyMap, Templates::NonScriptableGetterTemplate);
-            mPrinter->Print(propertyMap, Templates::NonScriptableSetterTemplate);
+        if (common::hasQmlAlias(field) && common::realOneof(field) != nullptr) {
+            mPrinter->Print(propertyMap, Templates::OneofNonScriptableGetterTemplate);
+            mPrinter->Print(propertyMap, Templates::OneofNonScriptableSetterTemplate);
+        } else if (common::hasQmlAlias(field)) {
+            mPrinter->Print(propertyMap, isSharedData ? Templates::SharedNonScriptableGetterTemplate
+                                                      : Templates::NonScriptableGetterTemplate);
+            if (isGadget) {
+                mPrinter->Print(propertyMap, isSharedData ? Templates::SharedGadgetNonScriptableSetterTemplate
+                                                          : Templates::GadgetNonScriptableSetterTemplate);
+            } else {
+                mPrinter->Print(propertyMap, isSharedData ? Templates::SharedNonScriptableSetterTemplate
+                                                          : Templates::NonScriptableSetterTemplate);
+            }
         }
     });
     Outdent();
@@ -370,13 +540,16 @@ void MessageDeclarationPrinter::printClassBody()
 
     printGetters();
     printSetters();
+    printOneofs();
 
     Indent();
     mPrinter->Print({{"classname", mName}}, Templates::ManualRegistrationDeclaration);
     Outdent();
 
-    printSignalsBlock();
-    printSignals();
+    if (!GeneratorOptions::instance().isGadget()) {
+        printSignalsBlock();
+        printSignals();
+    }
 
     printPrivateBlock();
     printPrivateMethods();
@@ -387,14 +560,63 @@ void MessageDeclarationPrinter::printClassBody()
 
 void MessageDeclarationPrinter::printListType()
 {
-    mPrinter->Print({{"classname", mName}}, Templates::ComplexListTypeUsingTemplate);
+    const char *listTypeTemplate = Templates::ComplexListTypeUsingTemplate;
+    if (GeneratorOptions::instance().isContiguousRepeated()) {
+        listTypeTemplate = Templates::ContiguousListTypeUsingTemplate;
+    } else if (GeneratorOptions::instance().isGadget()) {
+        listTypeTemplate = Templates::GadgetListTypeUsingTemplate;
+    }
+    mPrinter->Print({{"classname", mName}}, listTypeTemplate);
 }
 
 void MessageDeclarationPrinter::printClassMembers()
 {
     Indent();
+    if (GeneratorOptions::instance().isSharedData()) {
+        //Fields are stored in implicitly shared data, that is detached by non-const access
+        mPrinter->Print(Templates::SharedDataClassDeclarationTemplate);
+        Indent();
+        printFieldMembers();
+        Outdent();
+        encloseClass();
+        mPrinter->Print(Templates::SharedDataMemberTemplate);
+    } else {
+        printFieldMembers();
+    }
+    printPresenceMembers();
+    Outdent();
+}
+
+void MessageDeclarationPrinter::printPresenceMembers()
+{
+    if (mDescriptor->field_count() <= 0) {
+        return;
+    }
+
+    //Pointer properties of message fields are const, but mark fields as set, since fields are writable through them
+    bool hasPointerProperties = false;
+    if (!GeneratorOptions::instance().isGadget()) {
+        for (int i = 0; i < mDescriptor->field_count(); i++) {
+            const FieldDescriptor *field = mDescriptor->field(i);
+            hasPointerProperties |= common::isPureMessage(field) && common::realOneof(field) == nullptr;
+        }
+    }
+
+    //Presence bitmap is not shared, so setting of field to its current value doesn't detach shared data
+    mPrinter->Print(Templates::PresenceInfoDeclarationTemplate);
+    mPrinter->Print({{"field_count", std::to_string(mDescriptor->field_count())},
+                     {"mutable", hasPointerProperties ? "mutable " : ""}}, Templates::PresenceMemberTemplate);
+}
+
+void MessageDeclarationPrinter::printFieldMembers()
+{
     common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, const PropertyMap &propertyMap) {
-        if (common::isPureMessage(field)) {
+        if (common::realOneof(field) != nullptr) {
+            //All fields of oneof share single storage
+            if (common::isFirstOneofField(field)) {
+                mPrinter->Print(propertyMap, Templates::OneofMemberTemplate);
+            }
+        } else if (common::isPureMessage(field)) {
             mPrinter->Print(propertyMap, Templates::ComplexMemberTemplate);
         } else if (field->is_repeated() && !field->is_map()) {
              mPrinter->Print(propertyMap, Templates::ListMemberTemplate);
@@ -402,10 +624,13 @@ void MessageDeclarationPrinter::printClassMembers()
             mPrinter->Print(propertyMap, Templates::MemberTemplate);
         }
     });
-    Outdent();
 }
 
 void MessageDeclarationPrinter::printDestructor()
 {
-    mPrinter->Print({{"classname", mName}}, "virtual ~$classname$();\n");
+    if (GeneratorOptions::instance().isGadget()) {
+        mPrinter->Print({{"classname", mName}}, "~$classname$();\n");
+    } else {
+        mPrinter->Print({{"classname", mName}}, "virtual ~$classname$();\n");
+    }
 }
@@ -51,11 +51,19 @@ private:
     void printComparisonOperators();
     void printClassBody();
     void printProperties();
+    void printGadgetProperties();
     void printGetters();
+    void printOneofGetters(const ::google::protobuf::FieldDescriptor *field, const PropertyMap &propertyMap);
     void printSetters();
+    void printGadgetSetters();
+    void printSetter(const ::google::protobuf::FieldDescriptor *field, const PropertyMap &propertyMap, const char *setterTemplate);
+    void printClearer(const ::google::protobuf::FieldDescriptor *field, const PropertyMap &propertyMap);
+    void printOneofs();
     void printSignals();
     void printPrivateMethods();
     void printClassMembers();
+    void printFieldMembers();
+    void printPresenceMembers();
     void printConstructor(int fieldCount);
     void printConstructors();
     void printDestructor();
@@ -26,6 +26,10 @@
 #include "messagedefinitionprinter.h"
 
 #include <google/protobuf/descriptor.h>
+
+#include <algorithm>
+#include <vector>
+
 #include "generatoroptions.h"
 
 using namespace QtProtobuf::generator;
@@ -49,6 +53,9 @@ void MessageDefinitionPrinter::printClassDefinitionPrivate()
     }
 
     printDestructor();
+    if (GeneratorOptions::instance().isSharedData()) {
+        printSharedData();
+    }
     printFieldsOrdering();
     printRegisterBody();
     printConstructors();
@@ -67,20 +74,25 @@ void MessageDefinitionPrinter::printClassDefinition()
 
 void MessageDefinitionPrinter::printRegisterBody()
 {
-    mPrinter->Print(mTypeMap,
-                    Templates::ManualRegistrationComplexTypeDefinition);
+    bool isGadget = GeneratorOptions::instance().isGadget();
+    mPrinter->Print(mTypeMap, isGadget ? Templates::GadgetManualRegistrationComplexTypeDefinition
+                                       : Templates::ManualRegistrationComplexTypeDefinition);
     Indent();
-    if (GeneratorOptions::instance().hasQml()) {
+    if (GeneratorOptions::instance().hasQml() && !isGadget) {
         mPrinter->Print(mTypeMap, Templates::RegisterQmlListPropertyMetaTypeTemplate);
         mPrinter->Print(mTypeMap, Templates::QmlRegisterTypeTemplate);
     }
+    if (GeneratorOptions::instance().isContiguousRepeated()) {
+        mPrinter->Print(mTypeMap, Templates::RegisterContiguousListTemplate);
+    }
 
     common::iterateMessageFields(mDescriptor, [this](const FieldDescriptor *field, const PropertyMap &propertyMap) {
         if (field->type() == FieldDescriptor::TYPE_ENUM
                 && common::isLocalEnum(field->enum_type(), mDescriptor)) {
             mPrinter->Print(propertyMap, Templates::RegisterLocalEnumTemplate);
         } else if (field->is_map()) {
-            mPrinter->Print(propertyMap, Templates::RegisterMapTemplate);
+            mPrinter->Print(propertyMap, GeneratorOptions::instance().isHashMaps() ? Templates::RegisterHashMapTemplate
+                                                                                   : Templates::RegisterMapTemplate);
         }
     });
 
@@ -89,67 +101,213 @@ void MessageDefinitionPrinter::printRegisterBody()
 }
 
 void MessageDefinitionPrinter::printFieldsOrdering() {
-    mPrinter->Print({{"type", mName}}, Templates::FieldsOrderingContainerTemplate);
-    Indent();
+    bool hasPresence = mDescriptor->field_count() > 0;
+    bool isGadget = GeneratorOptions::instance().isGadget();
+    if (hasPresence) {
+        //Fields are sorted by field number, QProtobufPropertyOrdering looks up fields using binary search
+        std::vector<const FieldDescriptor *> fields;
+        for (int i = 0; i < mDescriptor->field_count(); i++) {
+            fields.push_back(mDescriptor->field(i));
+        }
+        std::sort(fields.begin(), fields.end(), [](const FieldDescriptor *a, const FieldDescriptor *b) {
+            return a->number() < b->number();
+        });
+
+        mPrinter->Print({{"type", mName}}, Templates::FieldsOrderingArrayTemplate);
+        Indent();
+        for (size_t i = 0; i < fields.size(); i++) {
+            const FieldDescriptor *field = fields[i];
+            if (i != 0) {
+                mPrinter->Print("\n,");
+            }
+            //property_number is incremented by 1 because user properties stating from 1.
+            //Property with index 0 is "objectName". Gadgets have no "objectName" property.
+            int propertyOffset = isGadget ? 0 : 1;
+            mPrinter->Print({{"field_number", std::to_string(field->number())},
+                             {"property_number", std::to_string(field->index() + propertyOffset)}}, Templates::FieldOrderTemplate);
+        }
+        Outdent();
+        mPrinter->Print(Templates::FieldsOrderingArrayEndTemplate);
+    }
+
+    mPrinter->Print({{"type", mName}, {"is_gadget", isGadget ? "true" : "false"}},
+                    hasPresence ? Templates::FieldsOrderingContainerPresenceTemplate : Templates::FieldsOrderingContainerTemplate);
+    mPrinter->Print("\n");
+
+    if (hasPresence) {
+        printPresenceInfo();
+    }
+}
+
+void MessageDefinitionPrinter::printPresenceInfo()
+{
+    std::string fieldNumbers;
     for (int i = 0; i < mDescriptor->field_count(); i++) {
-        const FieldDescriptor *field = mDescriptor->field(i);
         if (i != 0) {
-            mPrinter->Print("\n,");
+            fieldNumbers += ", ";
         }
-        //property_number is incremented by 1 because user properties stating from 1.
-        //Property with index 0 is "objectName"
-        mPrinter->Print({{"field_number", std::to_string(field->number())},
-                         {"property_number", std::to_string(i + 1)}}, Templates::FieldOrderTemplate);
+        fieldNumbers += std::to_string(mDescriptor->field(i)->number());
     }
-    Outdent();
-    mPrinter->Print(Templates::SemicolonBlockEnclosureTemplate);
-    mPrinter->Print("\n");
+
+    mPrinter->Print({{"type", mName},
+                     {"field_numbers", fieldNumbers},
+                     {"presence_words", common::producePresenceWords(mDescriptor, common::hasExplicitPresence)},
+                     {"field_count", std::to_string(mDescriptor->field_count())}}, Templates::PresenceInfoDefinitionTemplate);
 }
 
 void MessageDefinitionPrinter::printConstructors() {
+    bool isGadget = GeneratorOptions::instance().isGadget();
+    bool isSharedData = GeneratorOptions::instance().isSharedData();
     for (int i = 0; i <= mDescriptor->field_count(); i++) {
         mPrinter->Print(mTypeMap, Templates::ProtoConstructorDefinitionBeginTemplate);
         printConstructor(i);
-        mPrinter->Print(mTypeMap, Templates::ProtoConstructorDefinitionEndTemplate);
-        printInitializationList(i);
-        mPrinter->Print(Templates::ConstructorContentTemplate);
+        mPrinter->Print(mTypeMap, isGadget ? Templates::GadgetConstructorDefinitionEndTemplate
+                                           : Templates::ProtoConstructorDefinitionEndTemplate);
+        if (isSharedData) {
+            printSharedDataConstructorContent(i);
+        } else {
+            bool isFirst = isGadget;
+            printInitializationList(i, isFirst);
+            printPresenceInitializer(i, isFirst);
+            printConstructorContent(i);
+        }
     }
 
     if (mDescriptor->full_name() == std::string("google.protobuf.Timestamp")) {
-        mPrinter->Print("Timestamp::Timestamp(const QDateTime &datetime, QObject *parent) : QObject(parent)\n"
-                        ", m_seconds(datetime.toMSecsSinceEpoch() / 1000)\n"
-                        ", m_nanos((datetime.toMSecsSinceEpoch() % 1000) * 1000)\n"
-                        "{}\n"
+        if (isGadget) {
+            mPrinter->Print("Timestamp::Timestamp(const QDateTime &datetime)\n: ");
+        } else {
+            mPrinter->Print("Timestamp::Timestamp(const QDateTime &datetime, QObject *parent) : QObject(parent)\n, ");
+        }
+        bool isFirst = false;
+        if (isSharedData) {
+            mPrinter->Print("d_ptr(new QtProtobufData)");
+            printPresenceInitializer(mDescriptor->field_count(), isFirst);
+            mPrinter->Print("\n{\n"
+                            "    d_ptr->m_seconds = datetime.toMSecsSinceEpoch() / 1000;\n"
+                            "    d_ptr->m_nanos = (datetime.toMSecsSinceEpoch() % 1000) * 1000;\n"
+                            "}\n");
+        } else {
+            mPrinter->Print("m_seconds(datetime.toMSecsSinceEpoch() / 1000)\n"
+                            ", m_nanos((datetime.toMSecsSinceEpoch() % 1000) * 1000)");
+            printPresenceInitializer(mDescriptor->field_count(), isFirst);
+            mPrinter->Print("\n{}\n");
+        }
+        mPrinter->Print({{"member", isSharedData ? "d_ptr->m_" : "m_"}},
                         "Timestamp::operator QDateTime() const\n"
                         "{\n"
-                        "    return QDateTime::fromMSecsSinceEpoch(m_seconds * 1000 + m_nanos / 1000);\n"
+                        "    return QDateTime::fromMSecsSinceEpoch($member$seconds * 1000 + $member$nanos / 1000);\n"
                         "}\n");
     }
 }
 
+void MessageDefinitionPrinter::printSharedDataConstructorContent(int fieldCount)
+{
+    bool isFirst = GeneratorOptions::instance().isGadget();
+    printInitializer(mTypeMap, Templates::SharedDataInitializerTemplate, isFirst);
+    printPresenceInitializer(fieldCount, isFirst);
+    mPrinter->Print("\n{\n");
+    Indent();
+    for (int i = 0; i < fieldCount; i++) {
+        const FieldDescriptor *field = mDescriptor->field(i);
+        const char *assignmentTemplate = Templates::SharedPropertyAssignmentTemplate;
+        if (common::realOneof(field) != nullptr) {
+            assignmentTemplate = Templates::OneofConstructorSetterTemplate;
+        } else if (common::isPureMessage(field)) {
+            assignmentTemplate = Templates::SharedMessagePropertyAssignmentTemplate;
+        }
+        mPrinter->Print(produceParameterMap(field), assignmentTemplate);
+    }
+    Outdent();
+    mPrinter->Print(Templates::SimpleBlockEnclosureTemplate);
+}
+
+void MessageDefinitionPrinter::printConstructorContent(int fieldCount)
+{
+    //Oneof fields passed to constructor are set one by one, so the last one becomes active
+    mPrinter->Print("\n{\n");
+    Indent();
+    for (int i = 0; i < fieldCount; i++) {
+        const FieldDescriptor *field = mDescriptor->field(i);
+        if (common::realOneof(field) != nullptr) {
+            mPrinter->Print(produceParameterMap(field), Templates::OneofConstructorSetterTemplate);
+        }
+    }
+    Outdent();
+    mPrinter->Print(Templates::SimpleBlockEnclosureTemplate);
+}
+
+void MessageDefinitionPrinter::printSharedData()
+{
+    mPrinter->Print({{"classname", mName}}, Templates::SharedDataConstructorDefinitionTemplate);
+    bool isFirst = true;
+    printInitializationList(0, isFirst);
+    mPrinter->Print(Templates::ConstructorContentTemplate);
+
+    mPrinter->Print({{"classname", mName}}, Templates::SharedDataCopyConstructorDefinitionTemplate);
+    isFirst = false;
+    common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, const PropertyMap &propertyMap) {
+        if (common::realOneof(field) != nullptr) {
+            if (common::isFirstOneofField(field)) {
+                printInitializer(propertyMap, Templates::OneofCopyFieldInitializerTemplate, isFirst);
+            }
+            return;
+        }
+        printInitializer(propertyMap, common::isPureMessage(field) ? Templates::CopyMessageFieldInitializerTemplate
+                                                                   : Templates::CopyFieldInitializerTemplate, isFirst);
+    });
+    mPrinter->Print(Templates::ConstructorContentTemplate);
+
+    mPrinter->Print({{"classname", mName}}, Templates::SharedDataDestructorDefinitionTemplate);
+}
+
 void MessageDefinitionPrinter::printConstructor(int fieldCount)
 {
+    bool isGadget = GeneratorOptions::instance().isGadget();
     for (int i = 0; i < fieldCount; i++) {
+        if (i != 0 && isGadget) {
+            mPrinter->Print(", ");
+        }
         const FieldDescriptor *field = mDescriptor->field(i);
+        //Parameters are taken by value, so temporaries are moved to fields without copying
         const char *parameterTemplate = Templates::ConstructorParameterTemplate;
-        FieldDescriptor::Type fieldType = field->type();
         if (field->is_repeated() && !field->is_map()) {
             parameterTemplate = Templates::ConstructorRepeatedParameterTemplate;
-        } else if (fieldType == FieldDescriptor::TYPE_BYTES
-                  || fieldType == FieldDescriptor::TYPE_STRING
-                  || fieldType == FieldDescriptor::TYPE_MESSAGE
-                  || field->is_map()) {
-            parameterTemplate = Templates::ConstructorMessageParameterTemplate;
         }
         mPrinter->Print(common::producePropertyMap(field, mDescriptor), parameterTemplate);
+        if (!isGadget) {
+            mPrinter->Print(",");
+        }
+    }
+}
+
+PropertyMap MessageDefinitionPrinter::produceParameterMap(const FieldDescriptor *field)
+{
+    //Constructor parameter is owned by constructor, so its value is moved to field
+    auto propertyMap = common::producePropertyMap(field, mDescriptor);
+    return common::isMovableType(field) ? common::produceRvaluePropertyMap(propertyMap) : propertyMap;
+}
+
+void MessageDefinitionPrinter::printInitializer(const PropertyMap &propertyMap, const char *initializerTemplate, bool &isFirst)
+{
+    //isFirst is set when there is no base class initializer, so the first member opens the list
+    if (isFirst) {
+        mPrinter->Print(Templates::FirstInitializerSeparatorTemplate);
+    } else {
+        mPrinter->Print(Templates::InitializerSeparatorTemplate);
     }
+    isFirst = false;
+    mPrinter->Print(propertyMap, initializerTemplate);
 }
 
-void MessageDefinitionPrinter::printInitializationList(int fieldCount)
+void MessageDefinitionPrinter::printInitializationList(int fieldCount, bool &isFirst)
 {
     for (int i = 0; i < mDescriptor->field_count(); i++) {
         const FieldDescriptor *field = mDescriptor->field(i);
-        auto propertyMap = common::producePropertyMap(field, mDescriptor);
+        if (common::realOneof(field) != nullptr) {
+            continue; //Oneof storage is empty by default, oneof fields are set in constructor body
+        }
+        auto propertyMap = produceParameterMap(field);
         propertyMap["initializer"] = "";
         if (!field->is_repeated() && !field->is_map()) {
             switch (field->type()) {
@@ -179,26 +337,52 @@ void MessageDefinitionPrinter::printInitializationList(int fieldCount)
         }
 
         if (common::isPureMessage(field)) {
+            //Message fields are allocated on first mutable access
             if (i < fieldCount) {
-                mPrinter->Print(propertyMap, Templates::MessagePropertyInitializerTemplate);
-            } else {
-                mPrinter->Print(propertyMap, Templates::MessagePropertyDefaultInitializerTemplate);
+                printInitializer(propertyMap, Templates::MessagePropertyInitializerTemplate, isFirst);
             }
         } else {
             if (i < fieldCount) {
-                mPrinter->Print(propertyMap, Templates::PropertyInitializerTemplate);
+                printInitializer(propertyMap, Templates::PropertyInitializerTemplate, isFirst);
             } else {
                 if (!propertyMap["initializer"].empty()) {
-                    mPrinter->Print(propertyMap, Templates::PropertyDefaultInitializerTemplate);
+                    printInitializer(propertyMap, Templates::PropertyDefaultInitializerTemplate, isFirst);
                 }
             }
         }
     }
 }
 
+void MessageDefinitionPrinter::printPresenceInitializer(int fieldCount, bool &isFirst)
+{
+    //Fields passed to constructor are marked as set, singular Qt type fields are always visited by serializer.
+    //Presence of oneof fields and of message fields, that are not passed to constructor, is set by their setters
+    auto isSet = [fieldCount](const FieldDescriptor *field) {
+        return (field->index() < fieldCount && common::realOneof(field) == nullptr) || common::isAlwaysPresent(field);
+    };
+
+    bool hasSetFields = false;
+    for (int i = 0; i < mDescriptor->field_count(); i++) {
+        hasSetFields |= isSet(mDescriptor->field(i));
+    }
+    if (hasSetFields) {
+        printInitializer({{"presence_words", common::producePresenceWords(mDescriptor, isSet)}},
+                         Templates::PresenceInitializerTemplate, isFirst);
+    }
+}
+
 void MessageDefinitionPrinter::printCopyFunctionality()
 {
     assert(mDescriptor != nullptr);
+    if (GeneratorOptions::instance().isSharedData()) {
+        printSharedDataCopyFunctionality();
+        return;
+    }
+
+    if (GeneratorOptions::instance().isGadget()) {
+        printGadgetCopyFunctionality();
+        return;
+    }
 
     const char *constructorTemplate = Templates::CopyConstructorDefinitionTemplate;
     const char *assignmentOperatorTemplate = Templates::AssignmentOperatorDefinitionTemplate;
@@ -209,33 +393,96 @@ void MessageDefinitionPrinter::printCopyFunctionality()
 
     mPrinter->Print({{"classname", mName}},
                     constructorTemplate);
+    mPrinter->Print("\n{\n");
+
+    //Only fields, that are set in other message, are copied
+    Indent();
     common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, const PropertyMap &propertyMap) {
-        if (common::isPureMessage(field)) {
-            mPrinter->Print(propertyMap, Templates::MessagePropertyDefaultInitializerTemplate);
+        if (common::realOneof(field) != nullptr) {
+            if (common::isFirstOneofField(field)) {
+                mPrinter->Print(propertyMap, Templates::OneofCopyFieldTemplate);
+            }
+        } else if (common::isPureMessage(field)) {
+            mPrinter->Print(propertyMap, Templates::CopyComplexFieldTemplate);
+        } else {
+            mPrinter->Print(propertyMap, Templates::CopyPresentFieldTemplate);
         }
     });
-    mPrinter->Print("\n{\n");
+    if (mDescriptor->field_count() > 0) {
+        mPrinter->Print(Templates::CopyPresenceTemplate);
+    }
+    Outdent();
+    mPrinter->Print(Templates::SimpleBlockEnclosureTemplate);
 
+    //Fields, that hold default value in both messages, are skipped
+    mPrinter->Print({{"classname", mName}}, assignmentOperatorTemplate);
     Indent();
     common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, const PropertyMap &propertyMap) {
-        if (common::isPureMessage(field)) {
+        if (common::realOneof(field) != nullptr) {
+            if (common::isFirstOneofField(field)) {
+                mPrinter->Print(propertyMap, Templates::OneofAssignFieldTemplate);
+                Indent();
+                printOneofSignals(common::realOneof(field), Templates::OneofFieldChangedTemplate);
+                Outdent();
+                mPrinter->Print(Templates::SimpleBlockEnclosureTemplate);
+            }
+        } else if (common::isPureMessage(field)) {
             mPrinter->Print(propertyMap, Templates::CopyComplexFieldTemplate);
         } else {
-            mPrinter->Print(propertyMap, Templates::CopyFieldTemplate);
+            mPrinter->Print(propertyMap, Templates::AssignPresentFieldTemplate);
         }
     });
+    if (mDescriptor->field_count() > 0) {
+        mPrinter->Print(Templates::CopyPresenceTemplate);
+    }
+    mPrinter->Print(Templates::AssignmentOperatorReturnTemplate);
     Outdent();
     mPrinter->Print(Templates::SimpleBlockEnclosureTemplate);
+}
+
+void MessageDefinitionPrinter::printGadgetCopyFunctionality()
+{
+    const char *constructorTemplate = Templates::GadgetCopyConstructorDefinitionTemplate;
+    const char *assignmentOperatorTemplate = Templates::AssignmentOperatorDefinitionTemplate;
+    if (mDescriptor->field_count() <= 0) {
+        constructorTemplate = Templates::GadgetEmptyCopyConstructorDefinitionTemplate;
+        assignmentOperatorTemplate = Templates::EmptyAssignmentOperatorDefinitionTemplate;
+    }
+
+    mPrinter->Print({{"classname", mName}}, constructorTemplate);
+    bool isFirst = true;
+    common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, const PropertyMap &propertyMap) {
+        if (common::realOneof(field) != nullptr) {
+            if (common::isFirstOneofField(field)) {
+                printInitializer(propertyMap, Templates::OneofCopyFieldInitializerTemplate, isFirst);
+            }
+            return;
+        }
+        printInitializer(propertyMap, common::isPureMessage(field) ? Templates::CopyMessageFieldInitializerTemplate
+                                                                   : Templates::CopyFieldInitializerTemplate, isFirst);
+    });
+    if (mDescriptor->field_count() > 0) {
+        printInitializer(mTypeMap, Templates::CopyPresenceInitializerTemplate, isFirst);
+    }
+    mPrinter->Print("\n{\n");
+    mPrinter->Print(Templates::SimpleBlockEnclosureTemplate);
 
     mPrinter->Print({{"classname", mName}}, assignmentOperatorTemplate);
     Indent();
     common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, const PropertyMap &propertyMap) {
-        if (common::isPureMessage(field)) {
-            mPrinter->Print(propertyMap, Templates::CopyComplexFieldTemplate);
+        if (common::realOneof(field) != nullptr) {
+            if (common::isFirstOneofField(field)) {
+                mPrinter->Print(propertyMap, Templates::OneofCopyFieldTemplate);
+            }
+        } else if (common::isPureMessage(field)) {
+            mPrinter->Print(propertyMap, Templates::CopyMessageFieldTemplate);
         } else {
-            mPrinter->Print(propertyMap, Templates::CopyFieldTemplate);
+            mPrinter->Print(propertyMap, Templates::AssignPresentFieldTemplate);
         }
     });
+    if (mDescriptor->field_count() > 0) {
+        mPrinter->Print(Templates::CopyPresenceTemplate);
+    }
     mPrinter->Print(Templates::AssignmentOperatorReturnTemplate);
     Outdent();
     mPrinter->Print(Templates::SimpleBlockEnclosureTemplate);
@@ -244,72 +491,151 @@ void MessageDefinitionPrinter::printCopyFunctionality()
 void MessageDefinitionPrinter::printMoveSemantic()
 {
     assert(mDescriptor != nullptr);
+    if (GeneratorOptions::instance().isSharedData()) {
+        printSharedDataMoveSemantic();
+        return;
+    }
 
-    const char *constructorTemplate = Templates::MoveConstructorDefinitionTemplate;
+    bool isGadget = GeneratorOptions::instance().isGadget();
+    const char *constructorTemplate = isGadget ? Templates::GadgetMoveConstructorDefinitionTemplate
+                                               : Templates::MoveConstructorDefinitionTemplate;
     const char *assignmentOperatorTemplate = Templates::MoveAssignmentOperatorDefinitionTemplate;
     if (mDescriptor->field_count() <= 0) {
-        constructorTemplate = Templates::EmptyMoveConstructorDefinitionTemplate;
+        constructorTemplate = isGadget ? Templates::GadgetEmptyMoveConstructorDefinitionTemplate
+                                       : Templates::EmptyMoveConstructorDefinitionTemplate;
         assignmentOperatorTemplate = Templates::EmptyMoveAssignmentOperatorDefinitionTemplate;
     }
 
-    mPrinter->Print({{"classname", mName}},
-                    constructorTemplate);
+    //Fields are moved member-wise without change signals.
+    //Submessages are moved by pointer, moved-from message reads them as unset
+    mPrinter->Print({{"classname", mName}}, constructorTemplate);
+    bool isFirst = isGadget;
     common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, const PropertyMap &propertyMap) {
-        if (common::isPureMessage(field)) {
-            mPrinter->Print(propertyMap, Templates::MessagePropertyDefaultInitializerTemplate);
+        if (common::realOneof(field) != nullptr) {
+            if (common::isFirstOneofField(field)) {
+                printInitializer(propertyMap, Templates::OneofMoveFieldInitializerTemplate, isFirst);
+            }
+            return;
         }
+        printInitializer(propertyMap, common::isPureMessage(field) ? Templates::MoveMessageFieldInitializerTemplate
+                                                                   : Templates::MoveFieldInitializerTemplate, isFirst);
     });
+    if (mDescriptor->field_count() > 0) {
+        printInitializer(mTypeMap, Templates::CopyPresenceInitializerTemplate, isFirst);
+    }
     mPrinter->Print("\n{\n");
+    Indent();
+    printOneofMovedPresence();
+    Outdent();
+    mPrinter->Print(Templates::SimpleBlockEnclosureTemplate);
 
+    mPrinter->Print({{"classname", mName}}, assignmentOperatorTemplate);
     Indent();
     common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, const PropertyMap &propertyMap) {
-        if (field->type() == FieldDescriptor::TYPE_MESSAGE
-                || field->type() == FieldDescriptor::TYPE_STRING
-                || field->type() == FieldDescriptor::TYPE_BYTES
-                || field->is_repeated()) {
-            if (common::isPureMessage(field)) {
-                mPrinter->Print(propertyMap, Templates::MoveMessageFieldTemplate);
-            } else {
-                mPrinter->Print(propertyMap, Templates::MoveComplexFieldConstructorTemplate);
+        if (common::realOneof(field) != nullptr) {
+            if (common::isFirstOneofField(field)) {
+                mPrinter->Print(propertyMap, Templates::OneofMoveFieldTemplate);
             }
+        } else if (common::isPureMessage(field)) {
+            mPrinter->Print(propertyMap, Templates::MoveMessageFieldTemplate);
         } else {
-            if (field->type() != FieldDescriptor::TYPE_ENUM) {
-                mPrinter->Print(propertyMap, Templates::MoveFieldTemplate);
-            }
-            else {
-                mPrinter->Print(propertyMap, Templates::EnumMoveFieldTemplate);
-            }
+            mPrinter->Print(propertyMap, Templates::MoveFieldTemplate);
         }
     });
+    if (mDescriptor->field_count() > 0) {
+        mPrinter->Print(Templates::CopyPresenceTemplate);
+        printOneofMovedPresence();
+    }
+    mPrinter->Print(Templates::AssignmentOperatorReturnTemplate);
     Outdent();
     mPrinter->Print(Templates::SimpleBlockEnclosureTemplate);
+}
 
-    mPrinter->Print({{"classname", mName}}, assignmentOperatorTemplate);
+void MessageDefinitionPrinter::printOneofSignals(const OneofDescriptor *oneof, const char *signalTemplate)
+{
+    //Change of oneof storage is reported for all its fields, since active field could be changed
+    for (int i = 0; i < oneof->field_count(); i++) {
+        mPrinter->Print(common::producePropertyMap(oneof->field(i), mDescriptor), signalTemplate);
+    }
+}
+
+void MessageDefinitionPrinter::printOneofMovedPresence()
+{
+    //Moved-from oneofs are empty, so their fields are not visited by serializer anymore
+    common::iterateOneofs(mDescriptor, [&](const OneofDescriptor *, const PropertyMap &oneofMap) {
+        mPrinter->Print(oneofMap, Templates::OneofMovedPresenceTemplate);
+    });
+}
+
+void MessageDefinitionPrinter::printSharedDataCopyFunctionality()
+{
+    bool isGadget = GeneratorOptions::instance().isGadget();
+    //Copies only share data, it's detached on first modification
+    mPrinter->Print({{"classname", mName}}, isGadget ? Templates::GadgetCopyConstructorDefinitionTemplate
+                                                     : Templates::CopyConstructorDefinitionTemplate);
+    bool isFirst = isGadget;
+    printInitializer(mTypeMap, Templates::SharedDataCopyInitializerTemplate, isFirst);
+    if (mDescriptor->field_count() > 0) {
+        printInitializer(mTypeMap, Templates::CopyPresenceInitializerTemplate, isFirst);
+    }
+    mPrinter->Print(Templates::ConstructorContentTemplate);
+
+    if (mDescriptor->field_count() <= 0) {
+        mPrinter->Print({{"classname", mName}}, Templates::SharedDataAssignmentOperatorDefinitionTemplate);
+        return;
+    }
+
+    if (isGadget) {
+        mPrinter->Print({{"classname", mName}}, Templates::SharedGadgetAssignmentOperatorDefinitionTemplate);
+        return;
+    }
+
+    //Property change signals are emitted only for fields that differ from the previously shared data
+    mPrinter->Print({{"classname", mName}}, Templates::SharedAssignmentOperatorDefinitionTemplate);
     Indent();
     common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, const PropertyMap &propertyMap) {
-        if (field->type() == FieldDescriptor::TYPE_MESSAGE
-                || field->type() == FieldDescriptor::TYPE_STRING
-                || field->type() == FieldDescriptor::TYPE_BYTES
-                || field->is_repeated()) {
-            if (common::isPureMessage(field)) {
-                mPrinter->Print(propertyMap, Templates::MoveMessageFieldTemplate);
-            } else {
-                mPrinter->Print(propertyMap, Templates::MoveComplexFieldTemplate);
-            }
-        } else {
-            if (field->type() != FieldDescriptor::TYPE_ENUM) {
-                mPrinter->Print(propertyMap, Templates::MoveFieldTemplate);
-            }
-            else {
-                mPrinter->Print(propertyMap, Templates::EnumMoveFieldTemplate);
+        if (common::realOneof(field) != nullptr) {
+            if (common::isFirstOneofField(field)) {
+                mPrinter->Print(propertyMap, Templates::SharedOneofFieldChangedTemplate);
+                Indent();
+                printOneofSignals(common::realOneof(field), Templates::OneofFieldChangedTemplate);
+                Outdent();
+                mPrinter->Print(Templates::SimpleBlockEnclosureTemplate);
             }
+            return;
         }
+        mPrinter->Print(propertyMap, common::isPureMessage(field) ? Templates::SharedMessageFieldChangedTemplate
+                                                                  : Templates::SharedFieldChangedTemplate);
     });
     mPrinter->Print(Templates::AssignmentOperatorReturnTemplate);
     Outdent();
     mPrinter->Print(Templates::SimpleBlockEnclosureTemplate);
 }
 
+void MessageDefinitionPrinter::printSharedDataMoveSemantic()
+{
+    bool isGadget = GeneratorOptions::instance().isGadget();
+    //Moved-from message keeps referencing the shared data and stays valid
+    mPrinter->Print({{"classname", mName}}, isGadget ? Templates::GadgetMoveConstructorDefinitionTemplate
+                                                     : Templates::MoveConstructorDefinitionTemplate);
+    bool isFirst = isGadget;
+    printInitializer(mTypeMap, Templates::SharedDataCopyInitializerTemplate, isFirst);
+    if (mDescriptor->field_count() > 0) {
+        printInitializer(mTypeMap, Templates::CopyPresenceInitializerTemplate, isFirst);
+    }
+    mPrinter->Print(Templates::ConstructorContentTemplate);
+
+    //Moved data is assigned without change signals, like in move constructor
+    mPrinter->Print({{"classname", mName}}, Templates::SharedMoveAssignmentOperatorDefinitionTemplate);
+    Indent();
+    if (mDescriptor->field_count() > 0) {
+        mPrinter->Print(Templates::CopyPresenceTemplate);
+    }
+    mPrinter->Print(Templates::AssignmentOperatorReturnTemplate);
+    Outdent();
+    mPrinter->Print(Templates::SimpleBlockEnclosureTemplate);
+}
+
 void MessageDefinitionPrinter::printComparisonOperators()
 {
     assert(mDescriptor != nullptr);
@@ -319,10 +645,15 @@ void MessageDefinitionPrinter::printComparisonOperators()
         return;
     }
 
-    mPrinter->Print({{"classname", mName}}, Templates::EqualOperatorDefinitionTemplate);
+    bool isSharedData = GeneratorOptions::instance().isSharedData();
+    mPrinter->Print({{"classname", mName}}, isSharedData ? Templates::SharedEqualOperatorDefinitionTemplate
+                                                         : Templates::EqualOperatorDefinitionTemplate);
 
     bool isFirst = true;
     common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, PropertyMap &propertyMap) {
+        if (common::realOneof(field) != nullptr && !common::isFirstOneofField(field)) {
+            return; //Oneof storage is compared once
+        }
         if (!isFirst) {
             mPrinter->Print("\n&& ");
         } else {
@@ -330,10 +661,15 @@ void MessageDefinitionPrinter::printComparisonOperators()
             Indent();
             isFirst = false;
         }
-        if (common::isPureMessage(field)) {
-            mPrinter->Print(propertyMap, Templates::EqualOperatorMessagePropertyTemplate);
+        if (common::realOneof(field) != nullptr) {
+            mPrinter->Print(propertyMap, isSharedData ? Templates::SharedOneofEqualOperatorPropertyTemplate
+                                                      : Templates::OneofEqualOperatorPropertyTemplate);
+        } else if (common::isPureMessage(field)) {
+            mPrinter->Print(propertyMap, isSharedData ? Templates::SharedEqualOperatorMessagePropertyTemplate
+                                                      : Templates::EqualOperatorMessagePropertyTemplate);
         } else {
-            mPrinter->Print(propertyMap, Templates::EqualOperatorPropertyTemplate);
+            mPrinter->Print(propertyMap, isSharedData ? Templates::SharedEqualOperatorPropertyTemplate
+                                                      : Templates::EqualOperatorPropertyTemplate);
         }
     });
 
@@ -351,32 +687,56 @@ void MessageDefinitionPrinter::printComparisonOperators()
 
 void MessageDefinitionPrinter::printGetters()
 {
+    bool isGadget = GeneratorOptions::instance().isGadget();
+    bool isSharedData = GeneratorOptions::instance().isSharedData();
     common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, PropertyMap &propertyMap) {
+        if (common::realOneof(field) != nullptr) {
+            printOneofAccessors(field, propertyMap);
+            return;
+        }
         if (common::isPureMessage(field)) {
-            mPrinter->Print(propertyMap, Templates::GetterPrivateMessageDefinitionTemplate);
-            mPrinter->Print(propertyMap, Templates::GetterMessageDefinitionTemplate);
+            if (!isGadget) {
+                mPrinter->Print(propertyMap, isSharedData ? Templates::SharedGetterPrivateMessageDefinitionTemplate
+                                                          : Templates::GetterPrivateMessageDefinitionTemplate);
+            }
+            mPrinter->Print(propertyMap, isSharedData ? Templates::SharedGetterMessageDefinitionTemplate
+                                                      : Templates::GetterMessageDefinitionTemplate);
+            mPrinter->Print(propertyMap, isSharedData ? Templates::SharedClearMessageFieldDefinitionTemplate
+                                                      : Templates::ClearMessageFieldDefinitionTemplate);
         }
         if (field->is_repeated()) {
             if (field->type() == FieldDescriptor::TYPE_MESSAGE && !field->is_map() && !common::isQtType(field)
-                    && GeneratorOptions::instance().hasQml()) {
-                mPrinter->Print(propertyMap, Templates::GetterQmlListDefinitionTemplate);
+                    && GeneratorOptions::instance().hasQml() && !isGadget) {
+                mPrinter->Print(propertyMap, isSharedData ? Templates::SharedGetterQmlListDefinitionTemplate
+                                                          : Templates::GetterQmlListDefinitionTemplate);
             }
         }
     });
 
     common::iterateMessageFields(mDescriptor, [&](const FieldDescriptor *field, PropertyMap &propertyMap) {
+        if (common::realOneof(field) != nullptr) {
+            return;
+        }
         switch (field->type()) {
         case FieldDescriptor::TYPE_MESSAGE:
             if (!field->is_map() && !field->is_repeated() && !common::isQtType(field)) {
-                mPrinter->Print(propertyMap, Templates::SetterPrivateTemplateDefinitionMessageType);
-                mPrinter->Print(propertyMap, Templates::SetterTemplateDefinitionMessageType);
+                if (isGadget) {
+                    printSetterDefinition(field, propertyMap, isSharedData ? Templates::SharedGadgetSetterTemplateDefinitionMessageType
+                                                                           : Templates::GadgetSetterTemplateDefinitionMessageType);
+                } else if (isSharedData) {
+                    mPrinter->Print(propertyMap, Templates::SharedSetterPrivateTemplateDefinitionMessageType);
+                    printSetterDefinition(field, propertyMap, Templates::SharedSetterTemplateDefinitionMessageType);
+                } else {
+                    mPrinter->Print(propertyMap, Templates::SetterPrivateTemplateDefinitionMessageType);
+                    printSetterDefinition(field, propertyMap, Templates::SetterTemplateDefinitionMessageType);
+                }
             } else {
-                mPrinter->Print(propertyMap, Templates::SetterTemplateDefinitionComplexType);
+                printComplexSetterDefinition(field, propertyMap);
             }
             break;
         case FieldDescriptor::FieldDescriptor::TYPE_STRING:
         case FieldDescriptor::FieldDescriptor::TYPE_BYTES:
-            mPrinter->Print(propertyMap, Templates::SetterTemplateDefinitionComplexType);
+            printComplexSetterDefinition(field, propertyMap);
             break;
         default:
             break;
@@ -384,9 +744,45 @@ void MessageDefinitionPrinter::printGetters()
     });
 }
 
+void MessageDefinitionPrinter::printOneofAccessors(const FieldDescriptor *field, const PropertyMap &propertyMap)
+{
+    bool isGadget = GeneratorOptions::instance().isGadget();
+    if (common::isPureMessage(field)) {
+        if (!isGadget) {
+            mPrinter->Print(propertyMap, Templates::OneofGetterPrivateMessageDefinitionTemplate);
+            mPrinter->Print(propertyMap, Templates::OneofSetterPrivateMessageDefinitionTemplate);
+        }
+        mPrinter->Print(propertyMap, Templates::OneofGetterMessageDefinitionTemplate);
+    } else {
+        mPrinter->Print(propertyMap, Templates::OneofGetterDefinitionTemplate);
+    }
+    printSetterDefinition(field, propertyMap, isGadget ? Templates::GadgetOneofSetterDefinitionTemplate
+                                                       : Templates::OneofSetterDefinitionTemplate);
+}
+
+void MessageDefinitionPrinter::printComplexSetterDefinition(const FieldDescriptor *field, const PropertyMap &propertyMap)
+{
+    if (GeneratorOptions::instance().isGadget()) {
+        printSetterDefinition(field, propertyMap, GeneratorOptions::instance().isSharedData() ? Templates::SharedGadgetSetterTemplateDefinitionComplexType
+                                                                                              : Templates::GadgetSetterTemplateDefinitionComplexType);
+    } else {
+        printSetterDefinition(field, propertyMap, GeneratorOptions::instance().isSharedData() ? Templates::SharedSetterTemplateDefinitionComplexType
+                                                                                              : Templates::SetterTemplateDefinitionComplexType);
+    }
+}
+
+void MessageDefinitionPrinter::printSetterDefinition(const FieldDescriptor *field, const PropertyMap &propertyMap, const char *setterTemplate)
+{
+    mPrinter->Print(propertyMap, setterTemplate);
+    if (common::isMovableType(field)) {
+        mPrinter->Print(common::produceRvaluePropertyMap(propertyMap), setterTemplate);
+    }
+}
+
 void MessageDefinitionPrinter::printDestructor()
 {
-    mPrinter->Print({{"classname", mName}}, Templates::RegistrarTemplate);
+    mPrinter->Print({{"classname", mName}}, GeneratorOptions::instance().isCompact() ? Templates::CompactRegistrarTemplate
+                                                                                    : Templates::RegistrarTemplate);
     mPrinter->Print({{"classname", mName}}, "$classname$::~$classname$()\n"
                                                  "{}\n\n");
 }
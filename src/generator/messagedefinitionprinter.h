@@ -48,11 +48,26 @@ private:
     void printFieldsOrdering();
     void printConstructors();
     void printConstructor(int fieldCount);
-    void printInitializationList(int fieldCount);
+    void printInitializationList(int fieldCount, bool &isFirst);
+    void printPresenceInitializer(int fieldCount, bool &isFirst);
+    void printPresenceInfo();
+    void printConstructorContent(int fieldCount);
+    void printSharedDataConstructorContent(int fieldCount);
+    void printSharedData();
+    void printInitializer(const PropertyMap &propertyMap, const char *initializerTemplate, bool &isFirst);
+    PropertyMap produceParameterMap(const ::google::protobuf::FieldDescriptor *field);
     void printCopyFunctionality();
+    void printGadgetCopyFunctionality();
     void printMoveSemantic();
+    void printOneofSignals(const ::google::protobuf::OneofDescriptor *oneof, const char *signalTemplate);
+    void printOneofMovedPresence();
+    void printSharedDataCopyFunctionality();
+    void printSharedDataMoveSemantic();
     void printComparisonOperators();
     void printGetters();
+    void printOneofAccessors(const ::google::protobuf::FieldDescriptor *field, const PropertyMap &propertyMap);
+    void printComplexSetterDefinition(const ::google::protobuf::FieldDescriptor *field, const PropertyMap &propertyMap);
+    void printSetterDefinition(const ::google::protobuf::FieldDescriptor *field, const PropertyMap &propertyMap, const char *setterTemplate);
     void printDestructor();
 
     void printClassDefinitionPrivate();
@@ -62,6 +62,10 @@ bool MultiFileGenerator::Generate(const FileDescriptor *file,
         return false;
     }
 
+    if (!GeneratorOptions::instance().checkCompatibility(error)) {
+        return false;
+    }
+
     common::iterateMessages(file, [&] (const ::google::protobuf::Descriptor *message) {
         std::string baseFilename(message->name());
         utils::tolower(baseFilename);
@@ -82,6 +86,9 @@ bool MultiFileGenerator::Generate(const FileDescriptor *file,
         if (GeneratorOptions::instance().hasQml()) {
             headerPrinter->Print(Templates::QmlProtobufIncludesTemplate);
         }
+        if (GeneratorOptions::instance().isSharedData()) {
+            headerPrinter->Print(Templates::SharedDataIncludesTemplate);
+        }
 
         std::set<std::string> existingIncludes;
         for (int i = 0; i < message->field_count(); i++) {
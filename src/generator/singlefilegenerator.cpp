@@ -61,6 +61,10 @@ bool SingleFileGenerator::Generate(const FileDescriptor *file,
         return false;
     }
 
+    if (!GeneratorOptions::instance().checkCompatibility(error)) {
+        return false;
+    }
+
     return GenerateMessages(file, parameter, generatorContext, error)
             && GenerateServices(file, parameter, generatorContext, error);
 }
@@ -90,6 +94,9 @@ bool SingleFileGenerator::GenerateMessages(const ::google::protobuf::FileDescrip
     if (GeneratorOptions::instance().hasQml()) {
         headerPrinter->Print(Templates::QmlProtobufIncludesTemplate);
     }
+    if (GeneratorOptions::instance().isSharedData()) {
+        headerPrinter->Print(Templates::SharedDataIncludesTemplate);
+    }
 
     printDisclaimer(sourcePrinter);
     sourcePrinter->Print({{"include", basename + Templates::ProtoFileSuffix}}, Templates::InternalIncludeTemplate);
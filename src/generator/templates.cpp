@@ -61,12 +61,20 @@ const char *Templates::ManualRegistrationComplexTypeDefinition = "void $type$::r
                                                                  "    qRegisterMetaType<$type$*>(\"$full_type$*\");\n" //Somehow for aliastypes qRegisterMetaType logic doesn't work for pointer type registration
                                                                  "    qRegisterMetaType<$list_type$>(\"$full_list_type$\");\n"
                                                                  "";
+const char *Templates::GadgetManualRegistrationComplexTypeDefinition = "void $type$::registerTypes()\n{\n"
+                                                                       "    qRegisterMetaType<$type$>(\"$full_type$\");\n"
+                                                                       "    qRegisterMetaType<$list_type$>(\"$full_list_type$\");\n"
+                                                                       "";
 const char *Templates::ManualRegistrationGlobalEnumDefinition = "void $enum_gadget$::registerTypes()\n{\n"
                                                                  "";
 const char *Templates::ComplexGlobalEnumFieldRegistrationTemplate = "qRegisterMetaType<$type$>(\"$full_type$\");\n";
 const char *Templates::ComplexListTypeUsingTemplate = "using $classname$Repeated = QList<QSharedPointer<$classname$>>;\n";
+const char *Templates::ContiguousListTypeUsingTemplate = "using $classname$Repeated = QVector<$classname$>;\n";
+const char *Templates::GadgetListTypeUsingTemplate = "using $classname$Repeated = QList<$classname$>;\n";
 const char *Templates::MapTypeUsingTemplate = "using $type$ = QMap<$key_type$, $value_type$>;\n";
 const char *Templates::MessageMapTypeUsingTemplate = "using $type$ = QMap<$key_type$, QSharedPointer<$value_type$>>;\n";
+const char *Templates::HashMapTypeUsingTemplate = "using $type$ = QHash<$key_type$, $value_type$>;\n";
+const char *Templates::MessageHashMapTypeUsingTemplate = "using $type$ = QHash<$key_type$, QSharedPointer<$value_type$>>;\n";
 const char *Templates::NestedMessageUsingTemplate = "using $type$ = $scope_namespaces$_QtProtobufNested::$type$;\n"
                                                     "using $list_type$ = $scope_namespaces$_QtProtobufNested::$list_type$;\n";
 
@@ -83,23 +91,35 @@ const char *Templates::ProtoClassDeclarationBeginTemplate = "\nclass $classname$
                                                       "    Q_OBJECT\n"
                                                       "    Q_PROTOBUF_OBJECT\n"
                                                       "    Q_DECLARE_PROTOBUF_SERIALIZERS($classname$)\n";
+const char *Templates::GadgetClassDeclarationBeginTemplate = "\nclass $classname$\n"
+                                                             "{\n"
+                                                             "    Q_GADGET\n"
+                                                             "    Q_PROTOBUF_OBJECT\n"
+                                                             "    Q_DECLARE_PROTOBUF_SERIALIZERS($classname$)\n";
 
 const char *Templates::PropertyTemplate = "Q_PROPERTY($property_type$ $property_name$ READ $property_name$ WRITE set$property_name_cap$ NOTIFY $property_name$Changed SCRIPTABLE $scriptable$)\n";
 const char *Templates::RepeatedPropertyTemplate = "Q_PROPERTY($property_list_type$ $property_name$ READ $property_name$ WRITE set$property_name_cap$ NOTIFY $property_name$Changed SCRIPTABLE $scriptable$)\n";
 const char *Templates::NonScriptablePropertyTemplate = "Q_PROPERTY($property_type$ $property_name$_p READ $property_name$ WRITE set$property_name_cap$ NOTIFY $property_name$Changed SCRIPTABLE false)\n";
 const char *Templates::NonScriptableAliasPropertyTemplate = "Q_PROPERTY($qml_alias_type$ $property_name$ READ $property_name$_p WRITE set$property_name_cap$_p NOTIFY $property_name$Changed SCRIPTABLE true)\n";
 const char *Templates::MessagePropertyTemplate = "Q_PROPERTY($property_type$ *$property_name$ READ $property_name$_p WRITE set$property_name_cap$_p NOTIFY $property_name$Changed)\n";
+const char *Templates::GadgetPropertyTemplate = "Q_PROPERTY($property_type$ $property_name$ READ $property_name$ WRITE set$property_name_cap$ SCRIPTABLE $scriptable$)\n";
+const char *Templates::GadgetRepeatedPropertyTemplate = "Q_PROPERTY($property_list_type$ $property_name$ READ $property_name$ WRITE set$property_name_cap$ SCRIPTABLE $scriptable$)\n";
+const char *Templates::GadgetNonScriptablePropertyTemplate = "Q_PROPERTY($property_type$ $property_name$_p READ $property_name$ WRITE set$property_name_cap$ SCRIPTABLE false)\n";
+const char *Templates::GadgetNonScriptableAliasPropertyTemplate = "Q_PROPERTY($qml_alias_type$ $property_name$ READ $property_name$_p WRITE set$property_name_cap$_p SCRIPTABLE true)\n";
 const char *Templates::QmlListPropertyTemplate = "Q_PROPERTY(QQmlListProperty<$property_type$> $property_name$Data READ $property_name$_l NOTIFY $property_name$Changed)\n";
 
-const char *Templates::ConstructorParameterTemplate = "$scope_type$ $property_name$,";
-const char *Templates::ConstructorMessageParameterTemplate = "const $scope_type$ &$property_name$,";
-const char *Templates::ConstructorRepeatedParameterTemplate = "const $scope_list_type$ &$property_name$,";
+const char *Templates::ConstructorParameterTemplate = "$scope_type$ $property_name$";
+const char *Templates::ConstructorRepeatedParameterTemplate = "$scope_list_type$ $property_name$";
 const char *Templates::ProtoConstructorBeginTemplate = "$classname$(";
 const char *Templates::ProtoConstructorEndTemplate = "QObject *parent = nullptr);\n";
+const char *Templates::GadgetConstructorEndTemplate = ");\n";
 
 const char *Templates::MemberTemplate = "$scope_type$ m_$property_name$;\n";
 const char *Templates::ListMemberTemplate = "$scope_list_type$ m_$property_name$;\n";
-const char *Templates::ComplexMemberTemplate = "std::unique_ptr<$scope_type$> m_$property_name$;\n";
+const char *Templates::ComplexMemberTemplate = "QtProtobuf::QProtobufLazyMessagePointer<$scope_type$> m_$property_name$;\n";
+const char *Templates::PresenceMemberTemplate = "$mutable$QtProtobuf::QProtobufFieldPresence<$field_count$> m_qtProtobufPresence;\n";
+const char *Templates::PresenceInfoDeclarationTemplate = "static const QtProtobuf::QProtobufFieldPresenceInfo qtProtobufPresenceInfo;\n";
+const char *Templates::OneofMemberTemplate = "QtProtobuf::QProtobufOneof m_$oneof_name$;\n";
 const char *Templates::PublicBlockTemplate = "\npublic:\n";
 const char *Templates::PrivateBlockTemplate = "\nprivate:\n";
 const char *Templates::EnumDefinitionTemplate = "enum $type$ {\n";
@@ -108,6 +128,7 @@ const char *Templates::EnumFieldTemplate = "$enumvalue$ = $value$,\n";
 
 const char *Templates::ProtoConstructorDefinitionBeginTemplate = "$type$::$type$(";
 const char *Templates::ProtoConstructorDefinitionEndTemplate = "QObject *parent) : QObject(parent)";
+const char *Templates::GadgetConstructorDefinitionEndTemplate = ")";
 
 const char *Templates::ConstructorTemplate = "$classname$();\n";
 const char *Templates::QObjectConstructorTemplate = "explicit $classname$(QObject *parent = nullptr);\n";
@@ -118,26 +139,37 @@ const char *Templates::CopyConstructorDefinitionTemplate = "$classname$::$classn
 const char *Templates::MoveConstructorDefinitionTemplate = "$classname$::$classname$($classname$ &&other) : QObject()";
 const char *Templates::EmptyCopyConstructorDefinitionTemplate = "$classname$::$classname$(const $classname$ &) : QObject()";
 const char *Templates::EmptyMoveConstructorDefinitionTemplate = "$classname$::$classname$($classname$ &&) : QObject()";
+const char *Templates::GadgetCopyConstructorDefinitionTemplate = "$classname$::$classname$(const $classname$ &other)";
+const char *Templates::GadgetMoveConstructorDefinitionTemplate = "$classname$::$classname$($classname$ &&other)";
+const char *Templates::GadgetEmptyCopyConstructorDefinitionTemplate = "$classname$::$classname$(const $classname$ &)";
+const char *Templates::GadgetEmptyMoveConstructorDefinitionTemplate = "$classname$::$classname$($classname$ &&)";
 const char *Templates::DeletedCopyConstructorTemplate = "$classname$(const $classname$ &) = delete;\n";
 const char *Templates::DeletedMoveConstructorTemplate = "$classname$($classname$ &&) = delete;\n";
 const char *Templates::CopyFieldTemplate = "set$property_name_cap$(other.m_$property_name$);\n";
-const char *Templates::CopyComplexFieldTemplate = "set$property_name_cap$(*other.m_$property_name$);\n";
-const char *Templates::MoveMessageFieldTemplate = "*m_$property_name$ = std::move(*other.m_$property_name$);\n";
-const char *Templates::MoveComplexFieldTemplate = "if (m_$property_name$ != other.m_$property_name$) {\n"
-                                                  "    m_$property_name$ = std::move(other.m_$property_name$);\n"
-                                                  "    $property_name$Changed();\n"
-                                                  "    other.$property_name$Changed();\n"
-                                                  "} else {\n"
-                                                  "    m_$property_name$ = std::move(other.m_$property_name$);\n"
-                                                  "    other.$property_name$Changed();\n"
+const char *Templates::CopyComplexFieldTemplate = "set$property_name_cap$(other.m_$property_name$.value());\n";
+const char *Templates::CopyMessageFieldTemplate = "m_$property_name$ = other.m_$property_name$;\n";
+const char *Templates::CopyPresentFieldTemplate = "if (other.m_qtProtobufPresence.test($field_index$)) {\n"
+                                                  "    set$property_name_cap$(other.m_$property_name$);\n"
                                                   "}\n";
-
-const char *Templates::MoveComplexFieldConstructorTemplate = "m_$property_name$ = std::move(other.m_$property_name$);\n"
-                                                             "other.$property_name$Changed();\n";
-
-const char *Templates::MoveFieldTemplate = "set$property_name_cap$(std::exchange(other.m_$property_name$, 0));\n"
-                                           "other.$property_name$Changed();\n";
-const char *Templates::EnumMoveFieldTemplate = "m_$property_name$ = other.m_$property_name$;\n";
+const char *Templates::AssignPresentFieldTemplate = "if (m_qtProtobufPresence.test($field_index$) || other.m_qtProtobufPresence.test($field_index$)) {\n"
+                                                    "    set$property_name_cap$(other.m_$property_name$);\n"
+                                                    "}\n";
+const char *Templates::CopyPresenceTemplate = "m_qtProtobufPresence = other.m_qtProtobufPresence;\n";
+const char *Templates::OneofCopyFieldTemplate = "m_$oneof_name$ = other.m_$oneof_name$;\n";
+const char *Templates::OneofAssignFieldTemplate = "if (m_$oneof_name$ != other.m_$oneof_name$) {\n"
+                                                  "    m_$oneof_name$ = other.m_$oneof_name$;\n";
+const char *Templates::OneofMoveFieldTemplate = "m_$oneof_name$ = std::move(other.m_$oneof_name$);\n";
+const char *Templates::OneofMovedPresenceTemplate = "other.m_qtProtobufPresence.clearOneof($oneof_first_index$, $oneof_field_count$);\n";
+const char *Templates::OneofFieldChangedTemplate = "$property_name$Changed();\n";
+const char *Templates::MoveMessageFieldTemplate = "m_$property_name$ = std::move(other.m_$property_name$);\n";
+const char *Templates::MoveFieldTemplate = "m_$property_name$ = std::move(other.m_$property_name$);\n";
+const char *Templates::CopyFieldInitializerTemplate = "m_$property_name$(other.m_$property_name$)";
+const char *Templates::CopyMessageFieldInitializerTemplate = "m_$property_name$(other.m_$property_name$)";
+const char *Templates::MoveFieldInitializerTemplate = "m_$property_name$(std::move(other.m_$property_name$))";
+const char *Templates::MoveMessageFieldInitializerTemplate = "m_$property_name$(std::move(other.m_$property_name$))";
+const char *Templates::CopyPresenceInitializerTemplate = "m_qtProtobufPresence(other.m_qtProtobufPresence)";
+const char *Templates::OneofCopyFieldInitializerTemplate = "m_$oneof_name$(other.m_$oneof_name$)";
+const char *Templates::OneofMoveFieldInitializerTemplate = "m_$oneof_name$(std::move(other.m_$oneof_name$))";
 
 const char *Templates::AssignmentOperatorDeclarationTemplate = "$classname$ &operator =(const $classname$ &other);\n";
 const char *Templates::AssignmentOperatorDefinitionTemplate = "$classname$ &$classname$::operator =(const $classname$ &other)\n{\n";
@@ -155,7 +187,8 @@ const char *Templates::EmptyEqualOperatorDefinitionTemplate = "bool $classname$:
                                                               "    return true;\n"
                                                               "}\n\n";
 const char *Templates::EqualOperatorPropertyTemplate = "m_$property_name$ == other.m_$property_name$";
-const char *Templates::EqualOperatorMessagePropertyTemplate = "*m_$property_name$ == *other.m_$property_name$";
+const char *Templates::EqualOperatorMessagePropertyTemplate = "m_$property_name$.value() == other.m_$property_name$.value()";
+const char *Templates::OneofEqualOperatorPropertyTemplate = "m_$oneof_name$ == other.m_$oneof_name$";
 
 const char *Templates::NotEqualOperatorDeclarationTemplate = "bool operator !=(const $classname$ &other) const;\n";
 const char *Templates::NotEqualOperatorDefinitionTemplate = "bool $classname$::operator !=(const $classname$ &other) const\n{\n"
@@ -164,13 +197,62 @@ const char *Templates::NotEqualOperatorDefinitionTemplate = "bool $classname$::o
 
 const char *Templates::GetterPrivateMessageDeclarationTemplate = "$getter_type$ *$property_name$_p() const;\n";
 const char *Templates::GetterPrivateMessageDefinitionTemplate = "$getter_type$ *$classname$::$property_name$_p() const\n{\n"
-                                        "    return m_$property_name$.get();\n"
+                                        "    //Field is writable through pointer, so it's allocated and marked as set\n"
+                                        "    m_qtProtobufPresence.set($field_index$);\n"
+                                        "    return m_$property_name$.data();\n"
                                         "}\n\n";
 
 const char *Templates::GetterMessageDeclarationTemplate = "const $getter_type$ &$property_name$() const;\n";
 const char *Templates::GetterMessageDefinitionTemplate = "const $getter_type$ &$classname$::$property_name$() const\n{\n"
-                                        "    return *m_$property_name$;\n"
+                                        "    return m_$property_name$.value();\n"
                                         "}\n\n";
+const char *Templates::HasFieldTemplate = "bool has$property_name_cap$() const {\n"
+                                          "    return m_qtProtobufPresence.test($field_index$);\n"
+                                          "}\n\n";
+const char *Templates::ClearFieldTemplate = "void clear$property_name_cap$() {\n"
+                                            "    set$property_name_cap$({});\n"
+                                            "    m_qtProtobufPresence.clear($field_index$);\n"
+                                            "}\n\n";
+const char *Templates::ClearQtTypeFieldTemplate = "void clear$property_name_cap$() {\n"
+                                                  "    set$property_name_cap$({});\n"
+                                                  "}\n\n";
+const char *Templates::ClearMessageFieldDeclarationTemplate = "void clear$property_name_cap$();\n";
+const char *Templates::ClearMessageFieldDefinitionTemplate = "void $classname$::clear$property_name_cap$()\n{\n"
+                                                             "    m_qtProtobufPresence.clear($field_index$);\n"
+                                                             "    m_$property_name$.reset();\n"
+                                                             "}\n\n";
+const char *Templates::OneofCaseEnumTemplate = "enum class $oneof_name_cap$Case {\n";
+const char *Templates::OneofCaseGetterTemplate = "$oneof_name_cap$Case $oneof_name$Case() const {\n"
+                                                 "    return static_cast<$oneof_name_cap$Case>($oneof_const_storage$.fieldNumber());\n"
+                                                 "}\n\n";
+const char *Templates::OneofClearTemplate = "void clear$oneof_name_cap$() {\n"
+                                            "    m_qtProtobufPresence.clearOneof($oneof_first_index$, $oneof_field_count$);\n"
+                                            "    if ($oneof_const_storage$.fieldNumber() != 0) {\n"
+                                            "        $oneof_storage$.clear();\n"
+                                            "    }\n"
+                                            "}\n\n";
+const char *Templates::OneofHasFieldTemplate = "bool has$property_name_cap$() const {\n"
+                                               "    return $oneof_const_storage$.holds($field_number$);\n"
+                                               "}\n\n";
+const char *Templates::OneofClearFieldTemplate = "void clear$property_name_cap$() {\n"
+                                                 "    if ($oneof_const_storage$.holds($field_number$)) {\n"
+                                                 "        clear$oneof_name_cap$();\n"
+                                                 "    }\n"
+                                                 "}\n\n";
+const char *Templates::OneofGetterDeclarationTemplate = "$getter_type$ $property_name$() const;\n";
+const char *Templates::OneofGetterDefinitionTemplate = "$getter_type$ $classname$::$property_name$() const\n{\n"
+                                                       "    return $oneof_const_storage$.value<$scope_type$>($field_number$);\n"
+                                                       "}\n\n";
+const char *Templates::OneofGetterMessageDefinitionTemplate = "const $getter_type$ &$classname$::$property_name$() const\n{\n"
+                                                              "    return $oneof_const_storage$.value<$scope_type$>($field_number$);\n"
+                                                              "}\n\n";
+const char *Templates::OneofGetterPrivateMessageDefinitionTemplate = "$getter_type$ *$classname$::$property_name$_p() const\n{\n"
+                                                                     "    //Meta-object system requires pointer to mutable message, field value isn't modified by read\n"
+                                                                     "    return const_cast<$scope_type$ *>($oneof_const_storage$.constData<$scope_type$>($field_number$));\n"
+                                                                     "}\n\n";
+const char *Templates::OneofNonScriptableGetterTemplate = "$qml_alias_type$ $property_name$_p() const {\n"
+                                                          "    return $property_name$();\n"
+                                                          "}\n\n";
 
 const char *Templates::GetterTemplate = "$getter_type$ $property_name$() const {\n"
                                         "    return m_$property_name$;\n"
@@ -181,73 +263,288 @@ const char *Templates::NonScriptableGetterTemplate = "$qml_alias_type$ $property
                                         "}\n\n";
 
 const char *Templates::GetterContainerExtraTemplate = "$getter_type$ &$property_name$() {\n"
+                                        "    m_qtProtobufPresence.set($field_index$);\n"
                                         "    return m_$property_name$;\n"
                                         "}\n\n";
 
 const char *Templates::GetterQmlListDeclarationTemplate = "QQmlListProperty<$scope_type$> $property_name$_l();\n";
 const char *Templates::GetterQmlListDefinitionTemplate = "QQmlListProperty<$full_type$> $classname$::$property_name$_l()\n{\n"
+                                               "    m_qtProtobufPresence.set($field_index$);\n"
                                                "    return QtProtobuf::constructQmlListProperty<$scope_type$>(this, &m_$property_name$);\n"
                                                "}\n\n";
 
 const char *Templates::SetterPrivateTemplateDeclarationMessageType = "void set$property_name_cap$_p($setter_type$ *$property_name$);\n";
 const char *Templates::SetterPrivateTemplateDefinitionMessageType = "void $classname$::set$property_name_cap$_p($setter_type$ *$property_name$)\n{\n"
                                                    "    if ($property_name$ == nullptr) {\n"
-                                                   "        *m_$property_name$ = {};\n"
+                                                   "        clear$property_name_cap$();\n"
                                                    "        return;\n"
                                                    "    }\n"
-                                                   "    if (*m_$property_name$ != *$property_name$) {\n"
-                                                   "        *m_$property_name$ = *$property_name$;\n"
-                                                   "        $property_name$Changed();\n"
+                                                   "    m_qtProtobufPresence.set($field_index$);\n"
+                                                   "    if (m_$property_name$.value() == *$property_name$) {\n"
+                                                   "        delete $property_name$;\n"
+                                                   "        return;\n"
+                                                   "    }\n"
+                                                   "    if (m_$property_name$.isSet()) {\n"
+                                                   "        *m_$property_name$.data() = *$property_name$;\n"
+                                                   "        delete $property_name$;\n"
+                                                   "    } else {\n"
+                                                   "        //NOTE: take ownership of value\n"
+                                                   "        m_$property_name$.reset($property_name$);\n"
                                                    "    }\n"
-                                                   "    //NOTE: take ownership of value\n"
-                                                   "    delete $property_name$;\n"
+                                                   "    $property_name$Changed();\n"
                                                    "}\n\n";
 
-const char *Templates::SetterTemplateDeclarationMessageType = "void set$property_name_cap$(const $setter_type$ &$property_name$);\n";
-const char *Templates::SetterTemplateDefinitionMessageType = "void $classname$::set$property_name_cap$(const $setter_type$ &$property_name$)\n{\n"
-                                                   "    if (*m_$property_name$ != $property_name$) {\n"
-                                                   "        *m_$property_name$ = $property_name$;\n"
+const char *Templates::SetterTemplateDeclarationMessageType = "void set$property_name_cap$($setter_parameter$);\n";
+const char *Templates::SetterTemplateDefinitionMessageType = "void $classname$::set$property_name_cap$($setter_parameter$)\n{\n"
+                                                   "    m_qtProtobufPresence.set($field_index$);\n"
+                                                   "    if (m_$property_name$.value() != $property_name$) {\n"
+                                                   "        *m_$property_name$.data() = $setter_value$;\n"
                                                    "        $property_name$Changed();\n"
                                                    "    }\n"
                                                    "}\n\n";
 
-const char *Templates::SetterTemplateDeclarationComplexType = "void set$property_name_cap$(const $setter_type$ &$property_name$);\n";
-const char *Templates::SetterTemplateDefinitionComplexType = "void $classname$::set$property_name_cap$(const $setter_type$ &$property_name$)\n{\n"
+const char *Templates::SetterTemplateDeclarationComplexType = "void set$property_name_cap$($setter_parameter$);\n";
+const char *Templates::SetterTemplateDefinitionComplexType = "void $classname$::set$property_name_cap$($setter_parameter$)\n{\n"
+                                                   "    m_qtProtobufPresence.$presence_update$;\n"
                                                    "    if (m_$property_name$ != $property_name$) {\n"
-                                                   "        m_$property_name$ = $property_name$;\n"
+                                                   "        m_$property_name$ = $setter_value$;\n"
                                                    "        $property_name$Changed();\n"
                                                    "    }\n"
                                                    "}\n\n";
 
-const char *Templates::SetterTemplate = "void set$property_name_cap$(const $setter_type$ &$property_name$) {\n"
+const char *Templates::SetterTemplate = "void set$property_name_cap$($setter_parameter$) {\n"
+                                                   "    m_qtProtobufPresence.$presence_update$;\n"
                                                    "    if (m_$property_name$ != $property_name$) {\n"
-                                                   "        m_$property_name$ = $property_name$;\n"
+                                                   "        m_$property_name$ = $setter_value$;\n"
                                                    "        $property_name$Changed();\n"
                                                    "    }\n"
                                                    "}\n\n";
 const char *Templates::NonScriptableSetterTemplate = "void set$property_name_cap$_p(const $qml_alias_type$ &$property_name$) {\n"
+                                                   "    m_qtProtobufPresence.$presence_update$;\n"
                                                    "    if (m_$property_name$ != $property_name$) {\n"
                                                    "        m_$property_name$ = $property_name$;\n"
                                                    "        $property_name$Changed();\n"
                                                    "    }\n"
                                                    "}\n\n";
+const char *Templates::OneofNonScriptableSetterTemplate = "void set$property_name_cap$_p(const $qml_alias_type$ &$property_name$) {\n"
+                                                          "    set$property_name_cap$($property_name$);\n"
+                                                          "}\n\n";
+const char *Templates::OneofSetterDefinitionTemplate = "void $classname$::set$property_name_cap$($setter_parameter$)\n{\n"
+                                                       "    m_qtProtobufPresence.setOneof($field_index$, $oneof_first_index$, $oneof_field_count$);\n"
+                                                       "    if (!$oneof_const_storage$.isEqual<$scope_type$>($field_number$, $property_name$)) {\n"
+                                                       "        $oneof_storage$.setValue<$scope_type$>($field_number$, $setter_value$);\n"
+                                                       "        $property_name$Changed();\n"
+                                                       "    }\n"
+                                                       "}\n\n";
+const char *Templates::OneofSetterPrivateMessageDefinitionTemplate = "void $classname$::set$property_name_cap$_p($setter_type$ *$property_name$)\n{\n"
+                                                                     "    if ($property_name$ == nullptr) {\n"
+                                                                     "        clear$property_name_cap$();\n"
+                                                                     "        return;\n"
+                                                                     "    }\n"
+                                                                     "    //Pointer to field value, that is returned by $property_name$_p(), is owned by oneof\n"
+                                                                     "    if ($property_name$ == $property_name$_p()) {\n"
+                                                                     "        return;\n"
+                                                                     "    }\n"
+                                                                     "    set$property_name_cap$(*$property_name$);\n"
+                                                                     "    delete $property_name$;\n"
+                                                                     "}\n\n";
+const char *Templates::OneofConstructorSetterTemplate = "set$property_name_cap$($setter_value$);\n";
+
+const char *Templates::GadgetSetterTemplateDefinitionMessageType = "void $classname$::set$property_name_cap$($setter_parameter$)\n{\n"
+                                                         "    m_qtProtobufPresence.set($field_index$);\n"
+                                                         "    *m_$property_name$.data() = $setter_value$;\n"
+                                                         "}\n\n";
+const char *Templates::GadgetSetterTemplateDefinitionComplexType = "void $classname$::set$property_name_cap$($setter_parameter$)\n{\n"
+                                                         "    m_qtProtobufPresence.$presence_update$;\n"
+                                                         "    m_$property_name$ = $setter_value$;\n"
+                                                         "}\n\n";
+const char *Templates::GadgetSetterTemplate = "void set$property_name_cap$($setter_parameter$) {\n"
+                                              "    m_qtProtobufPresence.$presence_update$;\n"
+                                              "    m_$property_name$ = $setter_value$;\n"
+                                              "}\n\n";
+const char *Templates::GadgetNonScriptableSetterTemplate = "void set$property_name_cap$_p(const $qml_alias_type$ &$property_name$) {\n"
+                                                           "    m_qtProtobufPresence.$presence_update$;\n"
+                                                           "    m_$property_name$ = $property_name$;\n"
+                                                           "}\n\n";
+const char *Templates::GadgetOneofSetterDefinitionTemplate = "void $classname$::set$property_name_cap$($setter_parameter$)\n{\n"
+                                                             "    m_qtProtobufPresence.setOneof($field_index$, $oneof_first_index$, $oneof_field_count$);\n"
+                                                             "    if (!$oneof_const_storage$.isEqual<$scope_type$>($field_number$, $property_name$)) {\n"
+                                                             "        $oneof_storage$.setValue<$scope_type$>($field_number$, $setter_value$);\n"
+                                                             "    }\n"
+                                                             "}\n\n";
+
+const char *Templates::SharedDataIncludesTemplate = "#include <QSharedData>\n"
+                                                    "#include <QSharedDataPointer>\n\n";
+const char *Templates::SharedDataClassDeclarationTemplate = "class QtProtobufData : public QSharedData\n"
+                                                            "{\n"
+                                                            "public:\n"
+                                                            "    QtProtobufData();\n"
+                                                            "    QtProtobufData(const QtProtobufData &other);\n"
+                                                            "    ~QtProtobufData();\n\n";
+const char *Templates::SharedDataMemberTemplate = "QSharedDataPointer<QtProtobufData> d_ptr;\n";
+const char *Templates::SharedDataConstructorDefinitionTemplate = "$classname$::QtProtobufData::QtProtobufData()";
+const char *Templates::SharedDataCopyConstructorDefinitionTemplate = "$classname$::QtProtobufData::QtProtobufData(const QtProtobufData &other)\n"
+                                                                     "    : QSharedData(other)";
+const char *Templates::SharedDataDestructorDefinitionTemplate = "$classname$::QtProtobufData::~QtProtobufData()\n"
+                                                                "{}\n\n";
+const char *Templates::SharedDataInitializerTemplate = "d_ptr(new QtProtobufData)";
+const char *Templates::SharedDataCopyInitializerTemplate = "d_ptr(other.d_ptr)";
+const char *Templates::SharedPropertyAssignmentTemplate = "d_ptr->m_$property_name$ = $setter_value$;\n";
+const char *Templates::SharedMessagePropertyAssignmentTemplate = "*d_ptr->m_$property_name$.data() = $setter_value$;\n";
+const char *Templates::SharedDataAssignmentOperatorDefinitionTemplate = "$classname$ &$classname$::operator =(const $classname$ &other)\n{\n"
+                                                                        "    d_ptr = other.d_ptr;\n"
+                                                                        "    return *this;\n"
+                                                                        "}\n";
+const char *Templates::SharedGadgetAssignmentOperatorDefinitionTemplate = "$classname$ &$classname$::operator =(const $classname$ &other)\n{\n"
+                                                                          "    d_ptr = other.d_ptr;\n"
+                                                                          "    m_qtProtobufPresence = other.m_qtProtobufPresence;\n"
+                                                                          "    return *this;\n"
+                                                                          "}\n";
+const char *Templates::SharedAssignmentOperatorDefinitionTemplate = "$classname$ &$classname$::operator =(const $classname$ &other)\n{\n"
+                                                                    "    m_qtProtobufPresence = other.m_qtProtobufPresence;\n"
+                                                                    "    if (d_ptr == other.d_ptr) {\n"
+                                                                    "        return *this;\n"
+                                                                    "    }\n\n"
+                                                                    "    QSharedDataPointer<QtProtobufData> previous(d_ptr);\n"
+                                                                    "    d_ptr = other.d_ptr;\n";
+const char *Templates::SharedFieldChangedTemplate = "if (previous.constData()->m_$property_name$ != d_ptr.constData()->m_$property_name$) {\n"
+                                                    "    $property_name$Changed();\n"
+                                                    "}\n";
+const char *Templates::SharedMessageFieldChangedTemplate = "if (previous.constData()->m_$property_name$.value() != d_ptr.constData()->m_$property_name$.value()) {\n"
+                                                           "    $property_name$Changed();\n"
+                                                           "}\n";
+const char *Templates::SharedOneofFieldChangedTemplate = "if (previous.constData()->m_$oneof_name$ != d_ptr.constData()->m_$oneof_name$) {\n";
+const char *Templates::SharedMoveAssignmentOperatorDefinitionTemplate = "$classname$ &$classname$::operator =($classname$ &&other)\n{\n"
+                                                                        "    d_ptr = other.d_ptr;\n";
+const char *Templates::SharedEqualOperatorDefinitionTemplate = "bool $classname$::operator ==(const $classname$ &other) const\n{\n"
+                                                               "    if (d_ptr == other.d_ptr) {\n"
+                                                               "        return true;\n"
+                                                               "    }\n"
+                                                               "    return ";
+const char *Templates::SharedEqualOperatorPropertyTemplate = "d_ptr->m_$property_name$ == other.d_ptr->m_$property_name$";
+const char *Templates::SharedEqualOperatorMessagePropertyTemplate = "d_ptr->m_$property_name$.value() == other.d_ptr->m_$property_name$.value()";
+const char *Templates::SharedOneofEqualOperatorPropertyTemplate = "d_ptr->m_$oneof_name$ == other.d_ptr->m_$oneof_name$";
+
+const char *Templates::SharedGetterTemplate = "$getter_type$ $property_name$() const {\n"
+                                              "    return d_ptr->m_$property_name$;\n"
+                                              "}\n\n";
+const char *Templates::SharedNonScriptableGetterTemplate = "$qml_alias_type$ $property_name$_p() const {\n"
+                                                           "    return d_ptr->m_$property_name$;\n"
+                                                           "}\n\n";
+const char *Templates::SharedGetterContainerExtraTemplate = "$getter_type$ &$property_name$() {\n"
+                                                            "    m_qtProtobufPresence.set($field_index$);\n"
+                                                            "    return d_ptr->m_$property_name$;\n"
+                                                            "}\n\n";
+const char *Templates::SharedGetterPrivateMessageDefinitionTemplate = "$getter_type$ *$classname$::$property_name$_p() const\n{\n"
+                                                                      "    //Field is writable through pointer, so it's allocated and marked as set\n"
+                                                                      "    m_qtProtobufPresence.set($field_index$);\n"
+                                                                      "    return d_ptr.constData()->m_$property_name$.data();\n"
+                                                                      "}\n\n";
+const char *Templates::SharedGetterMessageDefinitionTemplate = "const $getter_type$ &$classname$::$property_name$() const\n{\n"
+                                                               "    return d_ptr->m_$property_name$.value();\n"
+                                                               "}\n\n";
+const char *Templates::SharedClearMessageFieldDefinitionTemplate = "void $classname$::clear$property_name_cap$()\n{\n"
+                                                                   "    m_qtProtobufPresence.clear($field_index$);\n"
+                                                                   "    d_ptr->m_$property_name$.reset();\n"
+                                                                   "}\n\n";
+const char *Templates::SharedGetterQmlListDefinitionTemplate = "QQmlListProperty<$full_type$> $classname$::$property_name$_l()\n{\n"
+                                                               "    m_qtProtobufPresence.set($field_index$);\n"
+                                                               "    return QtProtobuf::constructQmlListProperty<$scope_type$>(this, &d_ptr->m_$property_name$);\n"
+                                                               "}\n\n";
+
+const char *Templates::SharedSetterTemplate = "void set$property_name_cap$($setter_parameter$) {\n"
+                                              "    m_qtProtobufPresence.$presence_update$;\n"
+                                              "    if (d_ptr.constData()->m_$property_name$ != $property_name$) {\n"
+                                              "        d_ptr->m_$property_name$ = $setter_value$;\n"
+                                              "        $property_name$Changed();\n"
+                                              "    }\n"
+                                              "}\n\n";
+const char *Templates::SharedNonScriptableSetterTemplate = "void set$property_name_cap$_p(const $qml_alias_type$ &$property_name$) {\n"
+                                                           "    m_qtProtobufPresence.$presence_update$;\n"
+                                                           "    if (d_ptr.constData()->m_$property_name$ != $property_name$) {\n"
+                                                           "        d_ptr->m_$property_name$ = $property_name$;\n"
+                                                           "        $property_name$Changed();\n"
+                                                           "    }\n"
+                                                           "}\n\n";
+const char *Templates::SharedSetterPrivateTemplateDefinitionMessageType = "void $classname$::set$property_name_cap$_p($setter_type$ *$property_name$)\n{\n"
+                                                                          "    if ($property_name$ == nullptr) {\n"
+                                                                          "        clear$property_name_cap$();\n"
+                                                                          "        return;\n"
+                                                                          "    }\n"
+                                                                          "    m_qtProtobufPresence.set($field_index$);\n"
+                                                                          "    if (d_ptr.constData()->m_$property_name$.value() != *$property_name$) {\n"
+                                                                          "        //NOTE: take ownership of value\n"
+                                                                          "        d_ptr->m_$property_name$.reset($property_name$);\n"
+                                                                          "        $property_name$Changed();\n"
+                                                                          "    } else {\n"
+                                                                          "        delete $property_name$;\n"
+                                                                          "    }\n"
+                                                                          "}\n\n";
+const char *Templates::SharedSetterTemplateDefinitionMessageType = "void $classname$::set$property_name_cap$($setter_parameter$)\n{\n"
+                                                                   "    m_qtProtobufPresence.set($field_index$);\n"
+                                                                   "    if (d_ptr.constData()->m_$property_name$.value() != $property_name$) {\n"
+                                                                   "        *d_ptr->m_$property_name$.data() = $setter_value$;\n"
+                                                                   "        $property_name$Changed();\n"
+                                                                   "    }\n"
+                                                                   "}\n\n";
+const char *Templates::SharedSetterTemplateDefinitionComplexType = "void $classname$::set$property_name_cap$($setter_parameter$)\n{\n"
+                                                                   "    m_qtProtobufPresence.$presence_update$;\n"
+                                                                   "    if (d_ptr.constData()->m_$property_name$ != $property_name$) {\n"
+                                                                   "        d_ptr->m_$property_name$ = $setter_value$;\n"
+                                                                   "        $property_name$Changed();\n"
+                                                                   "    }\n"
+                                                                   "}\n\n";
+const char *Templates::SharedGadgetSetterTemplate = "void set$property_name_cap$($setter_parameter$) {\n"
+                                                    "    m_qtProtobufPresence.$presence_update$;\n"
+                                                    "    d_ptr->m_$property_name$ = $setter_value$;\n"
+                                                    "}\n\n";
+const char *Templates::SharedGadgetNonScriptableSetterTemplate = "void set$property_name_cap$_p(const $qml_alias_type$ &$property_name$) {\n"
+                                                                 "    m_qtProtobufPresence.$presence_update$;\n"
+                                                                 "    d_ptr->m_$property_name$ = $property_name$;\n"
+                                                                 "}\n\n";
+const char *Templates::SharedGadgetSetterTemplateDefinitionMessageType = "void $classname$::set$property_name_cap$($setter_parameter$)\n{\n"
+                                                                         "    m_qtProtobufPresence.set($field_index$);\n"
+                                                                         "    *d_ptr->m_$property_name$.data() = $setter_value$;\n"
+                                                                         "}\n\n";
+const char *Templates::SharedGadgetSetterTemplateDefinitionComplexType = "void $classname$::set$property_name_cap$($setter_parameter$)\n{\n"
+                                                                         "    m_qtProtobufPresence.$presence_update$;\n"
+                                                                         "    d_ptr->m_$property_name$ = $setter_value$;\n"
+                                                                         "}\n\n";
 
 const char *Templates::SignalsBlockTemplate = "\nsignals:\n";
 const char *Templates::SignalTemplate = "void $property_name$Changed();\n";
 
-const char *Templates::FieldsOrderingContainerTemplate = "const QtProtobuf::QProtobufMetaObject $type$::protobufMetaObject = QtProtobuf::QProtobufMetaObject($type$::staticMetaObject, $type$::propertyOrdering);\n"
-                                                         "const QtProtobuf::QProtobufPropertyOrdering $type$::propertyOrdering = {";
+const char *Templates::FieldsOrderingArrayTemplate = "namespace {\n"
+                                                     "const QtProtobuf::QProtobufPropertyOrdering::value_type $type$FieldsOrdering[] = {";
+const char *Templates::FieldsOrderingArrayEndTemplate = "};\n"
+                                                        "}\n";
+const char *Templates::FieldsOrderingContainerTemplate = "const QtProtobuf::QProtobufPropertyOrdering $type$::propertyOrdering;\n"
+                                                         "const QtProtobuf::QProtobufMetaObject $type$::protobufMetaObject($type$::staticMetaObject, $type$::propertyOrdering, $is_gadget$);\n";
+const char *Templates::FieldsOrderingContainerPresenceTemplate = "const QtProtobuf::QProtobufPropertyOrdering $type$::propertyOrdering($type$FieldsOrdering);\n"
+                                                                 "const QtProtobuf::QProtobufMetaObject $type$::protobufMetaObject($type$::staticMetaObject, $type$::propertyOrdering, $is_gadget$, &$type$::qtProtobufPresenceInfo);\n";
 const char *Templates::FieldOrderTemplate = "{$field_number$, $property_number$}";
+const char *Templates::PresenceInfoDefinitionTemplate = "namespace {\n"
+                                                        "const int $type$PresenceFieldNumbers[] = {$field_numbers$};\n"
+                                                        "const quint32 $type$ExplicitPresence[] = {$presence_words$};\n"
+                                                        "}\n"
+                                                        "const QtProtobuf::QProtobufFieldPresenceInfo $type$::qtProtobufPresenceInfo = {\n"
+                                                        "    [](const void *object) { return static_cast<const $type$ *>(object)->m_qtProtobufPresence.data(); },\n"
+                                                        "    $type$PresenceFieldNumbers,\n"
+                                                        "    $type$ExplicitPresence,\n"
+                                                        "    $field_count$\n"
+                                                        "};\n\n";
 
 const char *Templates::EnumTemplate = "$type$";
 
 const char *Templates::SimpleBlockEnclosureTemplate = "}\n";
 const char *Templates::SemicolonBlockEnclosureTemplate = "};\n";
 const char *Templates::EmptyBlockTemplate = "{}\n\n";
-const char *Templates::PropertyInitializerTemplate = "\n    , m_$property_name$($property_name$)";
-const char *Templates::PropertyDefaultInitializerTemplate = "\n    , m_$property_name$($initializer$)";
-const char *Templates::MessagePropertyInitializerTemplate = "\n    , m_$property_name$(new $scope_type$($property_name$))";
-const char *Templates::MessagePropertyDefaultInitializerTemplate = "\n    , m_$property_name$(new $scope_type$)";
+const char *Templates::InitializerSeparatorTemplate = "\n    , ";
+const char *Templates::FirstInitializerSeparatorTemplate = "\n    : ";
+const char *Templates::PropertyInitializerTemplate = "m_$property_name$($setter_value$)";
+const char *Templates::PropertyDefaultInitializerTemplate = "m_$property_name$($initializer$)";
+const char *Templates::MessagePropertyInitializerTemplate = "m_$property_name$(new $scope_type$($setter_value$))";
+const char *Templates::PresenceInitializerTemplate = "m_qtProtobufPresence({$presence_words$})";
 const char *Templates::ConstructorContentTemplate = "\n{\n}\n";
 
 const char *Templates::DeclareMetaTypeTemplate = "Q_DECLARE_METATYPE($full_type$)\n";
@@ -271,6 +568,10 @@ const char *Templates::RegisterLocalEnumTemplate = "qRegisterProtobufEnumType<$s
 const char *Templates::RegisterMapTemplate = "qRegisterMetaType<$scope_type$>(\"$full_type$\");\n"
                                              "qRegisterMetaType<$scope_type$>(\"$full_list_type$\");\n"
                                              "qRegisterProtobufMapType<$key_type$, $value_type$>();\n";
+const char *Templates::RegisterHashMapTemplate = "qRegisterMetaType<$scope_type$>(\"$full_type$\");\n"
+                                                 "qRegisterMetaType<$scope_type$>(\"$full_list_type$\");\n"
+                                                 "qRegisterProtobufMapType<$key_type$, $value_type$, QHash>();\n";
+const char *Templates::RegisterContiguousListTemplate = "qRegisterProtobufVectorType<$type$>();\n";
 
 const char *Templates::RegisterMetaTypeTemplateNoNamespace = "qRegisterMetaType<$namespaces$::$type$>(\"$type$\");\n";
 const char *Templates::RegisterMetaTypeTemplate = "qRegisterMetaType<$namespaces$::$type$>(\"$namespaces$::$type$\");\n";
@@ -337,6 +638,7 @@ const char *Templates::ClientMethodDefinitionQmlTemplate = "\nvoid $classname$::
 const char *Templates::RegisterSerializersTemplate = "qRegisterProtobufType<$classname$>();\n";
 const char *Templates::RegisterEnumSerializersTemplate = "qRegisterProtobufEnumType<$full_type$>();\n";
 const char *Templates::RegistrarTemplate = "static QtProtobuf::ProtoTypeRegistrar<$classname$> ProtoTypeRegistrar$classname$(qRegisterProtobufType<$classname$>);\n";
+const char *Templates::CompactRegistrarTemplate = "static QtProtobuf::ProtoTypeRegistrar<$classname$> ProtoTypeRegistrar$classname$(qRegisterProtobufCompactType<$classname$>);\n";
 const char *Templates::EnumRegistrarTemplate = "static QtProtobuf::ProtoTypeRegistrar<$enum_gadget$> ProtoTypeRegistrar$enum_gadget$($enum_gadget$::registerTypes);\n";
 const char *Templates::QmlRegisterTypeTemplate = "qmlRegisterType<$full_type$>(\"$qml_package$\", 1, 0, \"$type$\");\n";
 const char *Templates::QmlRegisterTypeUncreatableTemplate = "qmlRegisterUncreatableType<$full_name$>(\"$qml_package$\", 1, 0, \"$type$\", \"$full_type$ Could not be created from qml context\");\n";
@@ -52,11 +52,16 @@ public:
     static const char *UsingQtProtobufNamespaceTemplate;
     static const char *ManualRegistrationDeclaration;
     static const char *ManualRegistrationComplexTypeDefinition;
+    static const char *GadgetManualRegistrationComplexTypeDefinition;
     static const char *ManualRegistrationGlobalEnumDefinition;
     static const char *ComplexGlobalEnumFieldRegistrationTemplate;
     static const char *ComplexListTypeUsingTemplate;
+    static const char *ContiguousListTypeUsingTemplate;
+    static const char *GadgetListTypeUsingTemplate;
     static const char *MapTypeUsingTemplate;
     static const char *MessageMapTypeUsingTemplate;
+    static const char *HashMapTypeUsingTemplate;
+    static const char *MessageHashMapTypeUsingTemplate;
     static const char *NestedMessageUsingTemplate;
     static const char *EnumTypeRepeatedTemplate;
     static const char *NamespaceTemplate;
@@ -64,6 +69,7 @@ public:
     static const char *ClassDeclarationTemplate;
     static const char *ProtoClassForwardDeclarationTemplate;
     static const char *ProtoClassDeclarationBeginTemplate;
+    static const char *GadgetClassDeclarationBeginTemplate;
     static const char *ConstructorHeaderTemplate;
     static const char *ClassDefinitionTemplate;
     static const char *QObjectMacro;
@@ -74,12 +80,16 @@ public:
     static const char *NonScriptableAliasPropertyTemplate;
     static const char *MessagePropertyTemplate;
     static const char *QmlListPropertyTemplate;
+    static const char *GadgetPropertyTemplate;
+    static const char *GadgetRepeatedPropertyTemplate;
+    static const char *GadgetNonScriptablePropertyTemplate;
+    static const char *GadgetNonScriptableAliasPropertyTemplate;
 
     static const char *ConstructorParameterTemplate;
-    static const char *ConstructorMessageParameterTemplate;
     static const char *ConstructorRepeatedParameterTemplate;
     static const char *ProtoConstructorBeginTemplate;
     static const char *ProtoConstructorEndTemplate;
+    static const char *GadgetConstructorEndTemplate;
 
     static const char *ConstructorParameterDefinitionTemplate;
     static const char *ConstructorMessageParameterDefinitionTemplate;
@@ -87,10 +97,14 @@ public:
 
     static const char *ProtoConstructorDefinitionBeginTemplate;
     static const char *ProtoConstructorDefinitionEndTemplate;
+    static const char *GadgetConstructorDefinitionEndTemplate;
 
     static const char *MemberTemplate;
     static const char *ListMemberTemplate;
     static const char *ComplexMemberTemplate;
+    static const char *PresenceMemberTemplate;
+    static const char *PresenceInfoDeclarationTemplate;
+    static const char *OneofMemberTemplate;
     static const char *PublicBlockTemplate;
     static const char *PrivateBlockTemplate;
     static const char *EnumDefinitionTemplate;
@@ -103,15 +117,32 @@ public:
     static const char *MoveConstructorDefinitionTemplate;
     static const char *EmptyCopyConstructorDefinitionTemplate;
     static const char *EmptyMoveConstructorDefinitionTemplate;
+    static const char *GadgetCopyConstructorDefinitionTemplate;
+    static const char *GadgetMoveConstructorDefinitionTemplate;
+    static const char *GadgetEmptyCopyConstructorDefinitionTemplate;
+    static const char *GadgetEmptyMoveConstructorDefinitionTemplate;
     static const char *DeletedCopyConstructorTemplate;
     static const char *DeletedMoveConstructorTemplate;
     static const char *CopyFieldTemplate;
     static const char *CopyComplexFieldTemplate;
+    static const char *CopyMessageFieldTemplate;
+    static const char *CopyPresentFieldTemplate;
+    static const char *AssignPresentFieldTemplate;
+    static const char *CopyPresenceTemplate;
+    static const char *OneofCopyFieldTemplate;
+    static const char *OneofAssignFieldTemplate;
+    static const char *OneofMoveFieldTemplate;
+    static const char *OneofMovedPresenceTemplate;
+    static const char *OneofFieldChangedTemplate;
     static const char *MoveMessageFieldTemplate;
-    static const char *MoveComplexFieldTemplate;
-    static const char *MoveComplexFieldConstructorTemplate;
     static const char *MoveFieldTemplate;
-    static const char *EnumMoveFieldTemplate;
+    static const char *CopyFieldInitializerTemplate;
+    static const char *CopyMessageFieldInitializerTemplate;
+    static const char *MoveFieldInitializerTemplate;
+    static const char *MoveMessageFieldInitializerTemplate;
+    static const char *CopyPresenceInitializerTemplate;
+    static const char *OneofCopyFieldInitializerTemplate;
+    static const char *OneofMoveFieldInitializerTemplate;
     static const char *AssignmentOperatorDeclarationTemplate;
     static const char *AssignmentOperatorDefinitionTemplate;
     static const char *EmptyAssignmentOperatorDefinitionTemplate;
@@ -124,11 +155,27 @@ public:
     static const char *EmptyEqualOperatorDefinitionTemplate;
     static const char *EqualOperatorPropertyTemplate;
     static const char *EqualOperatorMessagePropertyTemplate;
+    static const char *OneofEqualOperatorPropertyTemplate;
     static const char *NotEqualOperatorDeclarationTemplate;
     static const char *NotEqualOperatorDefinitionTemplate;
     static const char *GetterPrivateMessageDeclarationTemplate;
     static const char *GetterPrivateMessageDefinitionTemplate;
     static const char *GetterMessageDeclarationTemplate;
+    static const char *HasFieldTemplate;
+    static const char *ClearFieldTemplate;
+    static const char *ClearQtTypeFieldTemplate;
+    static const char *ClearMessageFieldDeclarationTemplate;
+    static const char *ClearMessageFieldDefinitionTemplate;
+    static const char *OneofCaseEnumTemplate;
+    static const char *OneofCaseGetterTemplate;
+    static const char *OneofClearTemplate;
+    static const char *OneofHasFieldTemplate;
+    static const char *OneofClearFieldTemplate;
+    static const char *OneofGetterDeclarationTemplate;
+    static const char *OneofGetterDefinitionTemplate;
+    static const char *OneofGetterMessageDefinitionTemplate;
+    static const char *OneofGetterPrivateMessageDefinitionTemplate;
+    static const char *OneofNonScriptableGetterTemplate;
     static const char *GetterMessageDefinitionTemplate;
     static const char *GetterTemplate;
     static const char *NonScriptableGetterTemplate;
@@ -144,18 +191,70 @@ public:
     static const char *SetterTemplateDefinitionComplexType;
     static const char *SetterTemplate;
     static const char *NonScriptableSetterTemplate;
+    static const char *OneofNonScriptableSetterTemplate;
+    static const char *OneofSetterDefinitionTemplate;
+    static const char *OneofSetterPrivateMessageDefinitionTemplate;
+    static const char *OneofConstructorSetterTemplate;
+    static const char *GadgetSetterTemplateDefinitionMessageType;
+    static const char *GadgetSetterTemplateDefinitionComplexType;
+    static const char *GadgetSetterTemplate;
+    static const char *GadgetNonScriptableSetterTemplate;
+    static const char *GadgetOneofSetterDefinitionTemplate;
+    static const char *SharedDataIncludesTemplate;
+    static const char *SharedDataClassDeclarationTemplate;
+    static const char *SharedDataMemberTemplate;
+    static const char *SharedDataConstructorDefinitionTemplate;
+    static const char *SharedDataCopyConstructorDefinitionTemplate;
+    static const char *SharedDataDestructorDefinitionTemplate;
+    static const char *SharedDataInitializerTemplate;
+    static const char *SharedDataCopyInitializerTemplate;
+    static const char *SharedPropertyAssignmentTemplate;
+    static const char *SharedMessagePropertyAssignmentTemplate;
+    static const char *SharedDataAssignmentOperatorDefinitionTemplate;
+    static const char *SharedGadgetAssignmentOperatorDefinitionTemplate;
+    static const char *SharedAssignmentOperatorDefinitionTemplate;
+    static const char *SharedFieldChangedTemplate;
+    static const char *SharedMessageFieldChangedTemplate;
+    static const char *SharedOneofFieldChangedTemplate;
+    static const char *SharedMoveAssignmentOperatorDefinitionTemplate;
+    static const char *SharedEqualOperatorDefinitionTemplate;
+    static const char *SharedEqualOperatorPropertyTemplate;
+    static const char *SharedEqualOperatorMessagePropertyTemplate;
+    static const char *SharedOneofEqualOperatorPropertyTemplate;
+    static const char *SharedGetterTemplate;
+    static const char *SharedNonScriptableGetterTemplate;
+    static const char *SharedGetterContainerExtraTemplate;
+    static const char *SharedGetterPrivateMessageDefinitionTemplate;
+    static const char *SharedGetterMessageDefinitionTemplate;
+    static const char *SharedClearMessageFieldDefinitionTemplate;
+    static const char *SharedGetterQmlListDefinitionTemplate;
+    static const char *SharedSetterTemplate;
+    static const char *SharedNonScriptableSetterTemplate;
+    static const char *SharedSetterPrivateTemplateDefinitionMessageType;
+    static const char *SharedSetterTemplateDefinitionMessageType;
+    static const char *SharedSetterTemplateDefinitionComplexType;
+    static const char *SharedGadgetSetterTemplate;
+    static const char *SharedGadgetNonScriptableSetterTemplate;
+    static const char *SharedGadgetSetterTemplateDefinitionMessageType;
+    static const char *SharedGadgetSetterTemplateDefinitionComplexType;
     static const char *SignalsBlockTemplate;
     static const char *SignalTemplate;
+    static const char *FieldsOrderingArrayTemplate;
+    static const char *FieldsOrderingArrayEndTemplate;
     static const char *FieldsOrderingContainerTemplate;
+    static const char *FieldsOrderingContainerPresenceTemplate;
     static const char *FieldOrderTemplate;
+    static const char *PresenceInfoDefinitionTemplate;
     static const char *EnumTemplate;
     static const char *SimpleBlockEnclosureTemplate;
     static const char *SemicolonBlockEnclosureTemplate;
     static const char *EmptyBlockTemplate;
+    static const char *InitializerSeparatorTemplate;
+    static const char *FirstInitializerSeparatorTemplate;
     static const char *PropertyInitializerTemplate;
     static const char *PropertyDefaultInitializerTemplate;
     static const char *MessagePropertyInitializerTemplate;
-    static const char *MessagePropertyDefaultInitializerTemplate;
+    static const char *PresenceInitializerTemplate;
     static const char *ConstructorContentTemplate;
     static const char *DeclareMetaTypeTemplate;
     static const char *DeclareMetaTypeListTemplate;
@@ -165,6 +264,8 @@ public:
     static const char *DeclareMetaTypeMapTemplate;
     static const char *RegisterLocalEnumTemplate;
     static const char *RegisterMapTemplate;
+    static const char *RegisterHashMapTemplate;
+    static const char *RegisterContiguousListTemplate;
     static const char *RegisterMetaTypeTemplate;
     static const char *RegisterGlobalEnumMetaTypeTemplate;
     static const char *RegisterMetaTypeTemplateNoNamespace;
@@ -173,6 +274,7 @@ public:
     static const char *RegisterSerializersTemplate;
     static const char *RegisterEnumSerializersTemplate;
     static const char *RegistrarTemplate;
+    static const char *CompactRegistrarTemplate;
     static const char *EnumRegistrarTemplate;
     static const char *QmlRegisterTypeTemplate;
     static const char *QmlRegisterTypeUncreatableTemplate;
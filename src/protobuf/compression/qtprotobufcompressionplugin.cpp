@@ -0,0 +1,53 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "qtprotobufcompressionplugin.h"
+
+#include "qprotobufcompressedserializer.h"
+#include "qprotobufjsonserializer.h"
+
+using namespace QtProtobuf;
+
+namespace {
+const int FastestCompressionLevel = 1;
+const int BestCompressionLevel = 9;
+}
+
+QtProtobufCompressionPlugin::QtProtobufCompressionPlugin()
+{
+    m_serializers["protobuf"] = std::make_shared<QProtobufCompressedSerializer>();
+    m_serializers["protobuf-fast"] = std::make_shared<QProtobufCompressedSerializer>(nullptr, FastestCompressionLevel);
+    m_serializers["protobuf-best"] = std::make_shared<QProtobufCompressedSerializer>(nullptr, BestCompressionLevel);
+    m_serializers["json"] = std::make_shared<QProtobufCompressedSerializer>(std::make_shared<QProtobufJsonSerializer>());
+}
+
+std::shared_ptr<QAbstractProtobufSerializer> QtProtobufCompressionPlugin::serializer(const QString &serializerName)
+{
+    auto it = m_serializers.find(serializerName);
+    if (it == m_serializers.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
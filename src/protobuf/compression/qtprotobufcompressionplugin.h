@@ -0,0 +1,60 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+
+#include <memory>
+#include <unordered_map>
+
+#include "qprotobufserializationplugininterface.h"
+
+/*!
+ * \private
+ * \brief The QtProtobufCompressionPlugin class provides compressed serializers with preset compression levels
+ *
+ * \details Plugin provides following serializers:
+ *          - "protobuf" protobuf binary format compressed with default compression level
+ *          - "protobuf-fast" protobuf binary format compressed with fastest compression level
+ *          - "protobuf-best" protobuf binary format compressed with best compression level
+ *          - "json" json format compressed with default compression level
+ * \see QtProtobuf::QProtobufCompressedSerializer
+ */
+class QtProtobufCompressionPlugin : public QObject, QtProtobuf::QProtobufSerializationPluginInterface
+{
+    Q_OBJECT
+    Q_PLUGIN_METADATA(IID SerializatorInterface_iid FILE "compressioninfo.json")
+    Q_INTERFACES(QtProtobuf::QProtobufSerializationPluginInterface)
+
+public:
+    QtProtobufCompressionPlugin();
+    ~QtProtobufCompressionPlugin() = default;
+
+    std::shared_ptr<QtProtobuf::QAbstractProtobufSerializer> serializer(const QString &serializerName) override;
+
+private:
+    std::unordered_map<QString/*id*/, std::shared_ptr<QtProtobuf::QAbstractProtobufSerializer>> m_serializers;
+};
@@ -26,44 +26,43 @@
 #include <QMetaProperty>
 #include <QVariant>
 #include <QMetaObject>
-#include <QMutex>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
 #include <QSemaphore>
+#include <QAtomicInt>
+
+#include <exception>
+#include <memory>
+#include <vector>
 
 #include "qabstractprotobufserializer.h"
+#include "qprotobufmetaobject.h"
+#include "qprotobufsnapshotregistry_p.h"
 
 using namespace QtProtobuf;
 
 namespace  {
 
-const int MaximumSimultaniousThreads = 64;
 /*!
  * \private
  * \brief The HandlersRegistry is container to store mapping between metatype identifier and serialization handlers.
+ *        Lookups don't take any lock, see QProtobufSnapshotRegistry for details.
  */
 struct HandlersRegistry {
-
-    HandlersRegistry() : m_readLock(MaximumSimultaniousThreads) {
-
-    }
-
     void registerHandler(int userType, const QtProtobufPrivate::SerializationHandler &handlers) {
-        QMutexLocker locker(&m_writeLock);
-        QSemaphoreReleaser releaser(m_readLock, MaximumSimultaniousThreads);
-        m_readLock.acquire(MaximumSimultaniousThreads);
-        m_registry[userType] = handlers;
+        m_registry.modify([userType, &handlers](Registry::Map &registry) {
+            registry[userType] = handlers;
+        });
     }
 
     QtProtobufPrivate::SerializationHandler findHandler(int userType) {
-        auto handler = empty;
-        QMutexLocker locker(&m_writeLock);
-        QSemaphoreReleaser releaser(m_readLock, 1);
-        m_readLock.acquire();
-        locker.unlock();
-        auto it = m_registry.find(userType);
-        if (it != m_registry.end()) {
-            handler = it->second;
+        const auto registry = m_registry.snapshot();
+        auto it = registry->find(userType);
+        if (it != registry->end()) {
+            return it->second;
         }
-        return handler;
+        return empty;
     }
 
     static HandlersRegistry &instance() {
@@ -71,13 +70,71 @@ struct HandlersRegistry {
         return _instance;
     }
 private:
-    QSemaphore m_readLock;
-    QMutex m_writeLock;
-    std::unordered_map<int/*metatypeid*/, QtProtobufPrivate::SerializationHandler> m_registry;
+    using Registry = QtProtobufPrivate::QProtobufSnapshotRegistry<int/*metatypeid*/, QtProtobufPrivate::SerializationHandler>;
+    Registry m_registry;
     static QtProtobufPrivate::SerializationHandler empty;
 };
 
 QtProtobufPrivate::SerializationHandler HandlersRegistry::empty{};
+
+/*!
+ * \private
+ * \brief The ParallelJobs struct is state of single runParallel call, that is shared between caller and runners
+ *
+ * \details Chunks are claimed by atomic counter, so runners, that are started after all chunks are claimed, exit
+ *          without touching \a job. Runners own the state, caller may return while they are still queued in pool.
+ */
+struct ParallelJobs {
+    ParallelJobs(int count, int chunksCount, const std::function<void(int)> &job) : count(count)
+      , chunksCount(chunksCount)
+      , job(job)
+      , errors(static_cast<size_t>(chunksCount))
+    {}
+
+    //Runs chunks until all of them are claimed
+    void runChunks() {
+        int chunk = 0;
+        while ((chunk = nextChunk.fetchAndAddRelaxed(1)) < chunksCount) {
+            const int first = static_cast<int>(static_cast<qint64>(count) * chunk / chunksCount);
+            const int last = static_cast<int>(static_cast<qint64>(count) * (chunk + 1) / chunksCount);
+            try {
+                for (int index = first; index < last; index++) {
+                    job(index);
+                }
+            } catch (...) {
+                errors[static_cast<size_t>(chunk)] = std::current_exception();
+            }
+            //Last access to caller owned data of chunk
+            finished.release();
+        }
+    }
+
+    const int count;
+    const int chunksCount;
+    const std::function<void(int)> &job;
+    std::vector<std::exception_ptr> errors;
+    QAtomicInt nextChunk;
+    QSemaphore finished;
+};
+
+/*!
+ * \private
+ * \brief The ChunkRunner class runs chunks of parallel jobs in pool thread. Runners are deleted by pool
+ */
+class ChunkRunner : public QRunnable
+{
+public:
+    ChunkRunner(const std::shared_ptr<ParallelJobs> &jobs) : m_jobs(jobs) {}
+
+    void run() override {
+        m_jobs->runChunks();
+    }
+private:
+    std::shared_ptr<ParallelJobs> m_jobs;
+};
+
+//Few chunks per thread to balance jobs of different duration
+const int ChunksPerThread = 4;
 }
 
 void QtProtobufPrivate::registerHandler(int userType, const QtProtobufPrivate::SerializationHandler &handlers)
@@ -89,3 +146,255 @@ QtProtobufPrivate::SerializationHandler QtProtobufPrivate::findHandler(int userT
 {
     return HandlersRegistry::instance().findHandler(userType);
 }
+
+void QtProtobufPrivate::runParallel(int count, const std::function<void(int)> &job, QThreadPool *pool)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    if (pool == nullptr) {
+        pool = QThreadPool::globalInstance();
+    }
+
+    const int chunksCount = qBound(1, pool->maxThreadCount() * ChunksPerThread, count);
+    auto jobs = std::make_shared<ParallelJobs>(count, chunksCount, job);
+    for (int runner = 1; runner < qMin(chunksCount, pool->maxThreadCount()); runner++) {
+        pool->start(new ChunkRunner(jobs));
+    }
+
+    //Current thread takes part in processing too. Chunks that were not claimed by runners are executed
+    //in current thread, this also avoids deadlock when runParallel is called from thread of same pool
+    jobs->runChunks();
+    jobs->finished.acquire(chunksCount);
+
+    for (const auto &error : jobs->errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void QtProtobufPrivate::moveMessageToThread(QObject *message, const QProtobufMetaObject &metaObject, QThread *thread)
+{
+    if (message->thread() == QThread::currentThread()) {
+        message->moveToThread(thread);
+    }
+
+    for (const auto &field : metaObject.propertyOrdering) {
+        QMetaProperty metaProperty = metaObject.staticMetaObject.property(field.second);
+        auto handler = findHandler(metaProperty.userType());
+        if (!handler.iterator) {
+            continue;
+        }
+        handler.iterator(metaProperty.read(message), [thread](const QVariant &, const void *nested, const QProtobufMetaObject &nestedMetaObject) {
+            moveMessageToThread(const_cast<void *>(nested), nestedMetaObject, thread);
+        });
+    }
+}
+
+namespace {
+/*!
+ * \private
+ * \brief Returns message stored in object property \a value, that is either pointer to object inherited of QObject
+ *        or gadget, or nullptr if \a value doesn't hold message of \a objectType
+ */
+const void *compactMessagePointer(const QVariant &value, const QProtobufMetaObject &metaObject, int objectType)
+{
+    if (value.userType() != objectType) {
+        return nullptr;
+    }
+    return metaObject.isGadget() ? value.constData() : QtProtobufPrivate::messageAddress(value.value<QObject *>());
+}
+
+void serializeCompactObject(const QtProtobufPrivate::MessageTypeInfo *typeInfo, int objectType, const QAbstractProtobufSerializer *serializer,
+                            const QVariant &value, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer)
+{
+    Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
+    serializer->writeObject(compactMessagePointer(value, *typeInfo->metaObject, objectType), *typeInfo->metaObject, metaProperty, writer);
+}
+
+void deserializeCompactObject(const QtProtobufPrivate::MessageTypeInfo *typeInfo, int objectType, const QAbstractProtobufSerializer *serializer,
+                              QProtobufSelfcheckIterator &it, QVariant &to)
+{
+    Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
+    if (typeInfo->metaObject->isGadget()) {
+        //Gadget is deserialized in place, in default constructed value of variant
+        to = QVariant(objectType, nullptr);
+        serializer->deserializeObject(to.data(), *typeInfo->metaObject, it);
+        return;
+    }
+
+    //Generated messages inherit QObject only, so address of QObject is address of message
+    QObject *object = static_cast<QObject *>(typeInfo->create());
+    serializer->deserializeObject(object, *typeInfo->metaObject, it);
+    to = QVariant(objectType, &object);
+}
+
+void iterateCompactObject(const QtProtobufPrivate::MessageTypeInfo *typeInfo, int objectType, const QVariant &value,
+                          const QtProtobufPrivate::ObjectVisitor &visitor)
+{
+    const void *object = compactMessagePointer(value, *typeInfo->metaObject, objectType);
+    if (object != nullptr) {
+        visitor(QVariant(), object, *typeInfo->metaObject);
+    }
+}
+
+void serializeCompactList(const QtProtobufPrivate::MessageTypeInfo *typeInfo, int listType, const QAbstractProtobufSerializer *serializer,
+                          const QVariant &listValue, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer)
+{
+    Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
+    const int count = listValue.userType() == listType ? typeInfo->listCount(listValue) : 0;
+    const QProtobufMetaObject &metaObject = *typeInfo->metaObject;
+    qProtoDebug() << __func__ << "listValue.count" << count;
+
+    serializer->writeListBegin(metaProperty, writer);
+    const int threshold = serializer->parallelListThreshold();
+    if (threshold > 0 && count >= threshold) {
+        //Huge lists are serialized in chunks in parallel, chunks are concatenated in original order
+        const int chunksCount = qMin(count, QThreadPool::globalInstance()->maxThreadCount() * QtProtobufPrivate::ParallelChunksPerThread);
+        QVector<QByteArray> chunks(chunksCount);
+        QVector<QByteArray> pendings(chunksCount);
+        QByteArray *chunksData = chunks.data();
+        QByteArray *pendingsData = pendings.data();
+        QtProtobufPrivate::runParallel(chunksCount, [&](int chunk) {
+            const int first = static_cast<int>(static_cast<qint64>(count) * chunk / chunksCount);
+            const int last = static_cast<int>(static_cast<qint64>(count) * (chunk + 1) / chunksCount);
+            QProtobufByteArrayWriter chunkWriter(chunksData[chunk]);
+            for (int i = first; i < last; i++) {
+                const void *value = typeInfo->listAt(listValue, i);
+                if (value == nullptr) {
+                    qProtoWarning() << "Null pointer in list";
+                    continue;
+                }
+                serializer->writeListObject(value, metaObject, metaProperty, chunkWriter);
+            }
+            //Data, that serializer keeps pending after last element of chunk, is passed to writer as is
+            pendingsData[chunk] = chunkWriter.takePending();
+        }, nullptr);
+        for (int chunk = 0; chunk < chunksCount; chunk++) {
+            if (!chunks.at(chunk).isEmpty()) {
+                writer.write(chunks.at(chunk));
+            }
+            if (!pendings.at(chunk).isEmpty()) {
+                writer.setPending(pendings.at(chunk));
+            }
+        }
+    } else {
+        for (int i = 0; i < count; i++) {
+            const void *value = typeInfo->listAt(listValue, i);
+            if (value == nullptr) {
+                qProtoWarning() << "Null pointer in list";
+                continue;
+            }
+            serializer->writeListObject(value, metaObject, metaProperty, writer);
+        }
+    }
+    serializer->writeListEnd(metaProperty, writer);
+}
+
+void deserializeCompactList(const QtProtobufPrivate::MessageTypeInfo *typeInfo, int listType, const QAbstractProtobufSerializer *serializer,
+                            QProtobufSelfcheckIterator &it, QVariant &previous)
+{
+    Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
+    qProtoDebug() << __func__ << "currentByte:" << QString::number((*it), 16);
+
+    if (previous.userType() != listType) {
+        previous = QVariant(listType, nullptr);
+    }
+    const int count = typeInfo->listCount(previous);
+    typeInfo->listResize(previous, count + 1);
+    if (!serializer->deserializeListObject(typeInfo->listElement(previous, count), *typeInfo->metaObject, it)) {
+        typeInfo->listResize(previous, count);
+    }
+}
+
+void deserializeCompactListElements(const QtProtobufPrivate::MessageTypeInfo *typeInfo, int listType, const QAbstractProtobufSerializer *serializer,
+                                    const QVector<QByteArray> &elements, QVariant &previous)
+{
+    Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
+    qProtoDebug() << __func__ << "elements.count" << elements.count();
+
+    if (previous.userType() != listType) {
+        previous = QVariant(listType, nullptr);
+    }
+    const int offset = typeInfo->listCount(previous);
+    typeInfo->listResize(previous, offset + elements.count());
+    //List is not modified until all elements are deserialized, so element addresses stay valid
+    QVector<void *> objects(elements.count());
+    for (int i = 0; i < elements.count(); i++) {
+        objects[i] = typeInfo->listElement(previous, offset + i);
+    }
+
+    const QProtobufMetaObject &metaObject = *typeInfo->metaObject;
+    const int threshold = serializer->parallelListThreshold();
+    if (threshold > 0 && elements.count() >= threshold) {
+        QThread *thread = QThread::currentThread();
+        void *const *objectsData = objects.constData();
+        QtProtobufPrivate::runParallel(elements.count(), [serializer, &elements, objectsData, &metaObject, thread](int index) {
+            serializer->deserializeMessage(objectsData[index], metaObject, elements.at(index));
+            QtProtobufPrivate::moveMessageToThread(objectsData[index], metaObject, thread);
+        }, nullptr);
+    } else {
+        for (int i = 0; i < elements.count(); i++) {
+            serializer->deserializeMessage(objects.at(i), metaObject, elements.at(i));
+        }
+    }
+}
+
+void iterateCompactList(const QtProtobufPrivate::MessageTypeInfo *typeInfo, int listType, const QVariant &listValue,
+                        const QtProtobufPrivate::ObjectVisitor &visitor)
+{
+    if (listValue.userType() != listType) {
+        return;
+    }
+    const int count = typeInfo->listCount(listValue);
+    for (int i = 0; i < count; i++) {
+        const void *value = typeInfo->listAt(listValue, i);
+        if (value == nullptr) {
+            qProtoWarning() << "Null pointer in list";
+            continue;
+        }
+        visitor(QVariant(), value, *typeInfo->metaObject);
+    }
+}
+}
+
+void QtProtobufPrivate::registerCompactMessageHandlers(const MessageTypeInfo *typeInfo, int objectType, int listType)
+{
+    const bool isGadget = typeInfo->metaObject->isGadget();
+
+    SerializationHandler objectHandler{
+        [typeInfo, objectType](const QAbstractProtobufSerializer *serializer, const QVariant &value, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) {
+            serializeCompactObject(typeInfo, objectType, serializer, value, metaProperty, writer);
+        },
+        [typeInfo, objectType](const QAbstractProtobufSerializer *serializer, QProtobufSelfcheckIterator &it, QVariant &to) {
+            deserializeCompactObject(typeInfo, objectType, serializer, it, to);
+        }, ObjectHandler };
+    //Gadgets are copied out of properties, so their addresses are not stable and objects iterator is not registered
+    if (!isGadget) {
+        objectHandler.iterator = [typeInfo, objectType](const QVariant &value, const ObjectVisitor &visitor) {
+            iterateCompactObject(typeInfo, objectType, value, visitor);
+        };
+    }
+    objectHandler.metaObject = typeInfo->metaObject;
+    registerHandler(objectType, objectHandler);
+
+    SerializationHandler listHandler{
+        [typeInfo, listType](const QAbstractProtobufSerializer *serializer, const QVariant &value, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) {
+            serializeCompactList(typeInfo, listType, serializer, value, metaProperty, writer);
+        },
+        [typeInfo, listType](const QAbstractProtobufSerializer *serializer, QProtobufSelfcheckIterator &it, QVariant &previous) {
+            deserializeCompactList(typeInfo, listType, serializer, it, previous);
+        }, ListHandler };
+    if (!isGadget) {
+        listHandler.iterator = [typeInfo, listType](const QVariant &value, const ObjectVisitor &visitor) {
+            iterateCompactList(typeInfo, listType, value, visitor);
+        };
+    }
+    listHandler.listDeserializer = [typeInfo, listType](const QAbstractProtobufSerializer *serializer, const QVector<QByteArray> &elements, QVariant &previous) {
+        deserializeCompactListElements(typeInfo, listType, serializer, elements, previous);
+    };
+    listHandler.metaObject = typeInfo->metaObject;
+    registerHandler(listType, listHandler);
+}
@@ -28,6 +28,13 @@
 #include <QObject>
 #include <QVariant>
 #include <QMetaObject>
+#include <QIODevice>
+#include <QThread>
+#include <QSharedPointer>
+#include <QList>
+#include <QVector>
+#include <QMap>
+#include <QHash>
 
 #include <unordered_map>
 #include <functional>
@@ -36,6 +43,7 @@
 #include "qtprotobuftypes.h"
 #include "qtprotobuflogging.h"
 #include "qprotobufselfcheckiterator.h"
+#include "qprotobufwriter.h"
 
 #include "qtprotobufglobal.h"
 
@@ -43,14 +51,41 @@ namespace QtProtobuf {
 
 class QProtobufMetaProperty;
 class QProtobufMetaObject;
+class QAbstractProtobufSerializer;
+}
+
+class QThreadPool;
+
+namespace QtProtobufPrivate {
+/*!
+ * \private
+ * \brief Calls \a job for each index in range [0, \a count) using threads of \a pool. Global thread pool is used
+ *        if \a pool is nullptr. Returns when all jobs are finished, first exception thrown by \a job is rethrown
+ */
+extern Q_PROTOBUF_EXPORT void runParallel(int count, const std::function<void(int)> &job, QThreadPool *pool);
+
+/*!
+ * \private
+ * \brief Moves message \a object and all nested message objects, that are living in current thread, to \a thread
+ */
+extern Q_PROTOBUF_EXPORT void moveMessageToThread(QObject *object, const QtProtobuf::QProtobufMetaObject &metaObject, QThread *thread);
+
+/*!
+ * \private
+ * \brief Moves message \a object to \a thread, does nothing for Q_GADGET messages
+ */
+inline void moveMessageToThread(void *object, const QtProtobuf::QProtobufMetaObject &metaObject, QThread *thread);
+}
+
+namespace QtProtobuf {
 
 /*!
  * \ingroup QtProtobuf
  * \brief The QAbstractProtobufSerializer class is interface that represents basic functions for serialization/deserialization
  *
- * \details The QAbstractProtobufSerializer class registers serializers/deserializers for classes inherited of QObject.
- *          To register serializers for user-defined class it has to be inherited of QObject and contains
- *          Q_DECLARE_PROTOBUF_SERIALIZERS macro's.
+ * \details The QAbstractProtobufSerializer class registers serializers/deserializers for classes inherited of QObject
+ *          and for Q_GADGET value types. To register serializers for user-defined class it has to be inherited of QObject
+ *          or declared as Q_GADGET and contains Q_DECLARE_PROTOBUF_SERIALIZERS macro's.
  *          \code{.cpp}
  *          class MyType : public QObject
  *          {
@@ -75,16 +110,34 @@ public:
      * \brief Serialization of a registered qtproto message object into byte-array
      *
      *
-     * \param[in] object Pointer to QObject containing message to be serialized
+     * \param[in] object Pointer to message object inherited of QObject or to Q_GADGET message
      * \result serialized message bytes
      */
     template<typename T>
-    QByteArray serialize(const QObject *object) {
+    QByteArray serialize(const T *object) {
         Q_ASSERT(object != nullptr);
         qProtoDebug() << T::staticMetaObject.className() << "serialize";
         return serializeMessage(object, T::protobufMetaObject);
     }
 
+    /*!
+     * \brief Serialization of a registered qtproto message object directly into \a device
+     *
+     * \details Unlike serialize() the complete message is not collected in memory, serializers that support
+     *          streaming write encoded bytes to \a device as soon as they are produced.
+     *
+     * \param[in] object Pointer to message object inherited of QObject or to Q_GADGET message
+     * \param[in] device Opened for writing device that receives serialized message bytes
+     * \result true if all serialized bytes were written to \a device
+     */
+    template<typename T>
+    bool serializeTo(const T *object, QIODevice *device) {
+        Q_ASSERT(object != nullptr);
+        Q_ASSERT(device != nullptr);
+        qProtoDebug() << T::staticMetaObject.className() << "serializeTo";
+        return serializeMessageTo(object, T::protobufMetaObject, device);
+    }
+
     /*!
      * \brief Deserialization of a byte-array into a registered qtproto message object
      *
@@ -110,25 +163,107 @@ public:
         *object = newValue;
     }
 
+    /*!
+     * \brief Serialization of independent messages in parallel
+     *
+     * \details Messages are serialized using threads of \a pool, global thread pool is used if \a pool is nullptr.
+     *          Messages must not be modified while serialization is in progress.
+     *
+     * \param[in] messages List of messages to be serialized
+     * \param[in] pool Thread pool that is used for serialization
+     * \result list of serialized messages bytes in same order as \a messages
+     */
+    template<typename T>
+    QList<QByteArray> serializeBatch(const QList<QSharedPointer<T>> &messages, QThreadPool *pool = nullptr) {
+        QVector<QByteArray> results(messages.size());
+        QByteArray *data = results.data();
+        QtProtobufPrivate::runParallel(messages.size(), [this, &messages, data](int index) {
+            const QSharedPointer<T> &message = messages.at(index);
+            if (!message.isNull()) {
+                data[index] = serializeMessage(message.data(), T::protobufMetaObject);
+            }
+        }, pool);
+        return results.toList();
+    }
+
+    /*!
+     * \brief Deserialization of independent messages in parallel
+     *
+     * \details Messages are deserialized using threads of \a pool, global thread pool is used if \a pool is nullptr.
+     *          Deserialized message objects are moved to thread that called deserializeBatch.
+     *          If deserialization of any message fails, first exception is rethrown after all messages are processed.
+     *
+     * \param[in] payloads List of serialized messages
+     * \param[in] pool Thread pool that is used for deserialization
+     * \result list of deserialized messages in same order as \a payloads
+     */
+    template<typename T>
+    QList<QSharedPointer<T>> deserializeBatch(const QList<QByteArray> &payloads, QThreadPool *pool = nullptr) {
+        QVector<QSharedPointer<T>> results(payloads.size());
+        QSharedPointer<T> *data = results.data();
+        QThread *thread = QThread::currentThread();
+        QtProtobufPrivate::runParallel(payloads.size(), [this, &payloads, data, thread](int index) {
+            QSharedPointer<T> message(new T);
+            deserialize<T>(message.data(), payloads.at(index));
+            QtProtobufPrivate::moveMessageToThread(message.data(), T::protobufMetaObject, thread);
+            data[index] = message;
+        }, pool);
+        return results.toList();
+    }
+
     virtual ~QAbstractProtobufSerializer() = default;
 
     /*!
-     * \brief serializeMessage
-     * \param object
-     * \param propertyOrdering
-     * \param metaObject
-     * \return
+     * \brief Enables parallel processing of repeated message fields that contain at least \a threshold elements
+     *
+     * \details Elements of such fields are serialized in chunks using global thread pool, chunks are concatenated
+     *          in original order. Serializers that support it also deserialize such fields in two passes: element
+     *          boundaries are collected first and elements are deserialized in parallel afterwards.
+     *          Value 0 disables parallel processing, that is default.
+     */
+    void setParallelListThreshold(int threshold) { m_parallelListThreshold = qMax(0, threshold); }
+
+    /*!
+     * \brief Returns minimal number of repeated message field elements that enables parallel processing
+     * \see setParallelListThreshold
+     */
+    int parallelListThreshold() const { return m_parallelListThreshold; }
+
+    /*!
+     * \brief serializeMessage Serializes \a object according given \a metaObject
+     * \details Message methods receive type-erased message address. It's address of Q_GADGET message or address of
+     *          QObject of message inherited of QObject, \a metaObject tells which of them, see
+     *          QProtobufMetaObject::isGadget(). Properties are accessed by QProtobufMetaObject::readProperty and
+     *          QProtobufMetaObject::writeProperty, that work for both kinds of messages. Overloads that take QObject
+     *          pointer are not virtual and forward to these methods.
+     * \param[in] object Pointer to message to be serialized
+     * \param[in] metaObject Protobuf meta object information for given \a object
+     * \return Raw serialized data represented as byte array
      */
-    virtual QByteArray serializeMessage(const QObject *object, const QProtobufMetaObject &metaObject) const = 0;
+    virtual QByteArray serializeMessage(const void *object, const QProtobufMetaObject &metaObject) const = 0;
+
+    /*!
+     * \brief serializeMessageTo Serializes \a object according given \a metaObject and writes result to \a device
+     * \details Default implementation passes writer of \a device to writeMessage(). Serializers that are able
+     *          to stream message more efficiently may reimplement this method.
+     * \param[in] object Pointer to object to be serialized
+     * \param[in] metaObject Protobuf meta object information for given \a object
+     * \param[in] device Device that receives serialized message bytes
+     * \return true if all serialized bytes were written to \a device
+     */
+    virtual bool serializeMessageTo(const void *object, const QProtobufMetaObject &metaObject, QIODevice *device) const {
+        QProtobufDeviceWriter writer(device);
+        writeMessage(object, metaObject, writer);
+        return writer.flush();
+    }
 
     /*!
-     * \brief serializeMessage
-     * \param object
-     * \param propertyOrdering
-     * \param metaObject
-     * \return
+     * \brief deserializeMessage Deserializes \a data to \a object according given \a metaObject
+     * \param[out] object Pointer to message, see serializeMessage() for details
+     * \param[in] metaObject Protobuf meta object information for given \a object
+     * \param[in] data Serialized message bytes
      */
-    virtual void deserializeMessage(QObject *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const = 0;
+    virtual void deserializeMessage(void *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const = 0;
 
     /*!
      * \brief serializeObject Serializes complete \a object according given \a propertyOrdering and \a metaObject
@@ -138,7 +273,7 @@ public:
      * \param[in] metaProperty Information about property to be serialized
      * \return Raw serialized data represented as byte array
      */
-    virtual QByteArray serializeObject(const QObject *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const = 0;
+    virtual QByteArray serializeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const = 0;
 
     /*!
      * \brief deserializeObject Deserializes buffer to an \a object
@@ -149,7 +284,7 @@ public:
      * \param[in] propertyOrdering Ordering of properties for given \a object
      * \param[in] metaProperty Information about property to be serialized
      */
-    virtual void deserializeObject(QObject *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const = 0;
+    virtual void deserializeObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const = 0;
 
     /*!
      * \brief serializeListBegin Method called at the begining of object list serialization
@@ -168,7 +303,7 @@ public:
      * \param[in] metaProperty Information about property to be serialized
      * \return Raw serialized data represented as byte array
      */
-    virtual QByteArray serializeListObject(const QObject *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const = 0;
+    virtual QByteArray serializeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const = 0;
 
     /*!
      * \brief serializeListEnd Method called at the end of object list serialization
@@ -189,7 +324,7 @@ public:
      *        property value and write new property to \a object
      * \param[in] it Pointer to beging of buffer where object serialized data is located
      */
-    virtual bool deserializeListObject(QObject *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const = 0;
+    virtual bool deserializeListObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const = 0;
 
     /*!
      * \brief serializeMapEnd Method called at the begining of map serialization
@@ -272,49 +407,277 @@ public:
      * \param[in] it Points to serialized raw key/value data
      */
     virtual void deserializeEnumList(QList<int64> &value, const QMetaEnum &metaEnum, QProtobufSelfcheckIterator &it) const = 0;
+
+    /*!
+     * \brief writeMessage Serializes \a object according given \a metaObject to \a writer
+     * \details Methods of write family are used by serialization core to pass data sink to serializer.
+     *          Default implementations adapt serializers that implement only QByteArray based methods
+     *          and write returned data to \a writer.
+     * \see QAbstractProtobufSinkSerializer
+     */
+    virtual void writeMessage(const void *object, const QProtobufMetaObject &metaObject, QProtobufWriter &writer) const {
+        writer.write(serializeMessage(object, metaObject));
+    }
+
+    /*!
+     * \brief writeObject Serializes \a object as value of property described by \a metaProperty to \a writer
+     * \see serializeObject
+     */
+    virtual void writeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const {
+        writer.write(serializeObject(object, metaObject, metaProperty));
+    }
+
+    /*!
+     * \brief writeListBegin Method called at the begining of object list serialization
+     * \see serializeListBegin
+     */
+    virtual void writeListBegin(const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const {
+        writer.write(serializeListBegin(metaProperty));
+    }
+
+    /*!
+     * \brief writeListObject Serializes \a object as a part of list property to \a writer
+     * \details Default implementation keeps serialized object pending in \a writer, so writeListEnd() is able
+     *          to pass it to serializeListEnd() and serializer may modify its end, e.g. remove trailing separator
+     * \see serializeListObject
+     */
+    virtual void writeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const {
+        writer.setPending(serializeListObject(object, metaObject, metaProperty));
+    }
+
+    /*!
+     * \brief writeListEnd Method called at the end of object list serialization
+     * \see serializeListEnd
+     */
+    virtual void writeListEnd(const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const {
+        QByteArray last = writer.takePending();
+        QByteArray end = serializeListEnd(last, metaProperty);
+        writer.write(last);
+        writer.write(end);
+    }
+
+    /*!
+     * \brief writeMapBegin Method called at the begining of map serialization
+     * \see serializeMapBegin
+     */
+    virtual void writeMapBegin(const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const {
+        writer.write(serializeMapBegin(metaProperty));
+    }
+
+    /*!
+     * \brief writeMapPair Serializes QMap pair of \a key and \a value to \a writer
+     * \details Default implementation keeps serialized pair pending in \a writer, see writeListObject()
+     * \see serializeMapPair
+     */
+    virtual void writeMapPair(const QVariant &key, const QVariant &value, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const {
+        writer.setPending(serializeMapPair(key, value, metaProperty));
+    }
+
+    /*!
+     * \brief writeMapEnd Method called at the end of map serialization
+     * \see serializeMapEnd
+     */
+    virtual void writeMapEnd(const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const {
+        QByteArray last = writer.takePending();
+        QByteArray end = serializeMapEnd(last, metaProperty);
+        writer.write(last);
+        writer.write(end);
+    }
+
+    /*!
+     * \brief writeEnum Serializes enum \a value to \a writer
+     * \see serializeEnum
+     */
+    virtual void writeEnum(int64 value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const {
+        writer.write(serializeEnum(value, metaEnum, metaProperty));
+    }
+
+    /*!
+     * \brief writeEnumList Serializes list of enum values to \a writer
+     * \see serializeEnumList
+     */
+    virtual void writeEnumList(const QList<int64> &value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const {
+        writer.write(serializeEnumList(value, metaEnum, metaProperty));
+    }
+
+    //------------------Forwarders for messages inherited of QObject------------------
+    /*!
+     * \brief Forwards message inherited of QObject to serializeMessage(const void *, const QProtobufMetaObject &)
+     * \details Message address is taken as address of its QObject, that is expected by QProtobufMetaObject.
+     *          Same applies to all forwarders below.
+     */
+    QByteArray serializeMessage(const QObject *object, const QProtobufMetaObject &metaObject) const {
+        return serializeMessage(static_cast<const void *>(object), metaObject);
+    }
+
+    //! \private
+    bool serializeMessageTo(const QObject *object, const QProtobufMetaObject &metaObject, QIODevice *device) const {
+        return serializeMessageTo(static_cast<const void *>(object), metaObject, device);
+    }
+
+    //! \private
+    void deserializeMessage(QObject *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const {
+        deserializeMessage(static_cast<void *>(object), metaObject, data);
+    }
+
+    //! \private
+    QByteArray serializeObject(const QObject *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const {
+        return serializeObject(static_cast<const void *>(object), metaObject, metaProperty);
+    }
+
+    //! \private
+    void deserializeObject(QObject *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const {
+        deserializeObject(static_cast<void *>(object), metaObject, it);
+    }
+
+    //! \private
+    QByteArray serializeListObject(const QObject *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const {
+        return serializeListObject(static_cast<const void *>(object), metaObject, metaProperty);
+    }
+
+    //! \private
+    bool deserializeListObject(QObject *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const {
+        return deserializeListObject(static_cast<void *>(object), metaObject, it);
+    }
+
+    //! \private
+    void writeMessage(const QObject *object, const QProtobufMetaObject &metaObject, QProtobufWriter &writer) const {
+        writeMessage(static_cast<const void *>(object), metaObject, writer);
+    }
+
+    //! \private
+    void writeObject(const QObject *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const {
+        writeObject(static_cast<const void *>(object), metaObject, metaProperty, writer);
+    }
+
+    //! \private
+    void writeListObject(const QObject *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const {
+        writeListObject(static_cast<const void *>(object), metaObject, metaProperty, writer);
+    }
+
+private:
+    int m_parallelListThreshold = 0;
 };
 /*! \} */
 }
 
 #include "qabstractprotobufserializer_p.h"
 
+namespace QtProtobufPrivate {
+/*!
+ * \private
+ * \brief Registers handlers for type T inherited of QObject. Message is stored in properties as T* and
+ *        in repeated properties as QList<QSharedPointer<T>>
+ */
+template<typename T,
+         typename std::enable_if_t<std::is_base_of<QObject, T>::value, int> = 0>
+void registerMessageHandlers() {
+    SerializationHandler objectHandler{ serializeObject<T>, deserializeObject<T>, ObjectHandler, iterateObject<T> };
+    objectHandler.metaObject = &T::protobufMetaObject;
+    registerHandler(qMetaTypeId<T *>(), objectHandler);
+
+    SerializationHandler listHandler{ serializeList<T>, deserializeList<T>, ListHandler, iterateList<T>,
+            deserializeListElements<T> };
+    listHandler.metaObject = &T::protobufMetaObject;
+    registerHandler(qMetaTypeId<QList<QSharedPointer<T>>>(), listHandler);
+}
+
+/*!
+ * \private
+ * \brief Registers handlers for gadget type T. Message is stored in properties by value and in repeated
+ *        properties as QList<T>
+ * \details Objects iterators are not registered: gadgets are copied out of properties, so their addresses
+ *          are not stable and nested gadgets are serialized as usual fields
+ */
+template<typename T,
+         typename std::enable_if_t<!std::is_base_of<QObject, T>::value, int> = 0>
+void registerMessageHandlers() {
+    SerializationHandler objectHandler{ serializeObject<T>, deserializeObject<T>, ObjectHandler };
+    objectHandler.metaObject = &T::protobufMetaObject;
+    registerHandler(qMetaTypeId<T>(), objectHandler);
+
+    SerializationHandler listHandler{ serializeList<T>, deserializeList<T>, ListHandler, nullptr,
+            deserializeListElements<T> };
+    listHandler.metaObject = &T::protobufMetaObject;
+    registerHandler(qMetaTypeId<QList<T>>(), listHandler);
+}
+}
+
 /*!
  * \brief Registers serializers for type T in QtProtobuf global serializers registry
  * \private
- * \details generates default serializers for type T. Type T has to be inherited of QObject.
+ * \details generates default serializers for type T. Type T has to be inherited of QObject or has to be
+ *          Q_GADGET value type.
  */
 template<typename T>
 static void qRegisterProtobufType() {
     T::registerTypes();
-    QtProtobufPrivate::registerHandler(qMetaTypeId<T *>(), { QtProtobufPrivate::serializeObject<T>,
-            QtProtobufPrivate::deserializeObject<T>, QtProtobufPrivate::ObjectHandler });
-    QtProtobufPrivate::registerHandler(qMetaTypeId<QList<QSharedPointer<T>>>(), { QtProtobufPrivate::serializeList<T>,
-            QtProtobufPrivate::deserializeList<T>, QtProtobufPrivate::ListHandler });
+    QtProtobufPrivate::registerMessageHandlers<T>();
+}
+
+/*!
+ * \brief Registers shared serializers for type T in QtProtobuf global serializers registry
+ * \private
+ * \details registers serializers of messages generated with COMPACT option. Unlike qRegisterProtobufType
+ *          handlers are not instantiated for type T, but are shared by all message types and use constant
+ *          type table of T. Type T has to be inherited of QObject or has to be Q_GADGET value type.
+ */
+template<typename T>
+static void qRegisterProtobufCompactType() {
+    static const QtProtobufPrivate::MessageTypeInfo typeInfo = QtProtobufPrivate::messageTypeInfo<T>();
+    T::registerTypes();
+    QtProtobufPrivate::registerCompactMessageHandlers(&typeInfo, qMetaTypeId<typename QtProtobufPrivate::MessageStorage<T>::Object>(),
+                                                      qMetaTypeId<typename QtProtobufPrivate::MessageStorage<T>::List>());
+}
+
+/*!
+ * \brief Registers serializers for contiguous repeated type QVector<T> in QtProtobuf global serializers registry
+ * \private
+ * \details generates default serializers for repeated message fields that store gadget messages of type T by value
+ *          in single QVector<T> buffer. Type T is registered as usual with qRegisterProtobufType.
+ */
+template<typename T>
+inline void qRegisterProtobufVectorType() {
+    //QVector relocates its elements, so it can't hold QObject messages, which addresses are kept by Qt
+    static_assert(!std::is_base_of<QObject, T>::value, "Contiguous repeated fields hold gadget messages only");
+    QtProtobufPrivate::SerializationHandler vectorHandler{ QtProtobufPrivate::serializeVector<T>,
+            QtProtobufPrivate::deserializeVector<T>, QtProtobufPrivate::ListHandler, nullptr,
+            QtProtobufPrivate::deserializeVectorElements<T> };
+    vectorHandler.metaObject = &T::protobufMetaObject;
+    QtProtobufPrivate::registerHandler(qMetaTypeId<QVector<T>>(), vectorHandler);
 }
 
 /*!
- * \brief Registers serializers for type QMap<K, V> in QtProtobuf global serializers registry
+ * \brief Registers serializers for type Map<K, V> in QtProtobuf global serializers registry
  * \private
- * \details generates default serializers for QMap<K, V>.
+ * \details generates default serializers for Map<K, V>. Map is QMap by default, QHash is used for maps,
+ *          generated with HASH_MAPS option.
  */
-template<typename K, typename V,
+template<typename K, typename V, template<typename, typename> class Map = QMap,
          typename std::enable_if_t<!std::is_base_of<QObject, V>::value, int> = 0>
 inline void qRegisterProtobufMapType() {
-    QtProtobufPrivate::registerHandler(qMetaTypeId<QMap<K, V>>(), { QtProtobufPrivate::serializeMap<K, V>,
-    QtProtobufPrivate::deserializeMap<K, V>, QtProtobufPrivate::MapHandler });
+    QtProtobufPrivate::SerializationHandler mapHandler{ QtProtobufPrivate::serializeMap<K, V, Map>,
+            QtProtobufPrivate::deserializeMap<K, V, Map>, QtProtobufPrivate::MapHandler };
+    mapHandler.mapKeyType = qMetaTypeId<K>();
+    mapHandler.mapValueType = qMetaTypeId<V>();
+    QtProtobufPrivate::registerHandler(qMetaTypeId<Map<K, V>>(), mapHandler);
 }
 
 /*!
- * \brief Registers serializers for type QMap<K, V> in QtProtobuf global serializers registry
+ * \brief Registers serializers for type Map<K, V> in QtProtobuf global serializers registry
  * \private
- * \details generates default serializers for QMap<K, V>. Specialization for V type
+ * \details generates default serializers for Map<K, V>. Specialization for V type
  *          inherited of QObject.
  */
-template<typename K, typename V,
+template<typename K, typename V, template<typename, typename> class Map = QMap,
          typename std::enable_if_t<std::is_base_of<QObject, V>::value, int> = 0>
 inline void qRegisterProtobufMapType() {
-    QtProtobufPrivate::registerHandler(qMetaTypeId<QMap<K, QSharedPointer<V>>>(), { QtProtobufPrivate::serializeMap<K, V>,
-    QtProtobufPrivate::deserializeMap<K, V>, QtProtobufPrivate::MapHandler });
+    QtProtobufPrivate::SerializationHandler mapHandler{ QtProtobufPrivate::serializeMap<K, V, Map>,
+            QtProtobufPrivate::deserializeMap<K, V, Map>, QtProtobufPrivate::MapHandler, QtProtobufPrivate::iterateMap<K, V, Map> };
+    mapHandler.metaObject = &V::protobufMetaObject;
+    mapHandler.mapKeyType = qMetaTypeId<K>();
+    mapHandler.mapValueType = qMetaTypeId<V *>();
+    QtProtobufPrivate::registerHandler(qMetaTypeId<Map<K, QSharedPointer<V>>>(), mapHandler);
 }
 
 
@@ -326,8 +689,13 @@ inline void qRegisterProtobufMapType() {
 template<typename T,
          typename std::enable_if_t<std::is_enum<T>::value, int> = 0>
 inline void qRegisterProtobufEnumType() {
-    QtProtobufPrivate::registerHandler(qMetaTypeId<T>(), { QtProtobufPrivate::serializeEnum<T>,
-                                                           QtProtobufPrivate::deserializeEnum<T>, QtProtobufPrivate::ObjectHandler });
-    QtProtobufPrivate::registerHandler(qMetaTypeId<QList<T>>(), { QtProtobufPrivate::serializeEnumList<T>,
-                                                           QtProtobufPrivate::deserializeEnumList<T>, QtProtobufPrivate::ListHandler });
+    QtProtobufPrivate::SerializationHandler enumHandler{ QtProtobufPrivate::serializeEnum<T>,
+            QtProtobufPrivate::deserializeEnum<T>, QtProtobufPrivate::ObjectHandler };
+    enumHandler.metaEnum = QMetaEnum::fromType<T>();
+    QtProtobufPrivate::registerHandler(qMetaTypeId<T>(), enumHandler);
+
+    QtProtobufPrivate::SerializationHandler enumListHandler{ QtProtobufPrivate::serializeEnumList<T>,
+            QtProtobufPrivate::deserializeEnumList<T>, QtProtobufPrivate::ListHandler };
+    enumListHandler.metaEnum = enumHandler.metaEnum;
+    QtProtobufPrivate::registerHandler(qMetaTypeId<QList<T>>(), enumListHandler);
 }
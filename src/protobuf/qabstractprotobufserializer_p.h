@@ -29,29 +29,61 @@
 #include <QVariant>
 #include <QMetaObject>
 #include <QMetaEnum>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QMap>
+#include <QHash>
+#include <QSharedPointer>
 
 #include <functional>
 
 #include "qtprotobuftypes.h"
 #include "qtprotobuflogging.h"
 #include "qtprotobufglobal.h"
+#include "qprotobufwriter.h"
+#include "qprotobufmetaobject.h"
 
 namespace QtProtobuf {
     class QAbstractProtobufSerializer;
     class QProtobufSelfcheckIterator;
     class QProtobufMetaProperty;
+    class QProtobufMetaObject;
 }
 
 namespace QtProtobufPrivate {
 //! \private
 constexpr int NotUsedFieldIndex = -1;
+//! \private
+constexpr int ParallelChunksPerThread = 4;
 
-using Serializer = std::function<void(const QtProtobuf::QAbstractProtobufSerializer *, const QVariant &, const QtProtobuf::QProtobufMetaProperty &, QByteArray &)>;
+/*!
+ * \brief Serializer is interface function for serialize method, serialized data is written to given writer
+ */
+using Serializer = std::function<void(const QtProtobuf::QAbstractProtobufSerializer *, const QVariant &, const QtProtobuf::QProtobufMetaProperty &, QtProtobuf::QProtobufWriter &)>;
 /*!
  * \brief Deserializer is interface function for deserialize method
  */
 using Deserializer = std::function<void(const QtProtobuf::QAbstractProtobufSerializer *, QtProtobuf::QProtobufSelfcheckIterator &, QVariant &)>;
 
+/*!
+ * \private
+ * \brief ObjectVisitor is called for each message object stored in property value. For map values \a key holds
+ *        the map key of \a object, otherwise \a key is invalid. Message inherited of QObject is passed as address
+ *        of its QObject
+ */
+using ObjectVisitor = std::function<void(const QVariant &key, const void *object, const QtProtobuf::QProtobufMetaObject &metaObject)>;
+/*!
+ * \private
+ * \brief ObjectsIterator is interface function that visits message objects stored in property value
+ */
+using ObjectsIterator = std::function<void(const QVariant &, const ObjectVisitor &)>;
+/*!
+ * \private
+ * \brief ListDeserializer is interface function that deserializes list of serialized message objects at once
+ */
+using ListDeserializer = std::function<void(const QtProtobuf::QAbstractProtobufSerializer *, const QVector<QByteArray> &, QVariant &)>;
+
 enum HandlerType {
     ObjectHandler,
     ListHandler,
@@ -66,79 +98,175 @@ struct SerializationHandler {
     Serializer serializer; /*!< serializer assigned to class */
     Deserializer deserializer;/*!< deserializer assigned to class */
     HandlerType type;/*!< Serialization WireType */
+    ObjectsIterator iterator = nullptr;/*!< optional, gives serializer access to nested message objects, e.g. for streaming */
+    ListDeserializer listDeserializer = nullptr;/*!< optional, deserializes all collected elements of repeated message field */
+    const QtProtobuf::QProtobufMetaObject *metaObject = nullptr;/*!< optional, meta object of message, message list element or message map value */
+    QMetaEnum metaEnum;/*!< optional, meta enum of enum or enum list type */
+    int mapKeyType = QMetaType::UnknownType;/*!< optional, meta type of map key */
+    int mapValueType = QMetaType::UnknownType;/*!< optional, meta type of map value */
 };
 
 extern Q_PROTOBUF_EXPORT SerializationHandler findHandler(int userType);
 extern Q_PROTOBUF_EXPORT void registerHandler(int userType, const SerializationHandler &handlers);
 
+inline void moveMessageToThread(void *object, const QtProtobuf::QProtobufMetaObject &metaObject, QThread *thread) {
+    if (!metaObject.isGadget()) {
+        moveMessageToThread(static_cast<QObject *>(object), metaObject, thread);
+    }
+}
+
 /*!
  * \private
  * \brief default serializer template for type T inherited of QObject
  */
 template <typename T,
           typename std::enable_if_t<std::is_base_of<QObject, T>::value, int> = 0>
-void serializeObject(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &value, const QtProtobuf::QProtobufMetaProperty &metaProperty, QByteArray &buffer) {
+void serializeObject(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &value, const QtProtobuf::QProtobufMetaProperty &metaProperty, QtProtobuf::QProtobufWriter &writer) {
     Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
-    buffer.append(serializer->serializeObject(value.value<T *>(), T::protobufMetaObject, metaProperty));
+    serializer->writeObject(value.value<T *>(), T::protobufMetaObject, metaProperty, writer);
 }
 
 /*!
  * \private
- * \brief default serializer template for list of type T objects inherited of QObject
+ * \brief default serializer template for gadget type T
  */
-template<typename V,
-         typename std::enable_if_t<std::is_base_of<QObject, V>::value, int> = 0>
-void serializeList(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &listValue, const QtProtobuf::QProtobufMetaProperty &metaProperty, QByteArray &buffer) {
+template <typename T,
+          typename std::enable_if_t<!std::is_base_of<QObject, T>::value, int> = 0>
+void serializeObject(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &value, const QtProtobuf::QProtobufMetaProperty &metaProperty, QtProtobuf::QProtobufWriter &writer) {
     Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
-    QList<QSharedPointer<V>> list = listValue.value<QList<QSharedPointer<V>>>();
+    //Gadget is serialized in place, without copying it out of variant
+    serializer->writeObject(value.constData(), T::protobufMetaObject, metaProperty, writer);
+}
+
+//! \private
+template <typename V>
+const V *messagePointer(const QSharedPointer<V> &value) { return value.data(); }
 
+//! \private
+template <typename V>
+const V *messagePointer(const V &value) { return &value; }
+
+/*!
+ * \private
+ * \brief Writes all messages of \a list, that is either list of shared pointers to objects inherited of QObject
+ *        or list of gadgets of type V
+ */
+template<typename V, typename L>
+void writeListObjects(const QtProtobuf::QAbstractProtobufSerializer *serializer, const L &list, const QtProtobuf::QProtobufMetaProperty &metaProperty, QtProtobuf::QProtobufWriter &writer) {
     qProtoDebug() << __func__ << "listValue.count" << list.count();
 
-    buffer.append(serializer->serializeListBegin(metaProperty));
-    for (auto &value : list) {
-        if (!value) {
-            qProtoWarning() << "Null pointer in list";
-            continue;
+    serializer->writeListBegin(metaProperty, writer);
+    const int threshold = serializer->parallelListThreshold();
+    if (threshold > 0 && list.count() >= threshold) {
+        //Huge lists are serialized in chunks in parallel, chunks are concatenated in original order
+        const int chunksCount = qMin(list.count(), QThreadPool::globalInstance()->maxThreadCount() * ParallelChunksPerThread);
+        QVector<QByteArray> chunks(chunksCount);
+        QVector<QByteArray> pendings(chunksCount);
+        QByteArray *chunksData = chunks.data();
+        QByteArray *pendingsData = pendings.data();
+        runParallel(chunksCount, [&](int chunk) {
+            const int first = static_cast<int>(static_cast<qint64>(list.count()) * chunk / chunksCount);
+            const int last = static_cast<int>(static_cast<qint64>(list.count()) * (chunk + 1) / chunksCount);
+            QtProtobuf::QProtobufByteArrayWriter chunkWriter(chunksData[chunk]);
+            for (int i = first; i < last; i++) {
+                const V *value = messagePointer(list.at(i));
+                if (value == nullptr) {
+                    qProtoWarning() << "Null pointer in list";
+                    continue;
+                }
+                serializer->writeListObject(value, V::protobufMetaObject, metaProperty, chunkWriter);
+            }
+            //Data, that serializer keeps pending after last element of chunk, is passed to writer as is
+            pendingsData[chunk] = chunkWriter.takePending();
+        }, nullptr);
+        for (int chunk = 0; chunk < chunksCount; chunk++) {
+            if (!chunks.at(chunk).isEmpty()) {
+                writer.write(chunks.at(chunk));
+            }
+            if (!pendings.at(chunk).isEmpty()) {
+                writer.setPending(pendings.at(chunk));
+            }
+        }
+    } else {
+        for (auto &item : list) {
+            const V *value = messagePointer(item);
+            if (value == nullptr) {
+                qProtoWarning() << "Null pointer in list";
+                continue;
+            }
+            serializer->writeListObject(value, V::protobufMetaObject, metaProperty, writer);
         }
-        buffer.append(serializer->serializeListObject(value.data(), V::protobufMetaObject, metaProperty));
     }
-    buffer.append(serializer->serializeListEnd(buffer, metaProperty));
+    serializer->writeListEnd(metaProperty, writer);
+}
+
+/*!
+ * \private
+ * \brief default serializer template for list of type T objects inherited of QObject
+ */
+template<typename V,
+         typename std::enable_if_t<std::is_base_of<QObject, V>::value, int> = 0>
+void serializeList(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &listValue, const QtProtobuf::QProtobufMetaProperty &metaProperty, QtProtobuf::QProtobufWriter &writer) {
+    Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
+    writeListObjects<V>(serializer, listValue.value<QList<QSharedPointer<V>>>(), metaProperty, writer);
+}
+
+/*!
+ * \private
+ * \brief default serializer template for list of gadgets of type V
+ */
+template<typename V,
+         typename std::enable_if_t<!std::is_base_of<QObject, V>::value, int> = 0>
+void serializeList(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &listValue, const QtProtobuf::QProtobufMetaProperty &metaProperty, QtProtobuf::QProtobufWriter &writer) {
+    Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
+    writeListObjects<V>(serializer, listValue.value<QList<V>>(), metaProperty, writer);
+}
+
+/*!
+ * \private
+ * \brief default serializer template for contiguous vector of gadgets of type V, stored by value
+ */
+template<typename V>
+void serializeVector(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &listValue, const QtProtobuf::QProtobufMetaProperty &metaProperty, QtProtobuf::QProtobufWriter &writer) {
+    Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
+    writeListObjects<V>(serializer, listValue.value<QVector<V>>(), metaProperty, writer);
 }
 
 /*!
  * \private
- * \brief default serializer template for map of key K, value V
+ * \brief default serializer template for map of key K, value V, stored in Map container, QMap or QHash
  */
-template<typename K, typename V,
+template<typename K, typename V, template<typename, typename> class Map = QMap,
          typename std::enable_if_t<!std::is_base_of<QObject, V>::value, int> = 0>
-void serializeMap(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &value, const QtProtobuf::QProtobufMetaProperty &metaProperty, QByteArray &buffer) {
+void serializeMap(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &value, const QtProtobuf::QProtobufMetaProperty &metaProperty, QtProtobuf::QProtobufWriter &writer) {
     Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
-    QMap<K,V> mapValue = value.value<QMap<K,V>>();
-    buffer.append(serializer->serializeMapBegin(metaProperty));
+    Map<K,V> mapValue = value.value<Map<K,V>>();
+    serializer->writeMapBegin(metaProperty, writer);
     for (auto it = mapValue.constBegin(); it != mapValue.constEnd(); it++) {
-        buffer.append(serializer->serializeMapPair(QVariant::fromValue<K>(it.key()), QVariant::fromValue<V>(it.value()), metaProperty));
+        serializer->writeMapPair(QVariant::fromValue<K>(it.key()), QVariant::fromValue<V>(it.value()), metaProperty, writer);
     }
-    buffer.append(serializer->serializeMapEnd(buffer, metaProperty));
+    serializer->writeMapEnd(metaProperty, writer);
 }
 
 /*!
  * \private
- * \brief default serializer template for map of type key K, value V. Specialization for V inherited of QObject
+ * \brief default serializer template for map of type key K, value V, stored in Map container. Specialization for V
+ *        inherited of QObject
  */
-template<typename K, typename V,
+template<typename K, typename V, template<typename, typename> class Map = QMap,
          typename std::enable_if_t<std::is_base_of<QObject, V>::value, int> = 0>
-void serializeMap(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &value, const QtProtobuf::QProtobufMetaProperty &metaProperty, QByteArray &buffer) {
+void serializeMap(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &value, const QtProtobuf::QProtobufMetaProperty &metaProperty, QtProtobuf::QProtobufWriter &writer) {
     Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
-    QMap<K, QSharedPointer<V>> mapValue = value.value<QMap<K, QSharedPointer<V>>>();
-    buffer.append(serializer->serializeMapBegin(metaProperty));
+    Map<K, QSharedPointer<V>> mapValue = value.value<Map<K, QSharedPointer<V>>>();
+    serializer->writeMapBegin(metaProperty, writer);
     for (auto it = mapValue.constBegin(); it != mapValue.constEnd(); it++) {
         if (it.value().isNull()) {
             qProtoWarning() << __func__ << "Trying to serialize map value that contains nullptr";
             continue;
         }
-        buffer.append(serializer->serializeMapPair(QVariant::fromValue<K>(it.key()), QVariant::fromValue<V *>(it.value().data()), metaProperty));
+        serializer->writeMapPair(QVariant::fromValue<K>(it.key()), QVariant::fromValue<V *>(it.value().data()), metaProperty, writer);
     }
-    buffer.append(serializer->serializeMapEnd(buffer, metaProperty));
+    serializer->writeMapEnd(metaProperty, writer);
 }
 
 /*!
@@ -147,9 +275,9 @@ void serializeMap(const QtProtobuf::QAbstractProtobufSerializer *serializer, con
  */
 template<typename T,
          typename std::enable_if_t<std::is_enum<T>::value, int> = 0>
-void serializeEnum(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &value, const QtProtobuf::QProtobufMetaProperty &metaProperty, QByteArray &buffer) {
+void serializeEnum(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &value, const QtProtobuf::QProtobufMetaProperty &metaProperty, QtProtobuf::QProtobufWriter &writer) {
     Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
-    buffer.append(serializer->serializeEnum(QtProtobuf::int64(value.value<T>()), QMetaEnum::fromType<T>(),  metaProperty));
+    serializer->writeEnum(QtProtobuf::int64(value.value<T>()), QMetaEnum::fromType<T>(), metaProperty, writer);
 }
 
 /*!
@@ -158,13 +286,61 @@ void serializeEnum(const QtProtobuf::QAbstractProtobufSerializer *serializer, co
  */
 template<typename T,
          typename std::enable_if_t<std::is_enum<T>::value, int> = 0>
-void serializeEnumList(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &value, const QtProtobuf::QProtobufMetaProperty &metaProperty, QByteArray &buffer) {
+void serializeEnumList(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &value, const QtProtobuf::QProtobufMetaProperty &metaProperty, QtProtobuf::QProtobufWriter &writer) {
     Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
     QList<QtProtobuf::int64> intList;
     for (auto enumValue : value.value<QList<T>>()) {
         intList.append(QtProtobuf::int64(enumValue));
     }
-    buffer.append(serializer->serializeEnumList(intList, QMetaEnum::fromType<T>(), metaProperty));
+    serializer->writeEnumList(intList, QMetaEnum::fromType<T>(), metaProperty, writer);
+}
+
+/*!
+ * \private
+ * \brief default objects iterator template for type T inherited of QObject
+ */
+template <typename T,
+          typename std::enable_if_t<std::is_base_of<QObject, T>::value, int> = 0>
+void iterateObject(const QVariant &value, const ObjectVisitor &visitor) {
+    const T *object = value.value<T *>();
+    if (object != nullptr) {
+        visitor(QVariant(), static_cast<const QObject *>(object), T::protobufMetaObject);
+    }
+}
+
+/*!
+ * \private
+ * \brief default objects iterator template for list of type T objects inherited of QObject
+ */
+template<typename V,
+         typename std::enable_if_t<std::is_base_of<QObject, V>::value, int> = 0>
+void iterateList(const QVariant &listValue, const ObjectVisitor &visitor) {
+    QList<QSharedPointer<V>> list = listValue.value<QList<QSharedPointer<V>>>();
+    for (auto &value : list) {
+        if (!value) {
+            qProtoWarning() << "Null pointer in list";
+            continue;
+        }
+        visitor(QVariant(), static_cast<const QObject *>(value.data()), V::protobufMetaObject);
+    }
+}
+
+/*!
+ * \private
+ * \brief default objects iterator template for map of type key K, value V inherited of QObject, stored in
+ *        Map container
+ */
+template<typename K, typename V, template<typename, typename> class Map = QMap,
+         typename std::enable_if_t<std::is_base_of<QObject, V>::value, int> = 0>
+void iterateMap(const QVariant &value, const ObjectVisitor &visitor) {
+    Map<K, QSharedPointer<V>> mapValue = value.value<Map<K, QSharedPointer<V>>>();
+    for (auto it = mapValue.constBegin(); it != mapValue.constEnd(); it++) {
+        if (it.value().isNull()) {
+            qProtoWarning() << __func__ << "Trying to serialize map value that contains nullptr";
+            continue;
+        }
+        visitor(QVariant::fromValue<K>(it.key()), static_cast<const QObject *>(it.value().data()), V::protobufMetaObject);
+    }
 }
 
 /*!
@@ -198,46 +374,194 @@ void deserializeList(const QtProtobuf::QAbstractProtobufSerializer *serializer,
     }
 }
 
+/*!
+ * \private
+ * \brief default list deserializer template for list of type T objects inherited of QObject. If number of
+ *        \a elements reaches parallelListThreshold, elements are deserialized in parallel
+ */
+template <typename V,
+          typename std::enable_if_t<std::is_base_of<QObject, V>::value, int> = 0>
+void deserializeListElements(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVector<QByteArray> &elements, QVariant &previous) {
+    Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
+    qProtoDebug() << __func__ << "elements.count" << elements.count();
+
+    QVector<QSharedPointer<V>> objects(elements.count());
+    QSharedPointer<V> *objectsData = objects.data();
+    const int threshold = serializer->parallelListThreshold();
+    if (threshold > 0 && elements.count() >= threshold) {
+        QThread *thread = QThread::currentThread();
+        runParallel(elements.count(), [serializer, &elements, objectsData, thread](int index) {
+            QSharedPointer<V> object(new V);
+            serializer->deserializeMessage(object.data(), V::protobufMetaObject, elements.at(index));
+            moveMessageToThread(object.data(), V::protobufMetaObject, thread);
+            objectsData[index] = object;
+        }, nullptr);
+    } else {
+        for (int i = 0; i < elements.count(); i++) {
+            objectsData[i] = QSharedPointer<V>(new V);
+            serializer->deserializeMessage(objectsData[i].data(), V::protobufMetaObject, elements.at(i));
+        }
+    }
+
+    QList<QSharedPointer<V>> list = previous.value<QList<QSharedPointer<V>>>();
+    list.reserve(list.count() + objects.count());
+    for (const auto &object : objects) {
+        list.append(object);
+    }
+    previous.setValue(list);
+}
+
+/*!
+ * \private
+ * \brief default deserializer template for gadget type T
+ */
+template <typename T,
+          typename std::enable_if_t<!std::is_base_of<QObject, T>::value, int> = 0>
+void deserializeObject(const QtProtobuf::QAbstractProtobufSerializer *serializer, QtProtobuf::QProtobufSelfcheckIterator &it, QVariant &to) {
+    Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
+    T value;
+    serializer->deserializeObject(&value, T::protobufMetaObject, it);
+    to = QVariant::fromValue<T>(value);
+}
+
+/*!
+ * \private
+ * \brief default deserializer template for list of gadgets of type V
+ */
+template <typename V,
+          typename std::enable_if_t<!std::is_base_of<QObject, V>::value, int> = 0>
+void deserializeList(const QtProtobuf::QAbstractProtobufSerializer *serializer, QtProtobuf::QProtobufSelfcheckIterator &it, QVariant &previous) {
+    Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
+    qProtoDebug() << __func__ << "currentByte:" << QString::number((*it), 16);
+
+    V value;
+    if (serializer->deserializeListObject(&value, V::protobufMetaObject, it)) {
+        QList<V> list = previous.value<QList<V>>();
+        list.append(value);
+        previous.setValue(list);
+    }
+}
+
+/*!
+ * \private
+ * \brief default list deserializer template for list of gadgets of type V. If number of \a elements reaches
+ *        parallelListThreshold, elements are deserialized in parallel
+ */
+template <typename V,
+          typename std::enable_if_t<!std::is_base_of<QObject, V>::value, int> = 0>
+void deserializeListElements(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVector<QByteArray> &elements, QVariant &previous) {
+    Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
+    qProtoDebug() << __func__ << "elements.count" << elements.count();
+
+    QVector<V> values(elements.count());
+    V *valuesData = values.data();
+    const int threshold = serializer->parallelListThreshold();
+    if (threshold > 0 && elements.count() >= threshold) {
+        runParallel(elements.count(), [serializer, &elements, valuesData](int index) {
+            serializer->deserializeMessage(&valuesData[index], V::protobufMetaObject, elements.at(index));
+        }, nullptr);
+    } else {
+        for (int i = 0; i < elements.count(); i++) {
+            serializer->deserializeMessage(&valuesData[i], V::protobufMetaObject, elements.at(i));
+        }
+    }
+
+    QList<V> list = previous.value<QList<V>>();
+    list.reserve(list.count() + values.count());
+    for (const auto &value : values) {
+        list.append(value);
+    }
+    previous.setValue(list);
+}
+
+/*!
+ * \private
+ * \brief default deserializer template for contiguous vector of gadgets of type V, stored by value
+ */
+template <typename V>
+void deserializeVector(const QtProtobuf::QAbstractProtobufSerializer *serializer, QtProtobuf::QProtobufSelfcheckIterator &it, QVariant &previous) {
+    Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
+    qProtoDebug() << __func__ << "currentByte:" << QString::number((*it), 16);
+
+    QVector<V> list = previous.value<QVector<V>>();
+    list.append(V());
+    if (serializer->deserializeListObject(&list.last(), V::protobufMetaObject, it)) {
+        previous.setValue(list);
+    }
+}
+
+/*!
+ * \private
+ * \brief default list deserializer template for contiguous vector of gadgets of type V. Elements are
+ *        deserialized in place, in parallel if number of \a elements reaches parallelListThreshold
+ */
+template <typename V>
+void deserializeVectorElements(const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVector<QByteArray> &elements, QVariant &previous) {
+    Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
+    qProtoDebug() << __func__ << "elements.count" << elements.count();
+
+    QVector<V> list = previous.value<QVector<V>>();
+    const int offset = list.count();
+    list.resize(offset + elements.count());
+    V *valuesData = list.data() + offset;
+    const int threshold = serializer->parallelListThreshold();
+    if (threshold > 0 && elements.count() >= threshold) {
+        //Gadgets have no thread affinity, so they are not moved to thread of caller
+        runParallel(elements.count(), [serializer, &elements, valuesData](int index) {
+            serializer->deserializeMessage(&valuesData[index], V::protobufMetaObject, elements.at(index));
+        }, nullptr);
+    } else {
+        for (int i = 0; i < elements.count(); i++) {
+            serializer->deserializeMessage(&valuesData[i], V::protobufMetaObject, elements.at(i));
+        }
+    }
+    previous.setValue(list);
+}
+
 /*!
  * \private
  *
- * \brief default deserializer template for map of key K, value V
+ * \brief default deserializer template for map of key K, value V, stored in Map container
+ * \details Map is taken out of \a previous before insertion, so it is not detached by reference that is held by
+ *          \a previous itself
  */
-template <typename K, typename V,
+template <typename K, typename V, template<typename, typename> class Map = QMap,
           typename std::enable_if_t<!std::is_base_of<QObject, V>::value, int> = 0>
 void deserializeMap(const QtProtobuf::QAbstractProtobufSerializer *serializer, QtProtobuf::QProtobufSelfcheckIterator &it, QVariant &previous) {
     Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
     qProtoDebug() << __func__ << "currentByte:" << QString::number((*it), 16);
 
-    QMap<K, V> out = previous.value<QMap<K, V>>();
     QVariant key = QVariant::fromValue<K>(K());
     QVariant value = QVariant::fromValue<V>(V());
 
     if (serializer->deserializeMapPair(key, value, it)) {
-        out[key.value<K>()] = value.value<V>();
-        previous = QVariant::fromValue<QMap<K, V>>(out);
+        Map<K, V> out = previous.value<Map<K, V>>();
+        previous.clear();
+        out.insert(key.value<K>(), value.value<V>());
+        previous = QVariant::fromValue<Map<K, V>>(out);
     }
 }
 
 /*!
  * \private
  *
- * \brief default deserializer template for map of type key K, value V. Specialization for V
- *        inherited of QObject
+ * \brief default deserializer template for map of type key K, value V, stored in Map container. Specialization
+ *        for V inherited of QObject
  */
-template <typename K, typename V,
+template <typename K, typename V, template<typename, typename> class Map = QMap,
           typename std::enable_if_t<std::is_base_of<QObject, V>::value, int> = 0>
 void deserializeMap(const QtProtobuf::QAbstractProtobufSerializer *serializer, QtProtobuf::QProtobufSelfcheckIterator &it, QVariant &previous) {
     Q_ASSERT_X(serializer != nullptr, "QAbstractProtobufSerializer", "Serializer is null");
     qProtoDebug() << __func__ << "currentByte:" << QString::number((*it), 16);
 
-    auto out = previous.value<QMap<K, QSharedPointer<V>>>();
     QVariant key = QVariant::fromValue<K>(K());
     QVariant value = QVariant::fromValue<V *>(nullptr);
 
     if (serializer->deserializeMapPair(key, value, it)) {
-        out[key.value<K>()] = QSharedPointer<V>(value.value<V *>());
-        previous = QVariant::fromValue<QMap<K, QSharedPointer<V>>>(out);
+        auto out = previous.value<Map<K, QSharedPointer<V>>>();
+        previous.clear();
+        out.insert(key.value<K>(), QSharedPointer<V>(value.value<V *>()));
+        previous = QVariant::fromValue<Map<K, QSharedPointer<V>>>(out);
     }
 }
 
@@ -272,4 +596,125 @@ void deserializeEnumList(const QtProtobuf::QAbstractProtobufSerializer *serializ
     }
     previous = QVariant::fromValue<QList<T>>(enumList);
 }
+
+/*!
+ * \private
+ * \brief MessageTypeInfo is constant table, that describes message type for shared handlers of messages
+ *        generated with COMPACT option
+ * \details Shared handlers are not instantiated per message type. Only table functions depend on message type,
+ *          they access message and list values, that are stored in QVariant, without conversions.
+ */
+struct MessageTypeInfo {
+    const QtProtobuf::QProtobufMetaObject *metaObject;/*!< meta object of message */
+    void *(*create)();/*!< creates message inherited of QObject, nullptr for gadget messages */
+    int (*listCount)(const QVariant &list);/*!< returns number of messages in repeated field value */
+    const void *(*listAt)(const QVariant &list, int index);/*!< returns message of repeated field value at index */
+    void *(*listElement)(QVariant &list, int index);/*!< returns detached message of repeated field value at index */
+    void (*listResize)(QVariant &list, int count);/*!< appends default messages to or removes last messages of repeated field value */
+};
+
+extern Q_PROTOBUF_EXPORT void registerCompactMessageHandlers(const MessageTypeInfo *typeInfo, int objectType, int listType);
+
+/*!
+ * \private
+ * \brief MessageStorage describes types of property values, that store gadget message T
+ */
+template <typename T, typename = void>
+struct MessageStorage {
+    using Object = T;
+    using List = QList<T>;
+};
+
+/*!
+ * \private
+ * \brief MessageStorage describes types of property values, that store message T inherited of QObject
+ */
+template <typename T>
+struct MessageStorage<T, std::enable_if_t<std::is_base_of<QObject, T>::value>> {
+    using Object = T *;
+    using List = QList<QSharedPointer<T>>;
+};
+
+//! \private
+template <typename T>
+void *createMessage() { return static_cast<QObject *>(new T); }
+
+/*!
+ * \private
+ * \brief Returns type-erased address of message, address of message inherited of QObject is address of QObject
+ */
+inline const void *messageAddress(const QObject *object) { return object; }
+
+//! \private
+inline const void *messageAddress(const void *object) { return object; }
+
+//! \private
+template <typename L>
+int messageListCount(const QVariant &list) { return static_cast<const L *>(list.constData())->count(); }
+
+//! \private
+template <typename L>
+const void *messageListAt(const QVariant &list, int index) {
+    return messageAddress(messagePointer(static_cast<const L *>(list.constData())->at(index)));
+}
+
+//! \private
+template <typename L>
+void *messageListElement(QVariant &list, int index) {
+    return const_cast<void *>(messageAddress(messagePointer((*static_cast<L *>(list.data()))[index])));
+}
+
+//! \private
+template <typename V,
+          typename std::enable_if_t<std::is_base_of<QObject, V>::value, int> = 0>
+void messageListResize(QVariant &list, int count) {
+    auto &values = *static_cast<QList<QSharedPointer<V>> *>(list.data());
+    values.reserve(count);
+    while (values.count() > count) {
+        values.removeLast();
+    }
+    while (values.count() < count) {
+        values.append(QSharedPointer<V>(new V));
+    }
+}
+
+//! \private
+template <typename V,
+          typename std::enable_if_t<!std::is_base_of<QObject, V>::value, int> = 0>
+void messageListResize(QVariant &list, int count) {
+    auto &values = *static_cast<QList<V> *>(list.data());
+    values.reserve(count);
+    while (values.count() > count) {
+        values.removeLast();
+    }
+    while (values.count() < count) {
+        values.append(V());
+    }
+}
+
+/*!
+ * \private
+ * \brief Returns type table of message type T inherited of QObject. Message is stored in properties as T* and
+ *        in repeated properties as QList<QSharedPointer<T>>
+ */
+template <typename T,
+          typename std::enable_if_t<std::is_base_of<QObject, T>::value, int> = 0>
+constexpr MessageTypeInfo messageTypeInfo() {
+    using List = typename MessageStorage<T>::List;
+    return { &T::protobufMetaObject, createMessage<T>, messageListCount<List>, messageListAt<List>,
+             messageListElement<List>, messageListResize<T> };
+}
+
+/*!
+ * \private
+ * \brief Returns type table of gadget message type T. Message is stored in properties by value and in repeated
+ *        properties as QList<T>
+ */
+template <typename T,
+          typename std::enable_if_t<!std::is_base_of<QObject, T>::value, int> = 0>
+constexpr MessageTypeInfo messageTypeInfo() {
+    using List = typename MessageStorage<T>::List;
+    return { &T::protobufMetaObject, nullptr, messageListCount<List>, messageListAt<List>,
+             messageListElement<List>, messageListResize<T> };
+}
 }
@@ -0,0 +1,140 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "qabstractprotobufsinkserializer.h"
+
+using namespace QtProtobuf;
+
+QByteArray QAbstractProtobufSinkSerializer::serializeMessage(const void *object, const QProtobufMetaObject &metaObject) const
+{
+    QByteArray result;
+    QProtobufByteArrayWriter writer(result);
+    writeMessage(object, metaObject, writer);
+    writer.flushPending();
+    return result;
+}
+
+void QAbstractProtobufSinkSerializer::deserializeMessage(void *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const
+{
+    QProtobufSelfcheckIterator it(data);
+    readMessage(object, metaObject, it);
+}
+
+QByteArray QAbstractProtobufSinkSerializer::serializeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const
+{
+    QByteArray result;
+    QProtobufByteArrayWriter writer(result);
+    writeObject(object, metaObject, metaProperty, writer);
+    writer.flushPending();
+    return result;
+}
+
+QByteArray QAbstractProtobufSinkSerializer::serializeListBegin(const QProtobufMetaProperty &metaProperty) const
+{
+    QByteArray result;
+    QProtobufByteArrayWriter writer(result);
+    writeListBegin(metaProperty, writer);
+    writer.flushPending();
+    return result;
+}
+
+QByteArray QAbstractProtobufSinkSerializer::serializeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const
+{
+    QByteArray result;
+    QProtobufByteArrayWriter writer(result);
+    writeListObject(object, metaObject, metaProperty, writer);
+    writer.flushPending();
+    return result;
+}
+
+QByteArray QAbstractProtobufSinkSerializer::serializeListEnd(QByteArray &/*buffer*/, const QProtobufMetaProperty &metaProperty) const
+{
+    QByteArray result;
+    QProtobufByteArrayWriter writer(result);
+    writeListEnd(metaProperty, writer);
+    writer.flushPending();
+    return result;
+}
+
+QByteArray QAbstractProtobufSinkSerializer::serializeMapBegin(const QProtobufMetaProperty &metaProperty) const
+{
+    QByteArray result;
+    QProtobufByteArrayWriter writer(result);
+    writeMapBegin(metaProperty, writer);
+    writer.flushPending();
+    return result;
+}
+
+QByteArray QAbstractProtobufSinkSerializer::serializeMapPair(const QVariant &key, const QVariant &value, const QProtobufMetaProperty &metaProperty) const
+{
+    QByteArray result;
+    QProtobufByteArrayWriter writer(result);
+    writeMapPair(key, value, metaProperty, writer);
+    writer.flushPending();
+    return result;
+}
+
+QByteArray QAbstractProtobufSinkSerializer::serializeMapEnd(QByteArray &/*buffer*/, const QProtobufMetaProperty &metaProperty) const
+{
+    QByteArray result;
+    QProtobufByteArrayWriter writer(result);
+    writeMapEnd(metaProperty, writer);
+    writer.flushPending();
+    return result;
+}
+
+QByteArray QAbstractProtobufSinkSerializer::serializeEnum(int64 value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &metaProperty) const
+{
+    QByteArray result;
+    QProtobufByteArrayWriter writer(result);
+    writeEnum(value, metaEnum, metaProperty, writer);
+    writer.flushPending();
+    return result;
+}
+
+QByteArray QAbstractProtobufSinkSerializer::serializeEnumList(const QList<int64> &value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &metaProperty) const
+{
+    QByteArray result;
+    QProtobufByteArrayWriter writer(result);
+    writeEnumList(value, metaEnum, metaProperty, writer);
+    writer.flushPending();
+    return result;
+}
+
+void QAbstractProtobufSinkSerializer::writeListBegin(const QProtobufMetaProperty &/*metaProperty*/, QProtobufWriter &/*writer*/) const
+{
+}
+
+void QAbstractProtobufSinkSerializer::writeListEnd(const QProtobufMetaProperty &/*metaProperty*/, QProtobufWriter &/*writer*/) const
+{
+}
+
+void QAbstractProtobufSinkSerializer::writeMapBegin(const QProtobufMetaProperty &/*metaProperty*/, QProtobufWriter &/*writer*/) const
+{
+}
+
+void QAbstractProtobufSinkSerializer::writeMapEnd(const QProtobufMetaProperty &/*metaProperty*/, QProtobufWriter &/*writer*/) const
+{
+}
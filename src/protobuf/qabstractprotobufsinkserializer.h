@@ -0,0 +1,94 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once //QAbstractProtobufSinkSerializer
+
+#include "qabstractprotobufserializer.h"
+#include "qtprotobufglobal.h"
+
+namespace QtProtobuf {
+
+/*!
+ * \ingroup QtProtobuf
+ * \brief The QAbstractProtobufSinkSerializer class is base class for serializers that write serialized data
+ *        to sink and read serialized data using cursor
+ *
+ * \details Unlike QAbstractProtobufSerializer, that requires to return serialized data of each message part
+ *          as QByteArray, inherited classes receive QProtobufWriter and write encoded bytes directly to the
+ *          destination, both when message is serialized to QByteArray and to QIODevice. Deserialization starts
+ *          from readMessage(), that receives cursor that points to serialized message.
+ *          QByteArray based methods of QAbstractProtobufSerializer are implemented on top of write family methods,
+ *          so serializers inherited of QAbstractProtobufSinkSerializer are usable everywhere serializer is expected.
+ *          Serializers of this kind are provided by plugins via QProtobufSinkSerializationPluginInterface.
+ *
+ *          Nested message fields are serialized by calling serializer of QtProtobufPrivate::SerializationHandler
+ *          registered for property type with the same \a writer, that in turn calls writeObject(), writeListObject() and
+ *          writeMapPair() of serializer.
+ *
+ *          Separators between list elements or map pairs should be kept pending in writer, see
+ *          QProtobufWriter::setPending(), so writeListEnd() and writeMapEnd() drop the last one with
+ *          QProtobufWriter::takePending() for any kind of sink.
+ */
+class Q_PROTOBUF_EXPORT QAbstractProtobufSinkSerializer : public QAbstractProtobufSerializer
+{
+public:
+    QByteArray serializeMessage(const void *object, const QProtobufMetaObject &metaObject) const final;
+    void deserializeMessage(void *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const final;
+
+    QByteArray serializeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const final;
+
+    QByteArray serializeListBegin(const QProtobufMetaProperty &metaProperty) const final;
+    QByteArray serializeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const final;
+    QByteArray serializeListEnd(QByteArray &buffer, const QProtobufMetaProperty &metaProperty) const final;
+
+    QByteArray serializeMapBegin(const QProtobufMetaProperty &metaProperty) const final;
+    QByteArray serializeMapPair(const QVariant &key, const QVariant &value, const QProtobufMetaProperty &metaProperty) const final;
+    QByteArray serializeMapEnd(QByteArray &buffer, const QProtobufMetaProperty &metaProperty) const final;
+
+    QByteArray serializeEnum(int64 value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &metaProperty) const final;
+    QByteArray serializeEnumList(const QList<int64> &value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &metaProperty) const final;
+
+    /*!
+     * \brief readMessage Deserializes \a object according given \a metaObject from serialized data pointed by \a it
+     * \details Implementation should read complete message and leave \a it after the last byte of the message
+     */
+    virtual void readMessage(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const = 0;
+
+    void writeMessage(const void *object, const QProtobufMetaObject &metaObject, QProtobufWriter &writer) const override = 0;
+    void writeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override = 0;
+
+    void writeListBegin(const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
+    void writeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override = 0;
+    void writeListEnd(const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
+
+    void writeMapBegin(const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
+    void writeMapPair(const QVariant &key, const QVariant &value, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override = 0;
+    void writeMapEnd(const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
+
+    void writeEnum(int64 value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override = 0;
+    void writeEnumList(const QList<int64> &value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override = 0;
+};
+
+}
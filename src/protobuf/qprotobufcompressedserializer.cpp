@@ -0,0 +1,166 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "qprotobufcompressedserializer.h"
+#include "qprotobufserializer.h"
+
+using namespace QtProtobuf;
+
+namespace {
+enum BlockFormat : char {
+    StoredBlock = 0x00,
+    DeflateBlock = 0x01
+};
+
+QByteArray compressBlock(QByteArray data, int level, int threshold)
+{
+    if (data.size() >= threshold && level != 0) {
+        QByteArray compressed = qCompress(data, level);
+        //Compressed data includes 4 bytes of uncompressed size, so small incompressible messages could grow
+        if (!compressed.isEmpty() && compressed.size() < data.size()) {
+            compressed.prepend(DeflateBlock);
+            return compressed;
+        }
+    }
+    data.prepend(StoredBlock);
+    return data;
+}
+
+QByteArray uncompressBlock(const QByteArray &data)
+{
+    if (data.isEmpty()) {
+        return data;
+    }
+
+    switch (data.at(0)) {
+    case StoredBlock:
+        //Stored block is referred without copying
+        return QByteArray::fromRawData(data.constData() + 1, data.size() - 1);
+    case DeflateBlock: {
+        QByteArray uncompressed = qUncompress(reinterpret_cast<const uchar *>(data.constData() + 1), data.size() - 1);
+        if (uncompressed.isEmpty()) {
+            throw std::invalid_argument("Compressed block is corrupted. Deserialization failed");
+        }
+        return uncompressed;
+    }
+    default:
+        throw std::invalid_argument("Unknown format of compressed block. Deserialization failed");
+    }
+}
+}
+
+constexpr int QProtobufCompressedSerializer::DefaultCompressionLevel;
+constexpr int QProtobufCompressedSerializer::DefaultCompressionThreshold;
+
+QProtobufCompressedSerializer::QProtobufCompressedSerializer(const std::shared_ptr<QAbstractProtobufSerializer> &serializer, int level, int threshold) : m_serializer(serializer)
+  , m_level(qBound(-1, level, 9))
+  , m_threshold(qMax(0, threshold))
+{
+    if (!m_serializer) {
+        m_serializer = std::make_shared<QProtobufSerializer>();
+    }
+}
+
+QProtobufCompressedSerializer::~QProtobufCompressedSerializer() = default;
+
+QByteArray QProtobufCompressedSerializer::serializeMessage(const void *object, const QProtobufMetaObject &metaObject) const
+{
+    return compressBlock(m_serializer->serializeMessage(object, metaObject), m_level, m_threshold);
+}
+
+void QProtobufCompressedSerializer::deserializeMessage(void *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const
+{
+    m_serializer->deserializeMessage(object, metaObject, uncompressBlock(data));
+}
+
+QByteArray QProtobufCompressedSerializer::serializeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const
+{
+    return m_serializer->serializeObject(object, metaObject, metaProperty);
+}
+
+void QProtobufCompressedSerializer::deserializeObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const
+{
+    m_serializer->deserializeObject(object, metaObject, it);
+}
+
+QByteArray QProtobufCompressedSerializer::serializeListBegin(const QProtobufMetaProperty &metaProperty) const
+{
+    return m_serializer->serializeListBegin(metaProperty);
+}
+
+QByteArray QProtobufCompressedSerializer::serializeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const
+{
+    return m_serializer->serializeListObject(object, metaObject, metaProperty);
+}
+
+QByteArray QProtobufCompressedSerializer::serializeListEnd(QByteArray &buffer, const QProtobufMetaProperty &metaProperty) const
+{
+    return m_serializer->serializeListEnd(buffer, metaProperty);
+}
+
+bool QProtobufCompressedSerializer::deserializeListObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const
+{
+    return m_serializer->deserializeListObject(object, metaObject, it);
+}
+
+QByteArray QProtobufCompressedSerializer::serializeMapBegin(const QProtobufMetaProperty &metaProperty) const
+{
+    return m_serializer->serializeMapBegin(metaProperty);
+}
+
+QByteArray QProtobufCompressedSerializer::serializeMapPair(const QVariant &key, const QVariant &value, const QProtobufMetaProperty &metaProperty) const
+{
+    return m_serializer->serializeMapPair(key, value, metaProperty);
+}
+
+QByteArray QProtobufCompressedSerializer::serializeMapEnd(QByteArray &buffer, const QProtobufMetaProperty &metaProperty) const
+{
+    return m_serializer->serializeMapEnd(buffer, metaProperty);
+}
+
+bool QProtobufCompressedSerializer::deserializeMapPair(QVariant &key, QVariant &value, QProtobufSelfcheckIterator &it) const
+{
+    return m_serializer->deserializeMapPair(key, value, it);
+}
+
+QByteArray QProtobufCompressedSerializer::serializeEnum(int64 value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &metaProperty) const
+{
+    return m_serializer->serializeEnum(value, metaEnum, metaProperty);
+}
+
+QByteArray QProtobufCompressedSerializer::serializeEnumList(const QList<int64> &value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &metaProperty) const
+{
+    return m_serializer->serializeEnumList(value, metaEnum, metaProperty);
+}
+
+void QProtobufCompressedSerializer::deserializeEnum(int64 &value, const QMetaEnum &metaEnum, QProtobufSelfcheckIterator &it) const
+{
+    m_serializer->deserializeEnum(value, metaEnum, it);
+}
+
+void QProtobufCompressedSerializer::deserializeEnumList(QList<int64> &value, const QMetaEnum &metaEnum, QProtobufSelfcheckIterator &it) const
+{
+    m_serializer->deserializeEnumList(value, metaEnum, it);
+}
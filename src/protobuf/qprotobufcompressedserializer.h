@@ -0,0 +1,121 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once //QProtobufCompressedSerializer
+
+#include "qabstractprotobufserializer.h"
+#include "qtprotobufglobal.h"
+
+namespace QtProtobuf {
+
+/*!
+ * \ingroup QtProtobuf
+ * \brief The QProtobufCompressedSerializer class compresses messages serialized by other serializer
+ *
+ * \details Message serialized by wrapped serializer is compressed using deflate algorithm and prefixed with one byte
+ *          that describes block format: 0x00 for stored data and 0x01 for compressed data, that is followed by 4 bytes
+ *          of uncompressed size in big endian order and zlib stream, same as qCompress produces.
+ *          Messages that are smaller than compression threshold, and messages that are not reduced by compression,
+ *          are stored as is. Empty data is deserialized as empty message.
+ *
+ *          Compressed serializers with preset levels are provided by "protobufcompression" serializer plugin:
+ *          \code{.cpp}
+ *          QString plugin = QProtobufSerializerRegistry::instance().loadPlugin("protobufcompression");
+ *          auto serializer = QProtobufSerializerRegistry::instance().getSerializer("protobuf", plugin);
+ *          \endcode
+ *          Serializer could be also created directly, e.g. with level and threshold specific for channel:
+ *          \code{.cpp}
+ *          auto serializer = std::make_shared<QProtobufCompressedSerializer>(nullptr, 9, 1024);
+ *          \endcode
+ *
+ *          Compression level and threshold should be configured before serializer is used by multiple threads.
+ *          Parallel processing of repeated fields is controlled by parallelListThreshold of wrapped serializer.
+ */
+class Q_PROTOBUF_EXPORT QProtobufCompressedSerializer : public QAbstractProtobufSerializer
+{
+public:
+    //! Compression level that is used by zlib by default
+    static constexpr int DefaultCompressionLevel = -1;
+    //! Messages smaller than 256 bytes are not compressed by default
+    static constexpr int DefaultCompressionThreshold = 256;
+
+    /*!
+     * \brief Constructs serializer that compresses output of \a serializer. QProtobufSerializer is used if
+     *        \a serializer is nullptr
+     * \param[in] level Compression level in range [0, 9], -1 selects default level of zlib
+     * \param[in] threshold Minimal size of serialized message in bytes, that is compressed
+     */
+    explicit QProtobufCompressedSerializer(const std::shared_ptr<QAbstractProtobufSerializer> &serializer = nullptr,
+                                           int level = DefaultCompressionLevel,
+                                           int threshold = DefaultCompressionThreshold);
+    ~QProtobufCompressedSerializer();
+
+    /*!
+     * \brief Sets compression \a level in range [0, 9], -1 selects default level of zlib
+     */
+    void setCompressionLevel(int level) { m_level = qBound(-1, level, 9); }
+    int compressionLevel() const { return m_level; }
+
+    /*!
+     * \brief Sets minimal size of serialized message in bytes, that is compressed
+     */
+    void setCompressionThreshold(int threshold) { m_threshold = qMax(0, threshold); }
+    int compressionThreshold() const { return m_threshold; }
+
+    /*!
+     * \brief Returns serializer, which output is compressed
+     */
+    std::shared_ptr<QAbstractProtobufSerializer> serializer() const { return m_serializer; }
+
+protected:
+    QByteArray serializeMessage(const void *object, const QProtobufMetaObject &metaObject) const override;
+    void deserializeMessage(void *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const override;
+
+    QByteArray serializeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const override;
+    void deserializeObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const override;
+
+    QByteArray serializeListBegin(const QProtobufMetaProperty &metaProperty) const override;
+    QByteArray serializeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const override;
+    QByteArray serializeListEnd(QByteArray &buffer, const QProtobufMetaProperty &metaProperty) const override;
+    bool deserializeListObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const override;
+
+    QByteArray serializeMapBegin(const QProtobufMetaProperty &metaProperty) const override;
+    QByteArray serializeMapPair(const QVariant &key, const QVariant &value, const QProtobufMetaProperty &metaProperty) const override;
+    QByteArray serializeMapEnd(QByteArray &buffer, const QProtobufMetaProperty &metaProperty) const override;
+    bool deserializeMapPair(QVariant &key, QVariant &value, QProtobufSelfcheckIterator &it) const override;
+
+    QByteArray serializeEnum(int64 value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &metaProperty) const override;
+    QByteArray serializeEnumList(const QList<int64> &value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &metaProperty) const override;
+
+    void deserializeEnum(int64 &value, const QMetaEnum &metaEnum, QProtobufSelfcheckIterator &it) const override;
+    void deserializeEnumList(QList<int64> &value, const QMetaEnum &metaEnum, QProtobufSelfcheckIterator &it) const override;
+
+private:
+    std::shared_ptr<QAbstractProtobufSerializer> m_serializer;
+    int m_level;
+    int m_threshold;
+};
+
+}
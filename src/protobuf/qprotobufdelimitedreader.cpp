@@ -0,0 +1,109 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "qprotobufdelimitedreader.h"
+#include "qprotobufsizeprefix_p.h"
+
+#include <stdexcept>
+
+using namespace QtProtobuf;
+
+QProtobufDelimitedReader::QProtobufDelimitedReader(QAbstractProtobufSerializer *serializer, QIODevice *device) : m_serializer(serializer)
+  , m_device(device)
+  , m_position(0)
+{
+    Q_ASSERT_X(serializer != nullptr, "QProtobufDelimitedReader", "Serializer is null");
+    Q_ASSERT_X(device != nullptr, "QProtobufDelimitedReader", "Device is null");
+}
+
+QProtobufDelimitedReader::QProtobufDelimitedReader(QAbstractProtobufSerializer *serializer, const QByteArray &data) : m_serializer(serializer)
+  , m_device(nullptr)
+  , m_data(data)
+  , m_position(0)
+{
+    Q_ASSERT_X(serializer != nullptr, "QProtobufDelimitedReader", "Serializer is null");
+}
+
+bool QProtobufDelimitedReader::readRecord(QByteArray &record)
+{
+    QProtobufSizePrefixDecoder prefix;
+    if (m_device == nullptr) {
+        if (m_position >= m_data.size()) {
+            return false;
+        }
+
+        int position = m_position;
+        do {
+            if (position >= m_data.size()) {
+                throw std::out_of_range("Record size is truncated. Reading of delimited message failed");
+            }
+        } while (!prefix.addByte(static_cast<uchar>(m_data.at(position++))));
+
+        if (prefix.size() > m_data.size() - position) {
+            throw std::out_of_range("Record is truncated. Reading of delimited message failed");
+        }
+        //m_data is kept unchanged while reader exists, so record could refer to it without copying
+        record = QByteArray::fromRawData(m_data.constData() + position, prefix.size());
+        m_position = position + prefix.size();
+        return true;
+    }
+
+    char byte = 0;
+    do {
+        if (readRawBytes(&byte, 1) != 1) {
+            if (prefix.length() == 0) {
+                return false;
+            }
+            throw std::out_of_range("Record size is truncated. Reading of delimited message failed");
+        }
+    } while (!prefix.addByte(static_cast<uchar>(byte)));
+
+    record.resize(prefix.size());
+    if (readRawBytes(record.data(), record.size()) != record.size()) {
+        throw std::out_of_range("Record is truncated. Reading of delimited message failed");
+    }
+    return true;
+}
+
+int QProtobufDelimitedReader::readRawBytes(char *data, int size)
+{
+    int count = 0;
+    while (count < size) {
+        qint64 read = m_device->read(data + count, size - count);
+        if (read < 0) {
+            break;
+        }
+
+        if (read == 0) {
+            //Sequential devices, like pipes or sockets, may receive rest of data later
+            if (!m_device->isSequential() || !m_device->waitForReadyRead(-1)) {
+                break;
+            }
+            continue;
+        }
+        count += static_cast<int>(read);
+    }
+    return count;
+}
@@ -0,0 +1,163 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once //QProtobufDelimitedReader
+
+#include <QByteArray>
+#include <QIODevice>
+
+#include <iterator>
+#include <memory>
+
+#include "qabstractprotobufserializer.h"
+#include "qtprotobufglobal.h"
+
+namespace QtProtobuf {
+
+template<typename T>
+class QProtobufDelimitedMessages;
+
+/*!
+ * \ingroup QtProtobuf
+ * \brief The QProtobufDelimitedReader class reads sequence of length-delimited messages
+ *
+ * \details Reads messages written by QProtobufDelimitedWriter or by writeDelimitedTo function of upstream protobuf
+ *          library. Messages are decoded lazily one by one. Truncated records cause std::out_of_range exception,
+ *          same as deserialization of truncated message. Size prefixes that exceed INT_MAX cause
+ *          std::invalid_argument exception.
+ *          \code{.cpp}
+ *          QFile file("records.bin");
+ *          file.open(QIODevice::ReadOnly);
+ *          QProtobufDelimitedReader reader(&serializer, &file);
+ *          for (const auto &message : reader.messages<MyMessage>()) {
+ *              ...
+ *          }
+ *          \endcode
+ * \see QProtobufDelimitedWriter
+ */
+class Q_PROTOBUF_EXPORT QProtobufDelimitedReader
+{
+    Q_DISABLE_COPY_MOVE(QProtobufDelimitedReader)
+public:
+    QProtobufDelimitedReader(QAbstractProtobufSerializer *serializer, QIODevice *device);
+    QProtobufDelimitedReader(QAbstractProtobufSerializer *serializer, const QByteArray &data);
+
+    /*!
+     * \brief Reads next serialized message from stream to \a record
+     * \details When reader is created for QByteArray, \a record refers to reader data without copying
+     * \return false if end of stream is reached
+     */
+    bool readRecord(QByteArray &record);
+
+    /*!
+     * \brief Reads and deserializes next message from stream to \a message
+     * \return false if end of stream is reached
+     */
+    template<typename T>
+    bool read(T *message) {
+        Q_ASSERT(message != nullptr);
+        if (!readRecord(m_record)) {
+            return false;
+        }
+        m_serializer->deserialize<T>(message, m_record);
+        return true;
+    }
+
+    /*!
+     * \brief Returns range of messages in stream, that could be used in range-based for loop
+     * \details Iterator holds single message, that is assigned with each next message in stream, so previous
+     *          values are overwritten when iterator is incremented. Every record is still deserialized to new
+     *          message object first, same as QAbstractProtobufSerializer::deserialize does, to reset fields
+     *          that are missing in record.
+     */
+    template<typename T>
+    QProtobufDelimitedMessages<T> messages() {
+        return QProtobufDelimitedMessages<T>(this);
+    }
+
+private:
+    int readRawBytes(char *data, int size);
+
+    QAbstractProtobufSerializer *m_serializer;
+    QIODevice *m_device;
+    QByteArray m_data;
+    int m_position;
+    QByteArray m_record;
+};
+
+/*!
+ * \ingroup QtProtobuf
+ * \brief The QProtobufDelimitedMessages class is input range over messages of QProtobufDelimitedReader
+ */
+template<typename T>
+class QProtobufDelimitedMessages
+{
+public:
+    /*!
+     * \brief The iterator class is input iterator, that decodes next message on increment
+     */
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+        iterator() : m_reader(nullptr) {}
+        iterator(QProtobufDelimitedReader *reader, const std::shared_ptr<T> &message) : m_reader(reader)
+          , m_message(message) {
+            ++(*this);
+        }
+
+        reference operator *() const { return *m_message; }
+        pointer operator ->() const { return m_message.get(); }
+
+        iterator &operator ++() {
+            if (!m_reader->read(m_message.get())) {
+                m_reader = nullptr;
+            }
+            return *this;
+        }
+
+        bool operator ==(const iterator &other) const { return m_reader == other.m_reader; }
+        bool operator !=(const iterator &other) const { return m_reader != other.m_reader; }
+
+    private:
+        QProtobufDelimitedReader *m_reader;
+        std::shared_ptr<T> m_message;
+    };
+
+    explicit QProtobufDelimitedMessages(QProtobufDelimitedReader *reader) : m_reader(reader) {}
+
+    iterator begin() { return iterator(m_reader, std::make_shared<T>()); }
+    iterator end() { return iterator(); }
+
+private:
+    QProtobufDelimitedReader *m_reader;
+};
+
+}
@@ -0,0 +1,87 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "qprotobufdelimitedwriter.h"
+#include "qprotobufserializer_p.h"
+
+using namespace QtProtobuf;
+
+namespace {
+const int FlushThreshold = 64 * 1024;
+}
+
+QProtobufDelimitedWriter::QProtobufDelimitedWriter(QAbstractProtobufSerializer *serializer, QIODevice *device) : m_serializer(serializer)
+  , m_device(device)
+  , m_data(nullptr)
+  , m_error(false)
+{
+    Q_ASSERT_X(serializer != nullptr, "QProtobufDelimitedWriter", "Serializer is null");
+    Q_ASSERT_X(device != nullptr, "QProtobufDelimitedWriter", "Device is null");
+    m_buffer.reserve(FlushThreshold);
+}
+
+QProtobufDelimitedWriter::QProtobufDelimitedWriter(QAbstractProtobufSerializer *serializer, QByteArray *data) : m_serializer(serializer)
+  , m_device(nullptr)
+  , m_data(data)
+  , m_error(false)
+{
+    Q_ASSERT_X(serializer != nullptr, "QProtobufDelimitedWriter", "Serializer is null");
+    Q_ASSERT_X(data != nullptr, "QProtobufDelimitedWriter", "Data is null");
+}
+
+QProtobufDelimitedWriter::~QProtobufDelimitedWriter()
+{
+    flush();
+}
+
+bool QProtobufDelimitedWriter::writeRecord(const QByteArray &data)
+{
+    if (m_error) {
+        return false;
+    }
+
+    QByteArray &buffer = m_data != nullptr ? *m_data : m_buffer;
+    buffer.append(QProtobufSerializerPrivate::serializeVarintCommon<uint32_t>(data.size()));
+    buffer.append(data);
+
+    if (m_device != nullptr && m_buffer.size() >= FlushThreshold) {
+        return flush();
+    }
+    return true;
+}
+
+bool QProtobufDelimitedWriter::flush()
+{
+    if (m_device == nullptr || m_buffer.isEmpty()) {
+        return !m_error;
+    }
+
+    if (!m_error) {
+        m_error = m_device->write(m_buffer) != m_buffer.size();
+    }
+    //Keep allocated capacity, buffer is reused for next messages
+    m_buffer.resize(0);
+    return !m_error;
+}
@@ -0,0 +1,97 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once //QProtobufDelimitedWriter
+
+#include <QByteArray>
+#include <QIODevice>
+
+#include "qabstractprotobufserializer.h"
+#include "qtprotobufglobal.h"
+
+namespace QtProtobuf {
+
+/*!
+ * \ingroup QtProtobuf
+ * \brief The QProtobufDelimitedWriter class writes sequence of length-delimited messages
+ *
+ * \details Each message is prefixed with varint encoded size of serialized message. Format is compatible
+ *          with writeDelimitedTo/parseDelimitedFrom functions of upstream protobuf library.
+ *          Written messages are collected in single buffer, that is flushed to device once it exceeds
+ *          flush threshold, when flush() is called or when writer is destroyed. If writer is created for
+ *          QByteArray, messages are appended to given byte array directly.
+ *          \code{.cpp}
+ *          QFile file("records.bin");
+ *          file.open(QIODevice::WriteOnly);
+ *          QProtobufDelimitedWriter writer(&serializer, &file);
+ *          for (const auto &message : messages) {
+ *              writer.write(message);
+ *          }
+ *          \endcode
+ * \see QProtobufDelimitedReader
+ */
+class Q_PROTOBUF_EXPORT QProtobufDelimitedWriter
+{
+    Q_DISABLE_COPY_MOVE(QProtobufDelimitedWriter)
+public:
+    QProtobufDelimitedWriter(QAbstractProtobufSerializer *serializer, QIODevice *device);
+    QProtobufDelimitedWriter(QAbstractProtobufSerializer *serializer, QByteArray *data);
+    ~QProtobufDelimitedWriter();
+
+    /*!
+     * \brief Serializes \a message and appends it with size prefix to stream
+     * \return false if previous flush to device failed
+     */
+    template<typename T>
+    bool write(const T &message) {
+        return writeRecord(m_serializer->serialize<T>(&message));
+    }
+
+    /*!
+     * \brief Appends already serialized message \a data with size prefix to stream
+     * \return false if previous flush to device failed
+     */
+    bool writeRecord(const QByteArray &data);
+
+    /*!
+     * \brief Writes collected messages to device
+     * \return true if all collected messages were written successfully
+     */
+    bool flush();
+
+    /*!
+     * \brief Returns true if writing to device failed
+     */
+    bool hasError() const { return m_error; }
+
+private:
+    QAbstractProtobufSerializer *m_serializer;
+    QIODevice *m_device;
+    QByteArray *m_data;
+    QByteArray m_buffer;
+    bool m_error;
+};
+
+}
@@ -0,0 +1,135 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once //QProtobufFieldPresence
+
+#include <QtGlobal>
+
+#include <initializer_list>
+
+namespace QtProtobuf {
+
+/*!
+ * \ingroup QtProtobuf
+ * \brief The QProtobufFieldPresence class is bitmap of fields, that are set in message with FieldCount fields
+ *
+ * \details Bit index is index of field in message declaration. Cleared bit means that field holds its
+ *          default value, set bit means that field was assigned. Fields with implicit presence are marked as
+ *          set only while they hold non-default value. Fields with explicit presence, like
+ *          proto3 optional fields, are serialized only if their bit is set, even if value is default.
+ *          Is part of autogenerated classes.
+ */
+template<int FieldCount>
+class QProtobufFieldPresence
+{
+    static_assert(FieldCount > 0, "Field presence bitmap is not used for messages without fields");
+public:
+    enum {
+        WordCount = (FieldCount + 31) / 32
+    };
+
+    QProtobufFieldPresence() : m_bits{} {}
+    /*!
+     * \brief Initializes bitmap with \a words, that are set starting from the lowest field indexes
+     */
+    QProtobufFieldPresence(std::initializer_list<quint32> words) : m_bits{} {
+        int i = 0;
+        for (quint32 word : words) {
+            if (i >= WordCount) {
+                break;
+            }
+            m_bits[i++] = word;
+        }
+    }
+
+    /*!
+     * \brief Returns true if field with \a index is set
+     */
+    bool test(int index) const { return (m_bits[index >> 5] & (1u << (index & 31))) != 0; }
+
+    /*!
+     * \brief Marks field with \a index as set
+     */
+    void set(int index) { m_bits[index >> 5] |= 1u << (index & 31); }
+
+    /*!
+     * \brief Marks field with \a index as holding default value
+     */
+    void clear(int index) { m_bits[index >> 5] &= ~(1u << (index & 31)); }
+
+    /*!
+     * \brief Marks field with \a index as set if \a value differs from default value of type T and as holding
+     *        default value otherwise. Is used by setters of fields with implicit presence
+     */
+    template<typename T>
+    void update(int index, const T &value) {
+        if (value == T()) {
+            clear(index);
+        } else {
+            set(index);
+        }
+    }
+
+    /*!
+     * \brief Marks field with \a index as set and other fields of oneof as holding default value. Fields of oneof
+     *        are declared consecutively, starting from field with \a first index
+     */
+    void setOneof(int index, int first, int count) {
+        clearOneof(first, count);
+        set(index);
+    }
+
+    /*!
+     * \brief Marks \a count fields of oneof, starting from field with \a first index, as holding default value
+     */
+    void clearOneof(int first, int count) {
+        for (int i = first; i < first + count; i++) {
+            clear(i);
+        }
+    }
+
+    /*!
+     * \brief Returns bitmap words, that are used by serializers to iterate set fields only
+     */
+    const quint32 *data() const { return m_bits; }
+
+private:
+    quint32 m_bits[WordCount];
+};
+
+/*!
+ * \ingroup QtProtobuf
+ * \private
+ * \brief The QProtobufFieldPresenceInfo struct describes presence bitmap of message type for serializers
+ */
+struct QProtobufFieldPresenceInfo
+{
+    const quint32 *(*bits)(const void *object);/*!< returns presence bitmap of message object */
+    const int *fieldNumbers;/*!< protobuf field numbers in field declaration order */
+    const quint32 *explicitPresence;/*!< bitmap of fields, that are serialized when set to default value */
+    int fieldCount;
+};
+
+}
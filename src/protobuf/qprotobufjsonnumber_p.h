@@ -0,0 +1,284 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+#include <cfloat>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "qtprotobufglobal.h"
+
+namespace QtProtobuf {
+
+/*!
+ * \private
+ * \brief The QProtobufJsonNumber class formats and parses JSON numbers directly in character buffers
+ *
+ * \details Floating point values are formatted to the shortest representation, that is parsed back to the same
+ *          value. Parsing of integers and of floating point values, that have exact binary representation after
+ *          single rounding, doesn't allocate memory. Other values fall back to QByteArray conversions.
+ */
+class QProtobufJsonNumber
+{
+public:
+    //! Enough to keep any 64-bit integer with sign
+    static const int MaxIntegerLength = 20;
+    //! Enough to keep any double value in 'g' format with 17 significant digits
+    static const int MaxRealLength = 32;
+
+    /*!
+     * \brief Writes decimal digits of \a value right-aligned to \a end
+     * \return pointer to the first written character
+     */
+    static char *formatUnsigned(quint64 value, char *end) {
+        static const char DigitPairs[] =
+                "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                "8081828384858687888990919293949596979899";
+        while (value >= 100) {
+            const unsigned pair = static_cast<unsigned>(value % 100) * 2;
+            value /= 100;
+            *(--end) = DigitPairs[pair + 1];
+            *(--end) = DigitPairs[pair];
+        }
+        if (value >= 10) {
+            const unsigned pair = static_cast<unsigned>(value) * 2;
+            *(--end) = DigitPairs[pair + 1];
+            *(--end) = DigitPairs[pair];
+        } else {
+            *(--end) = static_cast<char>('0' + value);
+        }
+        return end;
+    }
+
+    static char *formatInteger(qint64 value, char *end) {
+        //Magnitude is calculated in unsigned type, to keep minimal 64-bit value valid
+        char *begin = formatUnsigned(value < 0 ? 0 - static_cast<quint64>(value) : static_cast<quint64>(value), end);
+        if (value < 0) {
+            *(--begin) = '-';
+        }
+        return begin;
+    }
+
+    /*!
+     * \brief Writes shortest representation of finite \a value, that is parsed back to the same float value,
+     *        to \a buffer of MaxRealLength size
+     * \return number of written characters
+     */
+    static int formatFloat(float value, char *buffer) {
+        //Any decimal with FLT_DIG digits is restored exactly, so the first precision that round-trips is the shortest
+        for (int precision = FLT_DIG; precision < 9; precision++) {
+            std::snprintf(buffer, MaxRealLength, "%.*g", precision, static_cast<double>(value));
+            if (std::strtof(buffer, nullptr) == value) {
+                return normalize(buffer);
+            }
+        }
+        std::snprintf(buffer, MaxRealLength, "%.9g", static_cast<double>(value));
+        return normalize(buffer);
+    }
+
+    /*!
+     * \brief Writes shortest representation of finite \a value, that is parsed back to the same double value,
+     *        to \a buffer of MaxRealLength size
+     * \return number of written characters
+     */
+    static int formatDouble(double value, char *buffer) {
+        for (int precision = DBL_DIG; precision < 17; precision++) {
+            std::snprintf(buffer, MaxRealLength, "%.*g", precision, value);
+            if (std::strtod(buffer, nullptr) == value) {
+                return normalize(buffer);
+            }
+        }
+        std::snprintf(buffer, MaxRealLength, "%.17g", value);
+        return normalize(buffer);
+    }
+
+    /*!
+     * \brief Parses decimal integer from \a size characters of \a data. Sets \a ok to false if text is not
+     *        an integer or value doesn't fit to 64-bit integer
+     */
+    static qint64 parseInteger(const char *data, int size, bool &ok) {
+        const bool negative = size > 0 && data[0] == '-';
+        const int offset = negative ? 1 : 0;
+        quint64 magnitude = 0;
+        if (!parseDigits(data + offset, size - offset, magnitude)) {
+            return QByteArray::fromRawData(data, size).toLongLong(&ok);
+        }
+
+        const quint64 limit = negative ? static_cast<quint64>(1) << 63 : (static_cast<quint64>(1) << 63) - 1;
+        ok = magnitude <= limit;
+        if (!ok) {
+            return 0;
+        }
+        return negative ? static_cast<qint64>(0 - magnitude) : static_cast<qint64>(magnitude);
+    }
+
+    static quint64 parseUnsigned(const char *data, int size, bool &ok) {
+        quint64 value = 0;
+        if (!parseDigits(data, size, value)) {
+            return QByteArray::fromRawData(data, size).toULongLong(&ok);
+        }
+        ok = true;
+        return value;
+    }
+
+    static double parseDouble(const char *data, int size, bool &ok) {
+        //Powers of ten, that are exactly representable as double
+        static const double Powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        bool negative = false;
+        quint64 mantissa = 0;
+        int exponent = 0;
+        //Mantissa and power of ten are exact, so result is rounded only once
+        if (parseDecimal(data, size, negative, mantissa, exponent)
+                && mantissa <= (static_cast<quint64>(1) << 53) && exponent >= -22 && exponent <= 22) {
+            ok = true;
+            const double value = exponent < 0 ? static_cast<double>(mantissa) / Powers[-exponent]
+                                              : static_cast<double>(mantissa) * Powers[exponent];
+            return negative ? -value : value;
+        }
+        return QByteArray::fromRawData(data, size).toDouble(&ok);
+    }
+
+    static float parseFloat(const char *data, int size, bool &ok) {
+        static const float Powers[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+        bool negative = false;
+        quint64 mantissa = 0;
+        int exponent = 0;
+        if (parseDecimal(data, size, negative, mantissa, exponent)
+                && mantissa <= (static_cast<quint64>(1) << 24) && exponent >= -10 && exponent <= 10) {
+            ok = true;
+            const float value = exponent < 0 ? static_cast<float>(mantissa) / Powers[-exponent]
+                                             : static_cast<float>(mantissa) * Powers[exponent];
+            return negative ? -value : value;
+        }
+        return QByteArray::fromRawData(data, size).toFloat(&ok);
+    }
+
+private:
+    //Output of printf functions uses decimal point of current C locale, JSON requires dot
+    static int normalize(char *buffer) {
+        int size = 0;
+        for (; buffer[size] != '\0'; size++) {
+            if (buffer[size] == ',') {
+                buffer[size] = '.';
+            }
+        }
+        return size;
+    }
+
+    //Parses non-empty sequence of digits, returns false if there are other characters or value overflows
+    static bool parseDigits(const char *data, int size, quint64 &value) {
+        if (size <= 0 || size > MaxIntegerLength) {
+            return false;
+        }
+        value = 0;
+        for (int i = 0; i < size; i++) {
+            const unsigned digit = static_cast<unsigned>(data[i] - '0');
+            if (digit > 9) {
+                return false;
+            }
+            if (value > (~static_cast<quint64>(0) - digit) / 10) {
+                return false;
+            }
+            value = value * 10 + digit;
+        }
+        return true;
+    }
+
+    /*!
+     * \brief Splits JSON number to \a mantissa and decimal \a exponent
+     * \return false if number is malformed or has more than 19 significant digits
+     */
+    static bool parseDecimal(const char *data, int size, bool &negative, quint64 &mantissa, int &exponent) {
+        const char *pos = data;
+        const char *end = data + size;
+        negative = pos < end && *pos == '-';
+        if (negative) {
+            ++pos;
+        }
+
+        int digits = 0;
+        mantissa = 0;
+        exponent = 0;
+        const char *mantissaBegin = pos;
+        for (; pos < end && *pos >= '0' && *pos <= '9'; ++pos) {
+            if (mantissa == 0 && *pos == '0') {
+                continue;//Leading zeros are not significant
+            }
+            mantissa = mantissa * 10 + static_cast<quint64>(*pos - '0');
+            if (++digits > 19) {
+                return false;
+            }
+        }
+        if (pos == mantissaBegin) {
+            return false;
+        }
+
+        if (pos < end && *pos == '.') {
+            const char *fractionBegin = ++pos;
+            for (; pos < end && *pos >= '0' && *pos <= '9'; ++pos) {
+                --exponent;
+                if (mantissa == 0 && *pos == '0') {
+                    continue;
+                }
+                mantissa = mantissa * 10 + static_cast<quint64>(*pos - '0');
+                if (++digits > 19) {
+                    return false;
+                }
+            }
+            if (pos == fractionBegin) {
+                return false;
+            }
+        }
+
+        if (pos < end && (*pos == 'e' || *pos == 'E')) {
+            ++pos;
+            const bool negativeExponent = pos < end && *pos == '-';
+            if (pos < end && (*pos == '-' || *pos == '+')) {
+                ++pos;
+            }
+            const char *exponentBegin = pos;
+            int value = 0;
+            for (; pos < end && *pos >= '0' && *pos <= '9'; ++pos) {
+                if (value > 1000) {
+                    return false;
+                }
+                value = value * 10 + (*pos - '0');
+            }
+            if (pos == exponentBegin) {
+                return false;
+            }
+            exponent += negativeExponent ? -value : value;
+        }
+        return pos == end;
+    }
+};
+
+}
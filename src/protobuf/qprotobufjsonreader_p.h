@@ -0,0 +1,315 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+#include <cstring>
+#include <stdexcept>
+
+#include "qprotobufjsonstring_p.h"
+#include "qtprotobufglobal.h"
+
+namespace QtProtobuf {
+
+/*!
+ * \private
+ * \brief The QProtobufJsonReader class is pull parser, that reads JSON tokens directly from input buffer
+ */
+class QProtobufJsonReader
+{
+public:
+    //! Protects stack from deeply nested input
+    static const int MaxNestingDepth = 100;
+
+    void reset(const char *data, int size) {
+        m_pos = data;
+        m_end = data + size;
+    }
+
+    char peek() {
+        skipWhitespace();
+        if (m_pos >= m_end) {
+            throw std::invalid_argument("Unexpected end of JSON");
+        }
+        return *m_pos;
+    }
+
+    /*!
+     * \brief Returns pointer to the first character, that is not read yet
+     */
+    const char *position() const {
+        return m_pos;
+    }
+
+    bool atEnd() {
+        skipWhitespace();
+        return m_pos >= m_end;
+    }
+
+    void expect(char c) {
+        if (peek() != c) {
+            throw std::invalid_argument("Unexpected character in JSON");
+        }
+        ++m_pos;
+    }
+
+    bool consume(char c) {
+        if (peek() == c) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+    /*!
+     * \brief Reads literal token, e.g. number, true, false or null
+     */
+    void readLiteral(const char *&begin, int &size) {
+        skipWhitespace();
+        begin = m_pos;
+        while (m_pos < m_end && (isLiteralCharacter(*m_pos))) {
+            ++m_pos;
+        }
+        size = static_cast<int>(m_pos - begin);
+        if (size == 0) {
+            throw std::invalid_argument("Unexpected character in JSON");
+        }
+    }
+
+    /*!
+     * \brief Consumes null literal if it's next token
+     */
+    bool readNull() {
+        if (peek() != 'n') {
+            return false;
+        }
+        const char *begin = nullptr;
+        int size = 0;
+        readLiteral(begin, size);
+        if (size != 4 || std::strncmp(begin, "null", 4) != 0) {
+            throw std::invalid_argument("Unexpected literal in JSON");
+        }
+        return true;
+    }
+
+    /*!
+     * \brief Reads string token and decodes escape sequences to \a out
+     */
+    void readString(QByteArray &out) {
+        expect('"');
+        out.resize(0);
+        const char *begin = m_pos;
+        while (true) {
+            m_pos += QProtobufJsonString::findSpecial(m_pos, static_cast<int>(m_end - m_pos));
+            if (m_pos >= m_end) {
+                throw std::invalid_argument("JSON string is not terminated");
+            }
+            const char c = *m_pos;
+            if (c == '"') {
+                out.append(begin, static_cast<int>(m_pos - begin));
+                ++m_pos;
+                return;
+            }
+
+            if (c != '\\') {
+                ++m_pos;//Control characters are accepted as is
+                continue;
+            }
+
+            out.append(begin, static_cast<int>(m_pos - begin));
+            ++m_pos;
+            if (m_pos >= m_end) {
+                throw std::invalid_argument("JSON string is not terminated");
+            }
+            switch (*m_pos++) {
+            case '"':
+                out.append('"');
+                break;
+            case '\\':
+                out.append('\\');
+                break;
+            case '/':
+                out.append('/');
+                break;
+            case 'b':
+                out.append('\b');
+                break;
+            case 'f':
+                out.append('\f');
+                break;
+            case 'n':
+                out.append('\n');
+                break;
+            case 'r':
+                out.append('\r');
+                break;
+            case 't':
+                out.append('\t');
+                break;
+            case 'u': {
+                quint32 code = readHex4();
+                if (code >= 0xd800 && code < 0xdc00) {
+                    if (m_end - m_pos < 6 || m_pos[0] != '\\' || m_pos[1] != 'u') {
+                        throw std::invalid_argument("Invalid surrogate pair in JSON string");
+                    }
+                    m_pos += 2;
+                    const quint32 low = readHex4();
+                    if (low < 0xdc00 || low >= 0xe000) {
+                        throw std::invalid_argument("Invalid surrogate pair in JSON string");
+                    }
+                    code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+                }
+                appendUtf8(out, code);
+            } break;
+            default:
+                throw std::invalid_argument("Invalid escape sequence in JSON string");
+            }
+            begin = m_pos;
+        }
+    }
+
+    void skipValue(int depth) {
+        if (depth >= MaxNestingDepth) {
+            throw std::invalid_argument("Maximum nesting depth is exceeded");
+        }
+
+        switch (peek()) {
+        case '"':
+            skipString();
+            break;
+        case '{':
+            ++m_pos;
+            if (consume('}')) {
+                break;
+            }
+            do {
+                skipWhitespace();
+                skipString();
+                expect(':');
+                skipValue(depth + 1);
+            } while (consume(','));
+            expect('}');
+            break;
+        case '[':
+            ++m_pos;
+            if (consume(']')) {
+                break;
+            }
+            do {
+                skipValue(depth + 1);
+            } while (consume(','));
+            expect(']');
+            break;
+        default: {
+            const char *begin = nullptr;
+            int size = 0;
+            readLiteral(begin, size);
+        } break;
+        }
+    }
+
+private:
+    static void appendUtf8(QByteArray &out, quint32 code) {
+        if (code < 0x80) {
+            out.append(static_cast<char>(code));
+        } else if (code < 0x800) {
+            out.append(static_cast<char>(0xc0 | (code >> 6)));
+            out.append(static_cast<char>(0x80 | (code & 0x3f)));
+        } else if (code < 0x10000) {
+            out.append(static_cast<char>(0xe0 | (code >> 12)));
+            out.append(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+            out.append(static_cast<char>(0x80 | (code & 0x3f)));
+        } else {
+            out.append(static_cast<char>(0xf0 | (code >> 18)));
+            out.append(static_cast<char>(0x80 | ((code >> 12) & 0x3f)));
+            out.append(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+            out.append(static_cast<char>(0x80 | (code & 0x3f)));
+        }
+    }
+
+    static bool isLiteralCharacter(char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+                || c == '-' || c == '+' || c == '.';
+    }
+
+    void skipWhitespace() {
+        while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\n' || *m_pos == '\r' || *m_pos == '\t')) {
+            ++m_pos;
+        }
+    }
+
+    void skipString() {
+        if (m_pos >= m_end || *m_pos != '"') {
+            throw std::invalid_argument("Unexpected character in JSON");
+        }
+        ++m_pos;
+        while (true) {
+            m_pos += QProtobufJsonString::findSpecial(m_pos, static_cast<int>(m_end - m_pos));
+            if (m_pos >= m_end || *m_pos == '"') {
+                break;
+            }
+            if (*m_pos == '\\') {
+                //Escaped character is skipped together with backslash, trailing backslash is not terminated string
+                if (m_end - m_pos < 2) {
+                    throw std::invalid_argument("JSON string is not terminated");
+                }
+                ++m_pos;
+            }
+            ++m_pos;
+        }
+        if (m_pos >= m_end) {
+            throw std::invalid_argument("JSON string is not terminated");
+        }
+        ++m_pos;
+    }
+
+    quint32 readHex4() {
+        if (m_end - m_pos < 4) {
+            throw std::invalid_argument("Invalid escape sequence in JSON string");
+        }
+        quint32 code = 0;
+        for (int i = 0; i < 4; i++) {
+            const char c = *m_pos++;
+            code <<= 4;
+            if (c >= '0' && c <= '9') {
+                code |= static_cast<quint32>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                code |= static_cast<quint32>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                code |= static_cast<quint32>(c - 'A' + 10);
+            } else {
+                throw std::invalid_argument("Invalid escape sequence in JSON string");
+            }
+        }
+        return code;
+    }
+
+    const char *m_pos = nullptr;
+    const char *m_end = nullptr;
+};
+
+}
@@ -28,218 +28,622 @@
 #include "qprotobufmetaproperty.h"
 #include "qtprotobuflogging.h"
 
-#include <microjson.h>
+#include "qprotobufjsonnumber_p.h"
+#include "qprotobufjsonreader_p.h"
+#include "qprotobufjsonstring_p.h"
+#include "qprotobufsnapshotregistry_p.h"
 
+#include <QHash>
 #include <QMetaProperty>
+#include <QVector>
+#include <QtNumeric>
+
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 
 using namespace QtProtobuf;
 
+namespace {
+//Output is passed to writer by chunks of this size, when writer is not backed by QByteArray
+const int FlushThreshold = 16 * 1024;
+
+enum JsonType {
+    JsonBoolType,
+    JsonNumberType,
+    JsonStringType
+};
+
+/*!
+ * \private
+ * \brief JsonField keeps property of message field and its JSON name, encoded as "name": prefix
+ */
+struct JsonField {
+    QProtobufMetaProperty metaProperty;
+    QByteArray prefix;
+    int presenceIndex;//index of field in presence bitmap if field has explicit presence or is message, -1 otherwise
+};
+
+/*!
+ * \private
+ * \brief FieldTable contains fields of message in serialization order and index of fields by JSON and property names
+ */
+struct FieldTable {
+    std::vector<JsonField> fields;
+    QHash<QByteArray, int> names;
+
+    //Looks up field by JSON name, property name or field name of .proto file. \a scratch is used for name conversion
+    const JsonField *field(const QByteArray &name, QByteArray &scratch) const {
+        auto it = names.constFind(name);
+        if (it == names.constEnd() && QProtobufJsonString::toPropertyName(name, scratch)) {
+            it = names.constFind(scratch);
+        }
+        return it != names.constEnd() ? &fields[static_cast<size_t>(*it)] : nullptr;
+    }
+};
+
+/*!
+ * \private
+ * \brief Returns true if \a metaProperty holds singular message field, that is either inherited of QObject or gadget
+ */
+bool isMessageField(const QProtobufMetaProperty &metaProperty) {
+    const auto handler = QtProtobufPrivate::findHandler(metaProperty.userType());
+    return handler.type == QtProtobufPrivate::ObjectHandler && handler.metaObject != nullptr;
+}
+
+using FieldTableRegistry = QtProtobufPrivate::QProtobufSnapshotRegistry<const QProtobufMetaObject *, std::shared_ptr<const FieldTable>>;
+
+/*!
+ * \private
+ * \brief Returns table of fields for \a metaObject. Tables are built once and never released, so reference stays valid
+ */
+const FieldTable &fieldTable(const QProtobufMetaObject &metaObject) {
+    static FieldTableRegistry registry;
+    {
+        const auto tables = registry.snapshot();
+        auto it = tables->find(&metaObject);
+        if (it != tables->end()) {
+            return *(it->second);
+        }
+    }
+
+    auto table = std::make_shared<FieldTable>();
+    table->fields.reserve(metaObject.propertyOrdering.size());
+    for (const auto &field : metaObject.propertyOrdering) {
+        Q_ASSERT_X(field.first < 536870912 && field.first > 0, "", "fieldIndex is out of range");
+        QProtobufMetaProperty metaProperty(metaObject.staticMetaObject.property(field.second), field.first);
+        const QByteArray jsonName = metaProperty.protoPropertyName().toUtf8();
+        QByteArray prefix;
+        QProtobufJsonString::appendEscaped(prefix, jsonName.constData(), jsonName.size());
+        prefix.append(':');
+
+        int presenceIndex = -1;
+        const QProtobufFieldPresenceInfo *presenceInfo = metaObject.presenceInfo;
+        if (presenceInfo != nullptr) {
+            const int bit = field.second - metaObject.staticMetaObject.propertyOffset();
+            if (bit >= 0 && bit < presenceInfo->fieldCount
+                    && ((presenceInfo->explicitPresence[bit >> 5] & (1u << (bit & 31))) != 0 || isMessageField(metaProperty))) {
+                presenceIndex = bit;
+            }
+        }
+
+        const int index = static_cast<int>(table->fields.size());
+        table->fields.push_back({metaProperty, prefix, presenceIndex});
+        table->names.insert(jsonName, index);
+        table->names.insert(QByteArray(metaProperty.name()), index);
+    }
+
+    const FieldTable *result = nullptr;
+    registry.modify([&](FieldTableRegistry::Map &tables) {
+        //Table could be already added by other thread
+        result = tables.emplace(&metaObject, table).first->second.get();
+    });
+    return *result;
+}
+
+//Moves \a it to the position of \a reader, after value is read
+void advance(QProtobufSelfcheckIterator &it, const QProtobufJsonReader &reader) {
+    it += static_cast<int>(reader.position() - it.data());
+}
+}
+
 namespace QtProtobuf {
 
+/*!
+ * \private
+ * \brief The QProtobufJsonWriter class produces JSON text directly to output buffer
+ *
+ * \details Values are appended to the QByteArray of target writer, when target provides it, or to internal buffer,
+ *          that is passed to target writer by big chunks. Separator after value is kept pending until next value
+ *          is written, so closing of object, list or map drops it without trimming of written data. Separators
+ *          of JSON written by parts to other writers are passed to them as pending data, see QProtobufWriter::setPending.
+ */
+class QProtobufJsonWriter final : public QProtobufWriter
+{
+    Q_DISABLE_COPY_MOVE(QProtobufJsonWriter)
+public:
+    explicit QProtobufJsonWriter(QProtobufWriter &target) : m_target(target)
+      , m_output(target.buffer())
+      , m_separator(false)
+    {
+        //Data, that is pending in target, precedes everything written by this writer
+        target.flushPending();
+        if (m_output == nullptr) {
+            m_buffer.reserve(FlushThreshold);
+            m_output = &m_buffer;
+        }
+    }
+
+    ~QProtobufJsonWriter() {
+        flush();
+    }
+
+    void beginObject() { begin('{'); }
+    void endObject() { end('}'); }
+    void beginList() { begin('['); }
+    void endList() { end(']'); }
+
+    //Writes name of field, that is already encoded with quotes and colon
+    void writeRawName(const QByteArray &prefix) {
+        writeSeparator();
+        m_output->append(prefix);
+    }
+
+    void writeName(const QString &name) {
+        writeSeparator();
+        appendString(name.toUtf8());
+        m_output->append(':');
+    }
+
+    void writeString(const QString &value) {
+        writeSeparator();
+        appendString(value.toUtf8());
+        endValue();
+    }
+
+    void writeString(const char *value) {
+        writeSeparator();
+        appendString(QByteArray::fromRawData(value, static_cast<int>(qstrlen(value))));
+        endValue();
+    }
+
+    void writeBytes(const QByteArray &value) {
+        writeSeparator();
+        m_output->append('"');
+        QProtobufJsonString::appendBase64(*m_output, value.constData(), value.size());
+        m_output->append('"');
+        endValue();
+    }
+
+    void writeBool(bool value) {
+        writeValue(value ? "true" : "false");
+    }
+
+    void writeInteger(qint64 value) {
+        char digits[QProtobufJsonNumber::MaxIntegerLength];
+        char *end = digits + sizeof(digits);
+        char *begin = QProtobufJsonNumber::formatInteger(value, end);
+        writeValue(begin, static_cast<int>(end - begin));
+    }
+
+    void writeUnsigned(quint64 value) {
+        char digits[QProtobufJsonNumber::MaxIntegerLength];
+        char *end = digits + sizeof(digits);
+        char *begin = QProtobufJsonNumber::formatUnsigned(value, end);
+        writeValue(begin, static_cast<int>(end - begin));
+    }
+
+    void writeFloat(float value) {
+        if (writeSpecialReal(static_cast<double>(value))) {
+            return;
+        }
+        char number[QProtobufJsonNumber::MaxRealLength];
+        writeValue(number, QProtobufJsonNumber::formatFloat(value, number));
+    }
+
+    void writeDouble(double value) {
+        if (writeSpecialReal(value)) {
+            return;
+        }
+        char number[QProtobufJsonNumber::MaxRealLength];
+        writeValue(number, QProtobufJsonNumber::formatDouble(value, number));
+    }
+
+    //Makes pending separator part of output
+    void writeSeparator() {
+        //Raw JSON, written with write(), may leave separator pending
+        flushPending();
+        if (m_separator) {
+            m_output->append(',');
+            m_separator = false;
+        }
+    }
+
+    //Separator after last written value, if any, is passed to target as pending data
+    void finish(bool keepSeparator) {
+        takePending();
+        flush();
+        if (keepSeparator && m_separator) {
+            m_target.setPending(QByteArray(1, ','));
+        }
+        m_separator = false;
+    }
+
+    void flush() {
+        if (m_output == &m_buffer && !m_buffer.isEmpty()) {
+            m_target.write(m_buffer);
+            //Keep allocated capacity, buffer is reused for next writes
+            m_buffer.resize(0);
+        }
+    }
+
+private:
+    void begin(char bracket) {
+        writeSeparator();
+        m_output->append(bracket);
+    }
+
+    void end(char bracket) {
+        //Separator after last element, that is pending after raw JSON, is dropped as well
+        takePending();
+        m_separator = false;
+        m_output->append(bracket);
+        endValue();
+    }
+
+    void endValue() {
+        m_separator = true;
+        flushIfFull();
+    }
+
+    void writeValue(const char *value) {
+        writeValue(value, static_cast<int>(qstrlen(value)));
+    }
+
+    void writeValue(const char *value, int size) {
+        writeSeparator();
+        m_output->append(value, size);
+        endValue();
+    }
+
+    //Writes values, that have no representation as JSON number, and zero
+    bool writeSpecialReal(double value) {
+        if (qIsNaN(value)) {
+            writeValue("\"NaN\"");
+        } else if (qIsInf(value)) {
+            writeValue(value > 0 ? "\"Infinity\"" : "\"-Infinity\"");
+        } else if (value == 0) {
+            writeValue("0");//Negative zero is written without sign
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    void appendString(const QByteArray &value) {
+        QProtobufJsonString::appendEscaped(*m_output, value.constData(), value.size());
+    }
+
+    //Raw JSON produced outside of writer, e.g. by parallel list serialization, may have trailing separator
+    void writeData(const char *data, int size) override {
+        if (size <= 0) {
+            return;
+        }
+
+        bool separator = data[size - 1] == ',';
+        writeSeparator();
+        m_output->append(data, separator ? size - 1 : size);
+        m_separator = separator;
+        flushIfFull();
+    }
+
+    void flushIfFull() {
+        if (m_output == &m_buffer && m_buffer.size() >= FlushThreshold) {
+            flush();
+        }
+    }
+
+    QProtobufWriter &m_target;
+    QByteArray *m_output;
+    QByteArray m_buffer;
+    bool m_separator;
+};
+
 //! \private
 class QProtobufJsonSerializerPrivate final
 {
     Q_DISABLE_COPY_MOVE(QProtobufJsonSerializerPrivate)
 public:
-    using Serializer = std::function<QByteArray(const QVariant&)>;
-    using Deserializer = std::function<QVariant(QByteArray, microjson::JsonType, bool &)>;
+    using Serializer = std::function<void(const QVariant&, QProtobufJsonWriter &)>;
+    using Deserializer = std::function<QVariant(const QByteArray &, JsonType, bool &)>;
+    using ListDeserializer = std::function<QVariant(QProtobufJsonReader &)>;
 
     struct SerializationHandlers {
         Serializer serializer; /*!< serializer assigned to class */
         Deserializer deserializer;/*!< deserializer assigned to class */
+        ListDeserializer listDeserializer;/*!< deserializer of list, that reads JSON array directly */
     };
 
     using SerializerRegistry = std::unordered_map<int/*metatypeid*/, SerializationHandlers>;
 
-    static QByteArray serializeFloat(const QVariant &propertyValue) {
-        bool ok = false;
-        float value = propertyValue.toFloat(&ok);
-        if (!ok) {
-            return QByteArray("NaN");
-        }
-        return QString::number(static_cast<double>(value), 'g').toUtf8();
+    template<typename T>
+    static void serializeInteger(const QVariant &propertyValue, QProtobufJsonWriter &writer) {
+        const T value = propertyValue.value<T>();
+        writer.writeInteger(value);
     }
 
-    static QByteArray serializeString(const QVariant &propertyValue) {
-        return QString("\"%1\"").arg(propertyValue.toString()).toUtf8() ;
+    template<typename T>
+    static void serializeUnsigned(const QVariant &propertyValue, QProtobufJsonWriter &writer) {
+        const T value = propertyValue.value<T>();
+        writer.writeUnsigned(value);
     }
 
-    static QByteArray serializeBytes(const QVariant &propertyValue) {
-        return QByteArray("\"") + propertyValue.toByteArray().toBase64() + "\"";
+    static void serializeBool(const QVariant &propertyValue, QProtobufJsonWriter &writer) {
+        writer.writeBool(propertyValue.toBool());
+    }
+
+    static void serializeFloat(const QVariant &propertyValue, QProtobufJsonWriter &writer) {
+        writer.writeFloat(propertyValue.value<float>());
+    }
+
+    static void serializeDouble(const QVariant &propertyValue, QProtobufJsonWriter &writer) {
+        writer.writeDouble(propertyValue.toDouble());
+    }
+
+    static void serializeString(const QVariant &propertyValue, QProtobufJsonWriter &writer) {
+        writer.writeString(propertyValue.toString());
+    }
+
+    static void serializeBytes(const QVariant &propertyValue, QProtobufJsonWriter &writer) {
+        writer.writeBytes(propertyValue.toByteArray());
     }
 
     template<typename L>
-    static QByteArray serializeList(const QVariant &propertyValue) {
-        L listValue = propertyValue.value<L>();
-        QByteArray result("[");
-        for (auto value : listValue) {
-            result += QString::number(value) + ",";
+    static void serializeIntegerList(const QVariant &propertyValue, QProtobufJsonWriter &writer) {
+        const L listValue = propertyValue.value<L>();
+        writer.beginList();
+        for (const auto &value : listValue) {
+            writer.writeInteger(value);
         }
-        if (listValue.size() > 0) {
-            result.resize(result.size() - 1);//Remove trailing `,`
+        writer.endList();
+    }
+
+    template<typename L>
+    static void serializeUnsignedList(const QVariant &propertyValue, QProtobufJsonWriter &writer) {
+        const L listValue = propertyValue.value<L>();
+        writer.beginList();
+        for (const auto &value : listValue) {
+            writer.writeUnsigned(value);
         }
-        result += "]";
-        return result;
+        writer.endList();
     }
 
-    static QByteArray serializeDoubleList(const QVariant &propertyValue) {
-        DoubleList listValue = propertyValue.value<DoubleList>();
-        QByteArray result("[");
+    static void serializeFloatList(const QVariant &propertyValue, QProtobufJsonWriter &writer) {
+        const FloatList listValue = propertyValue.value<FloatList>();
+        writer.beginList();
         for (auto value : listValue) {
-            result += QString::number(value, 'g').toUtf8() + ",";
+            writer.writeFloat(value);
         }
-        if (listValue.size() > 0) {
-            result.resize(result.size() - 1);//Remove trailing `,`
-        }
-        result += "]";
-        return result;
+        writer.endList();
     }
 
-    static QByteArray serializeStringList(const QVariant &propertyValue) {
-        QStringList listValue = propertyValue.value<QStringList>();
-        QByteArray result("[");
+    static void serializeDoubleList(const QVariant &propertyValue, QProtobufJsonWriter &writer) {
+        const DoubleList listValue = propertyValue.value<DoubleList>();
+        writer.beginList();
         for (auto value : listValue) {
-            result += QByteArray("\"") + value.toUtf8() + "\",";
+            writer.writeDouble(value);
         }
-        if (listValue.size() > 0) {
-            result.resize(result.size() - 1);//Remove trailing `,`
-        }
-        result += "]";
-        return result;
+        writer.endList();
     }
 
-    static QByteArray serializeBytesList(const QVariant &propertyValue) {
-        QByteArrayList listValue = propertyValue.value<QByteArrayList>();
-        QByteArray result("[");
-        for (auto value : listValue) {
-            result += QByteArray("\"") + value.toBase64() + "\",";
+    static void serializeStringList(const QVariant &propertyValue, QProtobufJsonWriter &writer) {
+        const QStringList listValue = propertyValue.value<QStringList>();
+        writer.beginList();
+        for (const auto &value : listValue) {
+            writer.writeString(value);
         }
-        if (listValue.size() > 0) {
-            result.resize(result.size() - 1);//Remove trailing `,`
+        writer.endList();
+    }
+
+    static void serializeBytesList(const QVariant &propertyValue, QProtobufJsonWriter &writer) {
+        const QByteArrayList listValue = propertyValue.value<QByteArrayList>();
+        writer.beginList();
+        for (const auto &value : listValue) {
+            writer.writeBytes(value);
         }
-        result += "]";
-        return result;
+        writer.endList();
     }
 
     QProtobufJsonSerializerPrivate(QProtobufJsonSerializer *q) : qPtr(q) {
-        if (handlers.empty()) {
-            handlers[qMetaTypeId<QtProtobuf::int32>()] = {{}, QProtobufJsonSerializerPrivate::deserializeInt32};
-            handlers[qMetaTypeId<QtProtobuf::sfixed32>()] = {{}, QProtobufJsonSerializerPrivate::deserializeInt32};
-            handlers[qMetaTypeId<QtProtobuf::sint32>()] = {{}, QProtobufJsonSerializerPrivate::deserializeInt32};
-            handlers[qMetaTypeId<QtProtobuf::sint64>()] = {{}, QProtobufJsonSerializerPrivate::deserializeInt64};
-            handlers[qMetaTypeId<QtProtobuf::int64>()] = {{}, QProtobufJsonSerializerPrivate::deserializeInt64};
-            handlers[qMetaTypeId<QtProtobuf::sfixed64>()] = {{}, QProtobufJsonSerializerPrivate::deserializeInt64};
-            handlers[qMetaTypeId<QtProtobuf::uint32>()] = {{}, QProtobufJsonSerializerPrivate::deserializeUInt32};
-            handlers[qMetaTypeId<QtProtobuf::fixed32>()] = {{}, QProtobufJsonSerializerPrivate::deserializeUInt32};
-            handlers[qMetaTypeId<QtProtobuf::uint64>()] = {{}, QProtobufJsonSerializerPrivate::deserializeUInt64};
-            handlers[qMetaTypeId<QtProtobuf::fixed64>()] = {{}, QProtobufJsonSerializerPrivate::deserializeUInt64};
-            handlers[qMetaTypeId<bool>()] = {{}, QProtobufJsonSerializerPrivate::deserializeBool};
+        //Initialization of function-local static is thread-safe, so handlers are filled exactly once
+        static const bool initialized = [] {
+            handlers[qMetaTypeId<QtProtobuf::int32>()] = {QProtobufJsonSerializerPrivate::serializeInteger<QtProtobuf::int32>, QProtobufJsonSerializerPrivate::deserializeInt32};
+            handlers[qMetaTypeId<QtProtobuf::sfixed32>()] = {QProtobufJsonSerializerPrivate::serializeInteger<QtProtobuf::sfixed32>, QProtobufJsonSerializerPrivate::deserializeInt32};
+            handlers[qMetaTypeId<QtProtobuf::sint32>()] = {QProtobufJsonSerializerPrivate::serializeInteger<QtProtobuf::sint32>, QProtobufJsonSerializerPrivate::deserializeInt32};
+            handlers[qMetaTypeId<QtProtobuf::sint64>()] = {QProtobufJsonSerializerPrivate::serializeInteger<QtProtobuf::sint64>, QProtobufJsonSerializerPrivate::deserializeInt64};
+            handlers[qMetaTypeId<QtProtobuf::int64>()] = {QProtobufJsonSerializerPrivate::serializeInteger<QtProtobuf::int64>, QProtobufJsonSerializerPrivate::deserializeInt64};
+            handlers[qMetaTypeId<QtProtobuf::sfixed64>()] = {QProtobufJsonSerializerPrivate::serializeInteger<QtProtobuf::sfixed64>, QProtobufJsonSerializerPrivate::deserializeInt64};
+            handlers[qMetaTypeId<QtProtobuf::uint32>()] = {QProtobufJsonSerializerPrivate::serializeUnsigned<QtProtobuf::uint32>, QProtobufJsonSerializerPrivate::deserializeUInt32};
+            handlers[qMetaTypeId<QtProtobuf::fixed32>()] = {QProtobufJsonSerializerPrivate::serializeUnsigned<QtProtobuf::fixed32>, QProtobufJsonSerializerPrivate::deserializeUInt32};
+            handlers[qMetaTypeId<QtProtobuf::uint64>()] = {QProtobufJsonSerializerPrivate::serializeUnsigned<QtProtobuf::uint64>, QProtobufJsonSerializerPrivate::deserializeUInt64};
+            handlers[qMetaTypeId<QtProtobuf::fixed64>()] = {QProtobufJsonSerializerPrivate::serializeUnsigned<QtProtobuf::fixed64>, QProtobufJsonSerializerPrivate::deserializeUInt64};
+            handlers[qMetaTypeId<bool>()] = {QProtobufJsonSerializerPrivate::serializeBool, QProtobufJsonSerializerPrivate::deserializeBool};
             handlers[QMetaType::Float] = {QProtobufJsonSerializerPrivate::serializeFloat, QProtobufJsonSerializerPrivate::deserializeFloat};
-            handlers[QMetaType::Double] = {{}, QProtobufJsonSerializerPrivate::deserializeDouble};
+            handlers[QMetaType::Double] = {QProtobufJsonSerializerPrivate::serializeDouble, QProtobufJsonSerializerPrivate::deserializeDouble};
             handlers[QMetaType::QString] = {QProtobufJsonSerializerPrivate::serializeString, QProtobufJsonSerializerPrivate::deserializeString};
             handlers[QMetaType::QByteArray] = {QProtobufJsonSerializerPrivate::serializeBytes, QProtobufJsonSerializerPrivate::deserializeByteArray};
-            handlers[qMetaTypeId<QtProtobuf::int32List>()] = {QProtobufJsonSerializerPrivate::serializeList<QtProtobuf::int32List>, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::int32>};
-            handlers[qMetaTypeId<QtProtobuf::int64List>()] = {QProtobufJsonSerializerPrivate::serializeList<QtProtobuf::int64List>, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::int64>};
-            handlers[qMetaTypeId<QtProtobuf::sint32List>()] = {QProtobufJsonSerializerPrivate::serializeList<QtProtobuf::sint32List>, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::sint32>};
-            handlers[qMetaTypeId<QtProtobuf::sint64List>()] = {QProtobufJsonSerializerPrivate::serializeList<QtProtobuf::sint64List>, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::sint64>};
-            handlers[qMetaTypeId<QtProtobuf::uint32List>()] = {QProtobufJsonSerializerPrivate::serializeList<QtProtobuf::uint32List>, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::uint32>};
-            handlers[qMetaTypeId<QtProtobuf::uint64List>()] = {QProtobufJsonSerializerPrivate::serializeList<QtProtobuf::uint64List>, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::uint64>};
-            handlers[qMetaTypeId<QtProtobuf::fixed32List>()] = {QProtobufJsonSerializerPrivate::serializeList<QtProtobuf::fixed32List>, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::fixed32>};
-            handlers[qMetaTypeId<QtProtobuf::fixed64List>()] = {QProtobufJsonSerializerPrivate::serializeList<QtProtobuf::fixed64List>, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::fixed64>};
-            handlers[qMetaTypeId<QtProtobuf::sfixed32List>()] = {QProtobufJsonSerializerPrivate::serializeList<QtProtobuf::sfixed32List>, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::sfixed32>};
-            handlers[qMetaTypeId<QtProtobuf::sfixed64List>()] = {QProtobufJsonSerializerPrivate::serializeList<QtProtobuf::sfixed64List>, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::sfixed64>};
-            handlers[qMetaTypeId<QtProtobuf::FloatList>()] = {QProtobufJsonSerializerPrivate::serializeList<QtProtobuf::FloatList>, QProtobufJsonSerializerPrivate::deserializeList<float>};
-            handlers[qMetaTypeId<QtProtobuf::DoubleList>()] = {QProtobufJsonSerializerPrivate::serializeDoubleList, QProtobufJsonSerializerPrivate::deserializeList<double>};
-            handlers[qMetaTypeId<QStringList>()] = {QProtobufJsonSerializerPrivate::serializeStringList, QProtobufJsonSerializerPrivate::deserializeStringList};
-            handlers[qMetaTypeId<QByteArrayList>()] = {QProtobufJsonSerializerPrivate::serializeBytesList, QProtobufJsonSerializerPrivate::deserializeList<QByteArray>};
-        }
+            handlers[qMetaTypeId<QtProtobuf::int32List>()] = {QProtobufJsonSerializerPrivate::serializeIntegerList<QtProtobuf::int32List>, {}, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::int32>};
+            handlers[qMetaTypeId<QtProtobuf::int64List>()] = {QProtobufJsonSerializerPrivate::serializeIntegerList<QtProtobuf::int64List>, {}, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::int64>};
+            handlers[qMetaTypeId<QtProtobuf::sint32List>()] = {QProtobufJsonSerializerPrivate::serializeIntegerList<QtProtobuf::sint32List>, {}, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::sint32>};
+            handlers[qMetaTypeId<QtProtobuf::sint64List>()] = {QProtobufJsonSerializerPrivate::serializeIntegerList<QtProtobuf::sint64List>, {}, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::sint64>};
+            handlers[qMetaTypeId<QtProtobuf::uint32List>()] = {QProtobufJsonSerializerPrivate::serializeUnsignedList<QtProtobuf::uint32List>, {}, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::uint32>};
+            handlers[qMetaTypeId<QtProtobuf::uint64List>()] = {QProtobufJsonSerializerPrivate::serializeUnsignedList<QtProtobuf::uint64List>, {}, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::uint64>};
+            handlers[qMetaTypeId<QtProtobuf::fixed32List>()] = {QProtobufJsonSerializerPrivate::serializeUnsignedList<QtProtobuf::fixed32List>, {}, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::fixed32>};
+            handlers[qMetaTypeId<QtProtobuf::fixed64List>()] = {QProtobufJsonSerializerPrivate::serializeUnsignedList<QtProtobuf::fixed64List>, {}, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::fixed64>};
+            handlers[qMetaTypeId<QtProtobuf::sfixed32List>()] = {QProtobufJsonSerializerPrivate::serializeIntegerList<QtProtobuf::sfixed32List>, {}, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::sfixed32>};
+            handlers[qMetaTypeId<QtProtobuf::sfixed64List>()] = {QProtobufJsonSerializerPrivate::serializeIntegerList<QtProtobuf::sfixed64List>, {}, QProtobufJsonSerializerPrivate::deserializeList<QtProtobuf::sfixed64>};
+            handlers[qMetaTypeId<QtProtobuf::FloatList>()] = {QProtobufJsonSerializerPrivate::serializeFloatList, {}, QProtobufJsonSerializerPrivate::deserializeList<float>};
+            handlers[qMetaTypeId<QtProtobuf::DoubleList>()] = {QProtobufJsonSerializerPrivate::serializeDoubleList, {}, QProtobufJsonSerializerPrivate::deserializeList<double>};
+            handlers[qMetaTypeId<QStringList>()] = {QProtobufJsonSerializerPrivate::serializeStringList, {}, QProtobufJsonSerializerPrivate::deserializeList<QString>};
+            handlers[qMetaTypeId<QByteArrayList>()] = {QProtobufJsonSerializerPrivate::serializeBytesList, {}, QProtobufJsonSerializerPrivate::deserializeList<QByteArray>};
+            return true;
+        }();
+        Q_UNUSED(initialized);
     }
     ~QProtobufJsonSerializerPrivate() = default;
 
-    QByteArray serializeValue(const QVariant &propertyValue, const QProtobufMetaProperty &metaProperty) {
-        QByteArray buffer;
+    void serializeValue(const QVariant &propertyValue, const QProtobufMetaProperty &metaProperty, QProtobufJsonWriter &writer) {
         auto userType = propertyValue.userType();
         auto value = QtProtobufPrivate::findHandler(userType);
         if (value.serializer) {
-            value.serializer(qPtr, propertyValue, metaProperty, buffer);
+            value.serializer(qPtr, propertyValue, metaProperty, writer);
         } else {
             auto handler = handlers.find(userType);
             if (handler != handlers.end() && handler->second.serializer) {
-                buffer += handler->second.serializer(propertyValue);
+                handler->second.serializer(propertyValue, writer);
             } else {
-                buffer += propertyValue.toString().toUtf8();
+                writer.writeString(propertyValue.toString());
             }
         }
-        return buffer;
     }
 
-    QByteArray serializeProperty(const QVariant &propertyValue, const QProtobufMetaProperty &metaProperty) {
-        return QByteArray("\"") + metaProperty.protoPropertyName().toUtf8() + "\":" + serializeValue(propertyValue, metaProperty);
+    void serializeObject(const void *object, const QProtobufMetaObject &metaObject, QProtobufJsonWriter &writer) {
+        writer.beginObject();
+        const quint32 *bits = metaObject.presenceInfo != nullptr ? metaObject.presenceInfo->bits(object) : nullptr;
+        for (const auto &field : fieldTable(metaObject).fields) {
+            //Unset message fields and unset fields with explicit presence, like inactive oneof fields, are omitted
+            if (field.presenceIndex >= 0 && (bits[field.presenceIndex >> 5] & (1u << (field.presenceIndex & 31))) == 0) {
+                continue;
+            }
+            const QVariant propertyValue = metaObject.readProperty(object, field.metaProperty);
+            writer.writeRawName(field.prefix);
+            serializeValue(propertyValue, field.metaProperty, writer);
+        }
+        writer.endObject();
+    }
+
+    void serializeMapPair(const QVariant &key, const QVariant &value, const QProtobufMetaProperty &metaProperty, QProtobufJsonWriter &writer) {
+        writer.writeName(key.toString());
+        serializeValue(value, metaProperty, writer);
+    }
+
+    void serializeEnum(int64 value, const QMetaEnum &metaEnum, QProtobufJsonWriter &writer) {
+        const char *key = metaEnum.valueToKey(static_cast<int>(value));
+        if (key != nullptr) {
+            writer.writeString(key);
+        } else {
+            writer.writeInteger(value);//Values unknown for enum are kept as numbers
+        }
+    }
+
+    void serializeEnumList(const QList<int64> &values, const QMetaEnum &metaEnum, QProtobufJsonWriter &writer) {
+        writer.beginList();
+        for (auto value : values) {
+            serializeEnum(value, metaEnum, writer);
+        }
+        writer.endList();
     }
 
-    QByteArray serializeObject(const QObject *object, const QProtobufMetaObject &metaObject) {
-        QByteArray result = "{";
-        for (const auto &field : metaObject.propertyOrdering) {
-            int propertyIndex = field.second;
-            int fieldIndex = field.first;
-            Q_ASSERT_X(fieldIndex < 536870912 && fieldIndex > 0, "", "fieldIndex is out of range");
-            QMetaProperty metaProperty = metaObject.staticMetaObject.property(propertyIndex);
-            const char *propertyName = metaProperty.name();
-            const QVariant &propertyValue = object->property(propertyName);
-            result.append(serializeProperty(propertyValue, QProtobufMetaProperty(metaProperty, fieldIndex)));
-            result.append(",");
+    //Calls serialization function with JSON writer, wrapping \a writer if it's not JSON writer already
+    template<typename Function>
+    static void write(QProtobufWriter &writer, bool keepSeparator, Function function) {
+        QProtobufJsonWriter *jsonWriter = dynamic_cast<QProtobufJsonWriter *>(&writer);
+        if (jsonWriter != nullptr) {
+            function(*jsonWriter);
+            return;
         }
-        result.resize(result.size() - 1);//Remove trailing `,`
-        result.append("}");
+
+        QProtobufJsonWriter wrapper(writer);
+        function(wrapper);
+        wrapper.finish(keepSeparator);
+    }
+
+    template<typename Function>
+    static QByteArray toByteArray(bool keepSeparator, Function function) {
+        QByteArray result;
+        QProtobufByteArrayWriter writer(result);
+        write(writer, keepSeparator, function);
+        //Byte array API returns separator as part of data, e.g. for serializeListEnd
+        writer.flushPending();
         return result;
     }
 
-    static QVariant deserializeInt32(const QByteArray &data, microjson::JsonType type, bool &ok) {
-        auto val = data.toInt(&ok);
-        ok |= type == microjson::JsonNumberType;
-        return QVariant::fromValue(val);
+    //Closes list or map written by parts to writer, that is not JSON writer
+    static void writeEnd(QProtobufWriter &writer, char bracket) {
+        QProtobufJsonWriter *jsonWriter = dynamic_cast<QProtobufJsonWriter *>(&writer);
+        if (jsonWriter != nullptr) {
+            if (bracket == ']') {
+                jsonWriter->endList();
+            } else {
+                jsonWriter->endObject();
+            }
+            return;
+        }
+
+        //Separator after last element is still pending, so it's dropped for any writer
+        QByteArray pending = writer.takePending();
+        if (pending.endsWith(',')) {
+            pending.chop(1);
+        }
+        writer.write(pending);
+        writer.write(&bracket, 1);
     }
 
-    static QVariant deserializeUInt32(const QByteArray &data, microjson::JsonType type, bool &ok) {
-        auto val = data.toUInt(&ok);
-        ok |= type == microjson::JsonNumberType;
-        return QVariant::fromValue(val);
+    static QVariant deserializeInt32(const QByteArray &data, JsonType type, bool &ok) {
+        qint64 val = QProtobufJsonNumber::parseInteger(data.constData(), data.size(), ok);
+        if (val < std::numeric_limits<int>::min() || val > std::numeric_limits<int>::max()) {
+            ok = false;
+            val = 0;
+        }
+        ok |= type == JsonNumberType;
+        return QVariant::fromValue(static_cast<int>(val));
     }
 
-    static QVariant deserializeInt64(const QByteArray &data, microjson::JsonType type, bool &ok) {
-        auto val = data.toLongLong(&ok);
-        ok |= type == microjson::JsonNumberType;
+    static QVariant deserializeUInt32(const QByteArray &data, JsonType type, bool &ok) {
+        quint64 val = QProtobufJsonNumber::parseUnsigned(data.constData(), data.size(), ok);
+        if (val > std::numeric_limits<uint>::max()) {
+            ok = false;
+            val = 0;
+        }
+        ok |= type == JsonNumberType;
+        return QVariant::fromValue(static_cast<uint>(val));
+    }
+
+    static QVariant deserializeInt64(const QByteArray &data, JsonType type, bool &ok) {
+        auto val = QProtobufJsonNumber::parseInteger(data.constData(), data.size(), ok);
+        ok |= type == JsonNumberType;
         return QVariant::fromValue(val);
     }
 
-    static QVariant deserializeUInt64(const QByteArray &data, microjson::JsonType type, bool &ok) {
-        auto val = data.toULongLong(&ok);
-        ok |= type == microjson::JsonNumberType;
+    static QVariant deserializeUInt64(const QByteArray &data, JsonType type, bool &ok) {
+        auto val = QProtobufJsonNumber::parseUnsigned(data.constData(), data.size(), ok);
+        ok |= type == JsonNumberType;
         return QVariant::fromValue(val);
     }
 
-    static QVariant deserializeFloat(const QByteArray &data, microjson::JsonType type, bool &ok) {
+    static QVariant deserializeFloat(const QByteArray &data, JsonType type, bool &ok) {
         if (data == "NaN" || data == "Infinity" || data == "-Infinity") {
             ok = true;
             return QVariant();
         }
-        auto val = data.toFloat(&ok);
-        ok |= type == microjson::JsonNumberType;
+        auto val = QProtobufJsonNumber::parseFloat(data.constData(), data.size(), ok);
+        ok |= type == JsonNumberType;
         return QVariant::fromValue(val);
     }
 
-    static QVariant deserializeDouble(const QByteArray &data, microjson::JsonType type, bool &ok) {
+    static QVariant deserializeDouble(const QByteArray &data, JsonType type, bool &ok) {
         if (data == "NaN" || data == "Infinity" || data == "-Infinity") {
             ok = true;
             return QVariant();
         }
-        auto val = data.toDouble(&ok);
-        ok |= type == microjson::JsonNumberType;
+        auto val = QProtobufJsonNumber::parseDouble(data.constData(), data.size(), ok);
+        ok |= type == JsonNumberType;
         return QVariant::fromValue(val);
     }
 
-    static QVariant deserializeBool(const QByteArray &data, microjson::JsonType type, bool &ok) {
-        if (type == microjson::JsonBoolType) {
+    static QVariant deserializeBool(const QByteArray &data, JsonType type, bool &ok) {
+        if (type == JsonBoolType) {
             ok = true;
             return QVariant::fromValue(data == "true");
         }
@@ -248,110 +652,292 @@ public:
         return QVariant();
     }
 
-    static QVariant deserializeString(const QByteArray &data, microjson::JsonType type, bool &ok) {
-        if (type == microjson::JsonStringType) {
+    static QVariant deserializeString(const QByteArray &data, JsonType type, bool &ok) {
+        if (type == JsonStringType) {
             ok = true;
-            return QVariant::fromValue(QString::fromUtf8(data).replace("\\\"", "\""));
+            return QVariant::fromValue(QString::fromUtf8(data));
         }
 
         ok = false;
         return QVariant();
     }
 
-    static QVariant deserializeByteArray(const QByteArray &data, microjson::JsonType type, bool &ok) {
-        if (type == microjson::JsonStringType) {
-            ok = true;
-            return QVariant::fromValue(QByteArray::fromBase64(data));
+    static QVariant deserializeByteArray(const QByteArray &data, JsonType type, bool &ok) {
+        if (type == JsonStringType) {
+            QByteArray value;
+            ok = QProtobufJsonString::decodeBase64(data.constData(), data.size(), value);
+            return QVariant::fromValue(value);
         }
 
         ok = false;
         return QVariant();
     }
 
-    template<typename T>
-    static QVariant deserializeList(const QByteArray &data, microjson::JsonType type, bool &ok) {
-        if (type != microjson::JsonArrayType) {
-            ok = false;
+    /*!
+     * \brief Reads scalar value from \a reader and passes its text to \a deserializer. Strings are
+     *        decoded to \a buffer, other tokens are passed without copying
+     */
+    static QVariant readScalar(QProtobufJsonReader &reader, const Deserializer &deserializer, QByteArray &buffer, bool &ok) {
+        ok = false;
+        if (reader.readNull()) {
+            return QVariant();
+        }
+
+        switch (reader.peek()) {
+        case '"':
+            reader.readString(buffer);
+            return deserializer(buffer, JsonStringType, ok);
+        case '{':
+        case '[':
+            reader.skipValue(0);//Value of incompatible type is ignored
             return QVariant();
+        default:
+            break;
         }
 
-        ok = true;
+        const char *begin = nullptr;
+        int size = 0;
+        reader.readLiteral(begin, size);
+        const QByteArray token = QByteArray::fromRawData(begin, size);
+        return deserializer(token, token == "true" || token == "false" ? JsonBoolType : JsonNumberType, ok);
+    }
+
+    template<typename T>
+    static QVariant deserializeList(QProtobufJsonReader &reader) {
         QList<T> list;
-        auto arrayValues = microjson::parseJsonArray(data.data(), static_cast<size_t>(data.size()));
         auto handler = handlers.find(qMetaTypeId<T>());
         if (handler == handlers.end() || !handler->second.deserializer) {
             qProtoWarning() << "Unable to deserialize simple type list. Could not find desrializer for type" << qMetaTypeId<T>();
+            reader.skipValue(0);
             return QVariant::fromValue(list);
         }
 
-        for (auto &arrayValue : arrayValues) {
-            bool valueOk = false;
-            QVariant newValue = handler->second.deserializer(QByteArray::fromStdString(arrayValue.value), arrayValue.type, valueOk);
-            list.append(newValue.value<T>());
+        QByteArray buffer;
+        reader.expect('[');
+        if (!reader.consume(']')) {
+            do {
+                bool ok = false;
+                QVariant value = readScalar(reader, handler->second.deserializer, buffer, ok);
+                list.append(value.value<T>());//Null and invalid elements are appended as default values
+            } while (reader.consume(','));
+            reader.expect(']');
         }
         return QVariant::fromValue(list);
     }
 
-    static QVariant deserializeStringList(const QByteArray &data, microjson::JsonType type, bool &ok) {
-        if (type != microjson::JsonArrayType) {
-            ok = false;
-            return QVariant();
-        }
-
-        ok = true;
-        QStringList list;
-        auto arrayValues = microjson::parseJsonArray(data.data(), static_cast<size_t>(data.size()));
-        for (auto &arrayValue : arrayValues) {
-            bool valueOk = false;
-            QVariant newValue = deserializeString(QByteArray::fromStdString(arrayValue.value), arrayValue.type, valueOk);
-            list.append(newValue.value<QString>());
+    /*!
+     * \brief Reads value of \a type from \a reader. Messages, lists of messages, maps and enums are read by
+     *        handlers of global registry, that continue from the position of \a it
+     * \return false if value has incompatible type and should be ignored
+     */
+    bool readValue(QProtobufJsonReader &reader, QProtobufSelfcheckIterator &it, int type, QVariant &value) {
+        if (reader.readNull()) {
+            value = QVariant();
+            return true;
         }
-        return QVariant::fromValue(list);
-    }
 
-    QVariant deserializeValue(int type, const QByteArray &data, microjson::JsonType jsonType, bool &ok) {
-        QVariant newValue;
         auto handler = QtProtobufPrivate::findHandler(type);
         if (handler.deserializer) {
-            QtProtobuf::QProtobufSelfcheckIterator it(data);
-            QtProtobuf::QProtobufSelfcheckIterator last = it;
-            last += it.size();
-            while (it != last) {
-                ok = true;
-                handler.deserializer(qPtr, it, newValue);
-                qDebug() << "newValue" << newValue;
+            char close = 0;
+            if (handler.type == QtProtobufPrivate::ListHandler && !handler.metaEnum.isValid()) {
+                reader.expect('[');
+                close = ']';
+            } else if (handler.type == QtProtobufPrivate::MapHandler) {
+                reader.expect('{');
+                close = '}';
             }
-        } else {
-            auto handler = handlers.find(type);
-            if (handler != handlers.end() && handler->second.deserializer) {
-                newValue = handler->second.deserializer(data, jsonType, ok);
+
+            if (close == ']' && handler.listDeserializer) {
+                //Elements refer to input data and deserialized all at once, in parallel for long lists
+                QVector<QByteArray> elements;
+                if (!reader.consume(']')) {
+                    do {
+                        if (reader.readNull()) {
+                            continue;
+                        }
+                        const char *begin = reader.position();
+                        reader.skipValue(0);
+                        elements.append(QByteArray::fromRawData(begin, static_cast<int>(reader.position() - begin)));
+                    } while (reader.consume(','));
+                    reader.expect(']');
+                }
+                handler.listDeserializer(qPtr, elements, value);
+                return true;
+            }
+
+            if (close == 0) {
+                advance(it, reader);
+                handler.deserializer(qPtr, it, value);
+                reader.reset(it.data(), it.size());
+                return true;
             }
+
+            //Elements are read one by one, handler deserializes single list element or map pair
+            if (!reader.consume(close)) {
+                do {
+                    if (reader.readNull()) {
+                        continue;
+                    }
+                    advance(it, reader);
+                    handler.deserializer(qPtr, it, value);
+                    reader.reset(it.data(), it.size());
+                } while (reader.consume(','));
+                reader.expect(close);
+            }
+            return true;
+        }
+
+        auto localHandler = handlers.find(type);
+        if (localHandler == handlers.end()) {
+            reader.skipValue(0);
+            return false;
         }
-        return newValue;
+
+        if (localHandler->second.listDeserializer) {
+            if (reader.peek() != '[') {
+                reader.skipValue(0);
+                return false;
+            }
+            value = localHandler->second.listDeserializer(reader);
+            return true;
+        }
+
+        QByteArray buffer;
+        bool ok = false;
+        value = readScalar(reader, localHandler->second.deserializer, buffer, ok);
+        return ok;
     }
 
-    void deserializeObject(QObject *object, const QProtobufMetaObject &metaObject, const char *data, int size) {
-        microjson::JsonObject obj = microjson::parseJsonObject(data, static_cast<size_t>(size));
+    /*!
+     * \brief NestingGuard limits depth of nested messages deserialization
+     * \details Nested messages are deserialized recursively through SerializationHandler, so depth is counted per thread
+     */
+    class NestingGuard
+    {
+    public:
+        NestingGuard() {
+            if (++depth() > QProtobufJsonReader::MaxNestingDepth) {
+                --depth();
+                throw std::invalid_argument("Maximum nesting depth is exceeded");
+            }
+        }
+        ~NestingGuard() {
+            --depth();
+        }
+
+    private:
+        static int &depth() {
+            static thread_local int value = 0;
+            return value;
+        }
+    };
 
-        for (auto &property : obj) {
-            auto name = property.first;
-            int propertyIndex = metaObject.staticMetaObject.indexOfProperty(name.data());
-            if (propertyIndex >= 0) {
-                QMetaProperty metaProperty = metaObject.staticMetaObject.property(propertyIndex);
-                auto userType = metaProperty.userType();
-                QByteArray rawValue = QByteArray::fromStdString(property.second.value);
-                if (rawValue == "null" && property.second.type == microjson::JsonObjectType) {
-                    object->setProperty(name.c_str(), QVariant());//Initialize with default value
+    void deserializeMessage(void *object, const QProtobufMetaObject &metaObject, const QByteArray &data) {
+        QProtobufJsonReader reader;
+        reader.reset(data.constData(), data.size());
+        if (reader.atEnd()) {
+            return;
+        }
+
+        QProtobufSelfcheckIterator it(data);
+        it += static_cast<int>(reader.position() - data.constData());
+        deserializeObject(object, metaObject, it);
+
+        reader.reset(it.data(), it.size());
+        if (!reader.atEnd()) {
+            throw std::invalid_argument("Unexpected data after end of JSON object");
+        }
+    }
+
+    void deserializeObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) {
+        NestingGuard guard;
+        const FieldTable &fields = fieldTable(metaObject);
+        QProtobufJsonReader reader;
+        reader.reset(it.data(), it.size());
+        QByteArray name;
+        QByteArray scratch;
+        reader.expect('{');
+        if (!reader.consume('}')) {
+            do {
+                reader.readString(name);
+                reader.expect(':');
+                const JsonField *field = fields.field(name, scratch);
+                if (field == nullptr) {
+                    reader.skipValue(0);//Unknown fields are skipped
                     continue;
                 }
-                bool ok = false;
-                QVariant value = deserializeValue(userType, rawValue, property.second.type, ok);
-                if (ok) {
-                    object->setProperty(name.c_str(), value);
+
+                QVariant value;
+                if (readValue(reader, it, field->metaProperty.userType(), value)) {
+                    metaObject.writeProperty(object, field->metaProperty, value);//Null value initializes property with default value
                 }
-            }
+            } while (reader.consume(','));
+            reader.expect('}');
         }
+        advance(it, reader);
     }
+
+    void deserializeMapPair(QVariant &key, QVariant &value, QProtobufSelfcheckIterator &it) {
+        QProtobufJsonReader reader;
+        reader.reset(it.data(), it.size());
+        QByteArray name;
+        reader.readString(name);
+        reader.expect(':');
+
+        bool ok = false;
+        auto keyHandler = handlers.find(key.userType());
+        if (keyHandler != handlers.end() && keyHandler->second.deserializer) {
+            key = keyHandler->second.deserializer(name, JsonStringType, ok);
+        }
+        if (!ok) {
+            key = QVariant();
+        }
+
+        if (!readValue(reader, it, value.userType(), value)) {
+            value = QVariant();
+        }
+        advance(it, reader);
+    }
+
+    static int64 readEnum(QProtobufJsonReader &reader, const QMetaEnum &metaEnum, QByteArray &buffer) {
+        if (reader.readNull()) {
+            return metaEnum.value(0);
+        }
+
+        if (reader.peek() == '"') {
+            reader.readString(buffer);
+            return metaEnum.keyToValue(buffer.constData());
+        }
+
+        const char *begin = nullptr;
+        int size = 0;
+        reader.readLiteral(begin, size);
+        bool ok = false;
+        return QProtobufJsonNumber::parseInteger(begin, size, ok);
+    }
+
+    static void deserializeEnum(int64 &value, const QMetaEnum &metaEnum, QProtobufSelfcheckIterator &it) {
+        QProtobufJsonReader reader;
+        reader.reset(it.data(), it.size());
+        QByteArray buffer;
+        value = readEnum(reader, metaEnum, buffer);
+        advance(it, reader);
+    }
+
+    static void deserializeEnumList(QList<int64> &values, const QMetaEnum &metaEnum, QProtobufSelfcheckIterator &it) {
+        QProtobufJsonReader reader;
+        reader.reset(it.data(), it.size());
+        QByteArray buffer;
+        reader.expect('[');
+        if (!reader.consume(']')) {
+            do {
+                values.append(readEnum(reader, metaEnum, buffer));
+            } while (reader.consume(','));
+            reader.expect(']');
+        }
+        advance(it, reader);
+    }
+
 private:
     static SerializerRegistry handlers;
     QProtobufJsonSerializer *qPtr;
@@ -368,25 +954,28 @@ QProtobufJsonSerializer::QProtobufJsonSerializer() : dPtr(new QProtobufJsonSeria
 QProtobufJsonSerializer::~QProtobufJsonSerializer() = default;
 
 
-QByteArray QProtobufJsonSerializer::serializeMessage(const QObject *object, const QProtobufMetaObject &metaObject) const
+QByteArray QProtobufJsonSerializer::serializeMessage(const void *object, const QProtobufMetaObject &metaObject) const
 {
-    return dPtr->serializeObject(object, metaObject);
+    return QProtobufJsonSerializerPrivate::toByteArray(false, [&](QProtobufJsonWriter &writer) {
+        dPtr->serializeObject(object, metaObject, writer);
+    });
 }
 
-void QProtobufJsonSerializer::deserializeMessage(QObject *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const
+void QProtobufJsonSerializer::deserializeMessage(void *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const
 {
-    dPtr->deserializeObject(object, metaObject, data.data(), data.size());
+    dPtr->deserializeMessage(object, metaObject, data);
 }
 
-QByteArray QProtobufJsonSerializer::serializeObject(const QObject *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &/*metaProperty*/) const
+QByteArray QProtobufJsonSerializer::serializeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &/*metaProperty*/) const
 {
-    return dPtr->serializeObject(object, metaObject);
+    return QProtobufJsonSerializerPrivate::toByteArray(false, [&](QProtobufJsonWriter &writer) {
+        dPtr->serializeObject(object, metaObject, writer);
+    });
 }
 
-void QProtobufJsonSerializer::deserializeObject(QObject *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const
+void QProtobufJsonSerializer::deserializeObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const
 {
-    dPtr->deserializeObject(object, metaObject, it.data(), it.size());
-    it += it.size();
+    dPtr->deserializeObject(object, metaObject, it);
 }
 
 QByteArray QProtobufJsonSerializer::serializeListBegin(const QProtobufMetaProperty &/*metaProperty*/) const
@@ -394,35 +983,24 @@ QByteArray QProtobufJsonSerializer::serializeListBegin(const QProtobufMetaProper
     return {"["};
 }
 
-QByteArray QProtobufJsonSerializer::serializeListObject(const QObject *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &/*metaProperty*/) const
+QByteArray QProtobufJsonSerializer::serializeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &/*metaProperty*/) const
 {
-    return dPtr->serializeObject(object, metaObject) + ",";
+    return QProtobufJsonSerializerPrivate::toByteArray(true, [&](QProtobufJsonWriter &writer) {
+        dPtr->serializeObject(object, metaObject, writer);
+    });
 }
 
 QByteArray QProtobufJsonSerializer::serializeListEnd(QByteArray &buffer, const QProtobufMetaProperty &/*metaProperty*/) const
 {
-    if (buffer[buffer.size() - 1] == ',') {
-        buffer.resize(buffer.size() - 1);
+    if (buffer.endsWith(',')) {
+        buffer.chop(1);
     }
     return {"]"};
 }
 
-bool QProtobufJsonSerializer::deserializeListObject(QObject *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const
+bool QProtobufJsonSerializer::deserializeListObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const
 {
-    if (*it == '[') {
-        qDebug() << "Begin of list";
-        ++it;
-    }
-
-    size_t i = 0;
-    microjson::JsonProperty property;
-    if (microjson::extractValue(it.data(), static_cast<size_t>(it.size()), i, ']', property)) {
-        dPtr->deserializeObject(object, metaObject, it.data() + property.valueBegin, property.valueSize());
-    } else {
-        it += it.size();
-        return false;
-    }
-    it += i;
+    dPtr->deserializeObject(object, metaObject, it);
     return true;
 }
 
@@ -432,81 +1010,111 @@ QByteArray QProtobufJsonSerializer::serializeMapBegin(const QProtobufMetaPropert
 }
 QByteArray QProtobufJsonSerializer::serializeMapPair(const QVariant &key, const QVariant &value, const QProtobufMetaProperty &metaProperty) const
 {
-    return QByteArray("\"") + key.toString().toUtf8() + "\":" + dPtr->serializeValue(value, metaProperty) + ",";
+    return QProtobufJsonSerializerPrivate::toByteArray(true, [&](QProtobufJsonWriter &writer) {
+        dPtr->serializeMapPair(key, value, metaProperty, writer);
+    });
 }
 
 QByteArray QProtobufJsonSerializer::serializeMapEnd(QByteArray &buffer, const QProtobufMetaProperty &/*metaProperty*/) const
 {
-    if (buffer[buffer.size() - 1] == ',') {
-        buffer.resize(buffer.size() - 1);
+    if (buffer.endsWith(',')) {
+        buffer.chop(1);
     }
     return {"}"};
 }
 
 bool QProtobufJsonSerializer::deserializeMapPair(QVariant &key, QVariant &value, QProtobufSelfcheckIterator &it) const
 {
-    if (*it == '{') {
-        qDebug() << "Begin of map";
-        ++it;
-    }
-
-    size_t i = 0;
-    microjson::JsonProperty property;
-    if (microjson::extractProperty(it.data(), static_cast<size_t>(it.size()), i, '}', property)) {
-        bool ok = false;
-        key = dPtr->deserializeValue(key.userType(), QByteArray(it.data() + property.nameBegin, property.nameSize()), microjson::JsonStringType, ok);
-        if (!ok) {
-            key = QVariant();
-        }
-        value = dPtr->deserializeValue(value.userType(), QByteArray(it.data() + property.valueBegin, property.valueSize()), property.type, ok);
-        if (!ok) {
-            value = QVariant();
-        }
-    } else {
-        it += it.size();
-        return false;
-    }
-    it += i;
+    dPtr->deserializeMapPair(key, value, it);
     return true;
 }
 
 QByteArray QProtobufJsonSerializer::serializeEnum(int64 value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &/*metaProperty*/) const
 {
-    return QByteArray("\"") + metaEnum.key(static_cast<int>(value)) + "\"";
+    return QProtobufJsonSerializerPrivate::toByteArray(false, [&](QProtobufJsonWriter &writer) {
+        dPtr->serializeEnum(value, metaEnum, writer);
+    });
 }
 
 QByteArray QProtobufJsonSerializer::serializeEnumList(const QList<int64> &values, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &/*metaProperty*/) const
 {
-    QByteArray result = "[";
-    for (auto value : values) {
-        result.append("\"");
-        result.append(metaEnum.key(static_cast<int>(value)));
-        result.append("\",");
-    }
-    if (values.size() > 0) {
-        result.resize(result.size() - 1);
-    }
-    result.append("]");
-    return result;
+    return QProtobufJsonSerializerPrivate::toByteArray(false, [&](QProtobufJsonWriter &writer) {
+        dPtr->serializeEnumList(values, metaEnum, writer);
+    });
 }
 
 void QProtobufJsonSerializer::deserializeEnum(int64 &value, const QMetaEnum &metaEnum, QProtobufSelfcheckIterator &it) const
 {
-    value = metaEnum.keyToValue(it.data());
-    it += it.size();
+    QProtobufJsonSerializerPrivate::deserializeEnum(value, metaEnum, it);
 }
 
 void QProtobufJsonSerializer::deserializeEnumList(QList<int64> &value, const QMetaEnum &metaEnum, QProtobufSelfcheckIterator &it) const
 {
-    auto arrayValues = microjson::parseJsonArray(it.data(), static_cast<size_t>(it.size()));
+    QProtobufJsonSerializerPrivate::deserializeEnumList(value, metaEnum, it);
+}
 
-    for (auto &arrayValue : arrayValues) {
-        if (arrayValue.value == "null") {
-            value.append(metaEnum.value(0));
-        } else {
-             value.append(metaEnum.keyToValue(arrayValue.value.c_str()));
-        }
-    }
+void QProtobufJsonSerializer::writeMessage(const void *object, const QProtobufMetaObject &metaObject, QProtobufWriter &writer) const
+{
+    QProtobufJsonSerializerPrivate::write(writer, false, [&](QProtobufJsonWriter &jsonWriter) {
+        dPtr->serializeObject(object, metaObject, jsonWriter);
+    });
+}
+
+void QProtobufJsonSerializer::writeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &/*metaProperty*/, QProtobufWriter &writer) const
+{
+    QProtobufJsonSerializerPrivate::write(writer, false, [&](QProtobufJsonWriter &jsonWriter) {
+        dPtr->serializeObject(object, metaObject, jsonWriter);
+    });
+}
+
+void QProtobufJsonSerializer::writeListBegin(const QProtobufMetaProperty &/*metaProperty*/, QProtobufWriter &writer) const
+{
+    QProtobufJsonSerializerPrivate::write(writer, false, [](QProtobufJsonWriter &jsonWriter) {
+        jsonWriter.beginList();
+    });
+}
+
+void QProtobufJsonSerializer::writeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &/*metaProperty*/, QProtobufWriter &writer) const
+{
+    QProtobufJsonSerializerPrivate::write(writer, true, [&](QProtobufJsonWriter &jsonWriter) {
+        dPtr->serializeObject(object, metaObject, jsonWriter);
+    });
+}
 
-    it += it.size();
+void QProtobufJsonSerializer::writeListEnd(const QProtobufMetaProperty &/*metaProperty*/, QProtobufWriter &writer) const
+{
+    QProtobufJsonSerializerPrivate::writeEnd(writer, ']');
+}
+
+void QProtobufJsonSerializer::writeMapBegin(const QProtobufMetaProperty &/*metaProperty*/, QProtobufWriter &writer) const
+{
+    QProtobufJsonSerializerPrivate::write(writer, false, [](QProtobufJsonWriter &jsonWriter) {
+        jsonWriter.beginObject();
+    });
+}
+
+void QProtobufJsonSerializer::writeMapPair(const QVariant &key, const QVariant &value, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const
+{
+    QProtobufJsonSerializerPrivate::write(writer, true, [&](QProtobufJsonWriter &jsonWriter) {
+        dPtr->serializeMapPair(key, value, metaProperty, jsonWriter);
+    });
+}
+
+void QProtobufJsonSerializer::writeMapEnd(const QProtobufMetaProperty &/*metaProperty*/, QProtobufWriter &writer) const
+{
+    QProtobufJsonSerializerPrivate::writeEnd(writer, '}');
+}
+
+void QProtobufJsonSerializer::writeEnum(int64 value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &/*metaProperty*/, QProtobufWriter &writer) const
+{
+    QProtobufJsonSerializerPrivate::write(writer, false, [&](QProtobufJsonWriter &jsonWriter) {
+        dPtr->serializeEnum(value, metaEnum, jsonWriter);
+    });
+}
+
+void QProtobufJsonSerializer::writeEnumList(const QList<int64> &value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &/*metaProperty*/, QProtobufWriter &writer) const
+{
+    QProtobufJsonSerializerPrivate::write(writer, false, [&](QProtobufJsonWriter &jsonWriter) {
+        dPtr->serializeEnumList(value, metaEnum, jsonWriter);
+    });
 }
@@ -35,6 +35,9 @@ class QProtobufJsonSerializerPrivate;
 /*!
 *  \ingroup QtProtobuf
  * \brief The QProtobufJsonSerializer class
+ *
+ * \details JSON text is produced by single writer, that appends values directly to output QByteArray or passes
+ *          them to QIODevice by big chunks, when message is serialized with serializeTo().
  */
 class Q_PROTOBUF_EXPORT QProtobufJsonSerializer : public QAbstractProtobufSerializer
 {
@@ -43,17 +46,17 @@ public:
     ~QProtobufJsonSerializer();
 
 protected:
-    QByteArray serializeMessage(const QObject *object, const QProtobufMetaObject &metaObject) const  override;
-    void deserializeMessage(QObject *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const override;
+    QByteArray serializeMessage(const void *object, const QProtobufMetaObject &metaObject) const  override;
+    void deserializeMessage(void *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const override;
 
-    QByteArray serializeObject(const QObject *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const override;
-    void deserializeObject(QObject *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const override;
+    QByteArray serializeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const override;
+    void deserializeObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const override;
 
     QByteArray serializeListBegin(const QProtobufMetaProperty &metaProperty) const override;
-    QByteArray serializeListObject(const QObject *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const override;
+    QByteArray serializeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const override;
     QByteArray serializeListEnd(QByteArray &buffer, const QProtobufMetaProperty &metaProperty) const override;
 
-    bool deserializeListObject(QObject *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const override;
+    bool deserializeListObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const override;
 
     QByteArray serializeMapBegin(const QProtobufMetaProperty &metaProperty) const override;
     QByteArray serializeMapPair(const QVariant &key, const QVariant &value, const QProtobufMetaProperty &metaProperty) const override;
@@ -66,6 +69,21 @@ protected:
 
     void deserializeEnum(int64 &value, const QMetaEnum &metaEnum, QProtobufSelfcheckIterator &it) const override;
     void deserializeEnumList(QList<int64> &value, const QMetaEnum &metaEnum, QProtobufSelfcheckIterator &it) const override;
+
+    void writeMessage(const void *object, const QProtobufMetaObject &metaObject, QProtobufWriter &writer) const override;
+    void writeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
+
+    void writeListBegin(const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
+    void writeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
+    void writeListEnd(const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
+
+    void writeMapBegin(const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
+    void writeMapPair(const QVariant &key, const QVariant &value, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
+    void writeMapEnd(const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
+
+    void writeEnum(int64 value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
+    void writeEnumList(const QList<int64> &value, const QMetaEnum &metaEnum, const QtProtobuf::QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
+
 private:
     std::unique_ptr<QProtobufJsonSerializerPrivate> dPtr;
 };
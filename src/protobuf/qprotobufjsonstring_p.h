@@ -0,0 +1,265 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+#include <cstring>
+
+#include "qtprotobufglobal.h"
+
+namespace QtProtobuf {
+
+/*!
+ * \private
+ * \brief The QProtobufJsonString class contains escaping and base64 kernels of JSON strings
+ *
+ * \details Text is scanned by 8-byte words, so long runs of characters, that don't require escaping, are copied
+ *          in single append. Base64 is encoded and decoded by 3-byte groups directly to the output buffer, that
+ *          is resized once.
+ */
+class QProtobufJsonString
+{
+public:
+    /*!
+     * \brief Returns position of the first character in \a data, that terminates JSON string or starts escape
+     *        sequence: quotation mark, backslash or control character. Returns \a size if there is no such character
+     */
+    static int findSpecial(const char *data, int size) {
+        int i = 0;
+        for (; i + static_cast<int>(sizeof(quint64)) <= size; i += static_cast<int>(sizeof(quint64))) {
+            quint64 word;
+            std::memcpy(&word, data + i, sizeof(word));
+            if (hasLess(word, 0x20) | hasByte(word, '"') | hasByte(word, '\\')) {
+                break;
+            }
+        }
+        for (; i < size; i++) {
+            const uchar c = static_cast<uchar>(data[i]);
+            if (c < 0x20 || c == '"' || c == '\\') {
+                break;
+            }
+        }
+        return i;
+    }
+
+    /*!
+     * \brief Appends UTF-8 \a data to \a out as quoted JSON string
+     */
+    static void appendEscaped(QByteArray &out, const char *data, int size) {
+        static const char HexDigits[] = "0123456789abcdef";
+        out.append('"');
+        while (size > 0) {
+            const int run = findSpecial(data, size);
+            out.append(data, run);
+            if (run == size) {
+                break;
+            }
+
+            const uchar c = static_cast<uchar>(data[run]);
+            data += run + 1;
+            size -= run + 1;
+            switch (c) {
+            case '"':
+                out.append("\\\"", 2);
+                break;
+            case '\\':
+                out.append("\\\\", 2);
+                break;
+            case '\b':
+                out.append("\\b", 2);
+                break;
+            case '\f':
+                out.append("\\f", 2);
+                break;
+            case '\n':
+                out.append("\\n", 2);
+                break;
+            case '\r':
+                out.append("\\r", 2);
+                break;
+            case '\t':
+                out.append("\\t", 2);
+                break;
+            default: {
+                const char escaped[] = {'\\', 'u', '0', '0', HexDigits[c >> 4], HexDigits[c & 0x0f]};
+                out.append(escaped, sizeof(escaped));
+            } break;
+            }
+        }
+        out.append('"');
+    }
+
+    /*!
+     * \brief Appends base64 encoded \a data with padding to \a out
+     */
+    static void appendBase64(QByteArray &out, const char *data, int size) {
+        static const char Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        const uchar *src = reinterpret_cast<const uchar *>(data);
+        const int offset = out.size();
+        out.resize(offset + (size + 2) / 3 * 4);
+        char *dst = out.data() + offset;
+        int i = 0;
+        for (; i + 2 < size; i += 3) {
+            const quint32 chunk = (static_cast<quint32>(src[i]) << 16) | (static_cast<quint32>(src[i + 1]) << 8) | src[i + 2];
+            dst[0] = Alphabet[chunk >> 18];
+            dst[1] = Alphabet[(chunk >> 12) & 0x3f];
+            dst[2] = Alphabet[(chunk >> 6) & 0x3f];
+            dst[3] = Alphabet[chunk & 0x3f];
+            dst += 4;
+        }
+        if (i < size) {
+            quint32 chunk = static_cast<quint32>(src[i]) << 16;
+            if (i + 1 < size) {
+                chunk |= static_cast<quint32>(src[i + 1]) << 8;
+            }
+            dst[0] = Alphabet[chunk >> 18];
+            dst[1] = Alphabet[(chunk >> 12) & 0x3f];
+            dst[2] = i + 1 < size ? Alphabet[(chunk >> 6) & 0x3f] : '=';
+            dst[3] = '=';
+        }
+    }
+
+    /*!
+     * \brief Decodes base64 or base64url encoded \a data to \a out. Padding is optional
+     * \return false if \a data contains invalid characters
+     */
+    static bool decodeBase64(const char *data, int size, QByteArray &out) {
+        while (size > 0 && data[size - 1] == '=') {
+            --size;
+        }
+
+        out.resize(size / 4 * 3 + 3);
+        const uchar *src = reinterpret_cast<const uchar *>(data);
+        uchar *dst = reinterpret_cast<uchar *>(out.data());
+        int i = 0;
+        for (; i + 4 <= size; i += 4) {
+            const quint32 a = decode(src[i]);
+            const quint32 b = decode(src[i + 1]);
+            const quint32 c = decode(src[i + 2]);
+            const quint32 d = decode(src[i + 3]);
+            //Invalid characters have the highest bit set
+            if ((a | b | c | d) & Invalid) {
+                return false;
+            }
+            const quint32 chunk = (a << 18) | (b << 12) | (c << 6) | d;
+            dst[0] = static_cast<uchar>(chunk >> 16);
+            dst[1] = static_cast<uchar>(chunk >> 8);
+            dst[2] = static_cast<uchar>(chunk);
+            dst += 3;
+        }
+
+        quint32 chunk = 0;
+        const int tail = size - i;
+        if (tail == 1) {
+            return false;
+        }
+        for (int j = 0; j < tail; j++) {
+            const quint32 value = decode(src[i + j]);
+            if (value & Invalid) {
+                return false;
+            }
+            chunk |= value << (18 - 6 * j);
+        }
+        if (tail > 1) {
+            *dst++ = static_cast<uchar>(chunk >> 16);
+        }
+        if (tail > 2) {
+            *dst++ = static_cast<uchar>(chunk >> 8);
+        }
+        out.resize(static_cast<int>(dst - reinterpret_cast<uchar *>(out.data())));
+        return true;
+    }
+
+    /*!
+     * \brief Converts field name of .proto file, e.g. field_name, to name of generated property, e.g. fieldName.
+     *        Underscores are removed and following letters are capitalized, first letter is lowercased
+     * \return false if \a name is already in form of property name
+     */
+    static bool toPropertyName(const QByteArray &name, QByteArray &out) {
+        out.resize(0);
+        bool changed = false;
+        bool capitalizeNext = false;
+        for (const char c : name) {
+            if (c == '_') {
+                capitalizeNext = true;
+                changed = true;
+            } else if (capitalizeNext && c >= 'a' && c <= 'z') {
+                out.append(static_cast<char>(c - 'a' + 'A'));
+                capitalizeNext = false;
+            } else {
+                out.append(c);
+                capitalizeNext = false;
+            }
+        }
+        if (!out.isEmpty() && out[0] >= 'A' && out[0] <= 'Z') {
+            out[0] = static_cast<char>(out[0] - 'A' + 'a');
+            changed = true;
+        }
+        return changed;
+    }
+
+private:
+    static const quint32 Invalid = 0x80;
+
+    static quint64 repeat(uchar c) {
+        return static_cast<quint64>(c) * 0x0101010101010101ull;
+    }
+
+    //Non-zero if any byte of word is less than n, n must not exceed 128
+    static quint64 hasLess(quint64 word, uchar n) {
+        return (word - repeat(n)) & ~word & repeat(0x80);
+    }
+
+    static quint64 hasByte(quint64 word, uchar c) {
+        return hasLess(word ^ repeat(c), 1);
+    }
+
+    static quint32 decode(uchar c) {
+        //Standard and URL-safe alphabets are accepted both
+        static const uchar Table[256] = {
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,   62, 0x80,   62, 0x80,   63,
+              52,   53,   54,   55,   56,   57,   58,   59,   60,   61, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+            0x80,    0,    1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   14,
+              15,   16,   17,   18,   19,   20,   21,   22,   23,   24,   25, 0x80, 0x80, 0x80, 0x80,   63,
+            0x80,   26,   27,   28,   29,   30,   31,   32,   33,   34,   35,   36,   37,   38,   39,   40,
+              41,   42,   43,   44,   45,   46,   47,   48,   49,   50,   51, 0x80, 0x80, 0x80, 0x80, 0x80,
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+            0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80
+        };
+        return Table[c];
+    }
+};
+
+}
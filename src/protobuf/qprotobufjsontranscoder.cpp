@@ -0,0 +1,989 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "qprotobufjsontranscoder.h"
+#include "qabstractprotobufserializer.h"
+#include "qprotobufjsonnumber_p.h"
+#include "qprotobufjsonreader_p.h"
+#include "qprotobufjsonstring_p.h"
+#include "qprotobufmetaproperty.h"
+#include "qprotobufserializer_p.h"
+#include "qprotobufsnapshotregistry_p.h"
+
+#include <QHash>
+#include <QMetaEnum>
+#include <QMetaProperty>
+#include <QVarLengthArray>
+#include <QtEndian>
+#include <QtNumeric>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+using namespace QtProtobuf;
+
+namespace {
+//Output is passed to writer by chunks of this size, when writer is not backed by QByteArray
+const int FlushThreshold = 16 * 1024;
+const int ScratchCapacity = 256;
+const int MaxNestingDepth = QProtobufJsonReader::MaxNestingDepth;
+
+enum FieldKind {
+    UnsupportedKind,
+    Int32Kind,
+    Int64Kind,
+    UInt32Kind,
+    UInt64Kind,
+    SInt32Kind,
+    SInt64Kind,
+    Fixed32Kind,
+    Fixed64Kind,
+    SFixed32Kind,
+    SFixed64Kind,
+    FloatKind,
+    DoubleKind,
+    BoolKind,
+    StringKind,
+    BytesKind,
+    EnumKind,
+    MessageKind
+};
+
+/*!
+ * \private
+ * \brief FieldInfo describes message field. For map fields kind, metaObject and metaEnum describe map value
+ */
+struct FieldInfo {
+    int fieldNumber = 0;
+    QByteArray jsonName;
+    QByteArray propertyName;
+    FieldKind kind = UnsupportedKind;
+    bool repeated = false;
+    bool map = false;
+    FieldKind keyKind = UnsupportedKind;
+    const QProtobufMetaObject *metaObject = nullptr;
+    QMetaEnum metaEnum;
+};
+
+/*!
+ * \private
+ * \brief MessageTable contains fields of message sorted by field number and index of fields by JSON and property names
+ */
+struct MessageTable {
+    std::vector<FieldInfo> fields;
+    QHash<QByteArray, int> names;
+
+    const FieldInfo *field(int fieldNumber) const {
+        auto it = std::lower_bound(fields.begin(), fields.end(), fieldNumber, [](const FieldInfo &field, int number) {
+            return field.fieldNumber < number;
+        });
+        return it != fields.end() && it->fieldNumber == fieldNumber ? &(*it) : nullptr;
+    }
+
+    //Looks up field by JSON name, property name or field name of .proto file. \a scratch is used for name conversion
+    const FieldInfo *field(const QByteArray &name, QByteArray &scratch) const {
+        auto it = names.constFind(name);
+        if (it == names.constEnd() && QProtobufJsonString::toPropertyName(name, scratch)) {
+            it = names.constFind(scratch);
+        }
+        return it != names.constEnd() ? &fields[static_cast<size_t>(*it)] : nullptr;
+    }
+};
+
+using TableRegistry = QtProtobufPrivate::QProtobufSnapshotRegistry<const QProtobufMetaObject *, std::shared_ptr<const MessageTable>>;
+
+const std::unordered_map<int, FieldKind> &scalarKinds() {
+    static const std::unordered_map<int, FieldKind> kinds = {
+        {qMetaTypeId<int32>(), Int32Kind},
+        {qMetaTypeId<int64>(), Int64Kind},
+        {qMetaTypeId<uint32>(), UInt32Kind},
+        {qMetaTypeId<uint64>(), UInt64Kind},
+        {qMetaTypeId<sint32>(), SInt32Kind},
+        {qMetaTypeId<sint64>(), SInt64Kind},
+        {qMetaTypeId<fixed32>(), Fixed32Kind},
+        {qMetaTypeId<fixed64>(), Fixed64Kind},
+        {qMetaTypeId<sfixed32>(), SFixed32Kind},
+        {qMetaTypeId<sfixed64>(), SFixed64Kind},
+        {QMetaType::Float, FloatKind},
+        {QMetaType::Double, DoubleKind},
+        {QMetaType::Bool, BoolKind},
+        {QMetaType::QString, StringKind},
+        {QMetaType::QByteArray, BytesKind}
+    };
+    return kinds;
+}
+
+const std::unordered_map<int, FieldKind> &listKinds() {
+    static const std::unordered_map<int, FieldKind> kinds = {
+        {qMetaTypeId<int32List>(), Int32Kind},
+        {qMetaTypeId<int64List>(), Int64Kind},
+        {qMetaTypeId<uint32List>(), UInt32Kind},
+        {qMetaTypeId<uint64List>(), UInt64Kind},
+        {qMetaTypeId<sint32List>(), SInt32Kind},
+        {qMetaTypeId<sint64List>(), SInt64Kind},
+        {qMetaTypeId<fixed32List>(), Fixed32Kind},
+        {qMetaTypeId<fixed64List>(), Fixed64Kind},
+        {qMetaTypeId<sfixed32List>(), SFixed32Kind},
+        {qMetaTypeId<sfixed64List>(), SFixed64Kind},
+        {qMetaTypeId<FloatList>(), FloatKind},
+        {qMetaTypeId<DoubleList>(), DoubleKind},
+        {qMetaTypeId<QStringList>(), StringKind},
+        {qMetaTypeId<QByteArrayList>(), BytesKind}
+    };
+    return kinds;
+}
+
+FieldKind findKind(const std::unordered_map<int, FieldKind> &kinds, int userType) {
+    auto it = kinds.find(userType);
+    return it != kinds.end() ? it->second : UnsupportedKind;
+}
+
+WireTypes wireType(FieldKind kind) {
+    switch (kind) {
+    case Fixed32Kind:
+    case SFixed32Kind:
+    case FloatKind:
+        return Fixed32;
+    case Fixed64Kind:
+    case SFixed64Kind:
+    case DoubleKind:
+        return Fixed64;
+    case StringKind:
+    case BytesKind:
+    case MessageKind:
+        return LengthDelimited;
+    case UnsupportedKind:
+        return UnknownWireType;
+    default:
+        break;
+    }
+    return Varint;
+}
+
+void resolveType(int userType, FieldInfo &info) {
+    info.kind = findKind(scalarKinds(), userType);
+    if (info.kind != UnsupportedKind) {
+        return;
+    }
+
+    info.kind = findKind(listKinds(), userType);
+    if (info.kind != UnsupportedKind) {
+        info.repeated = true;
+        return;
+    }
+
+    const QtProtobufPrivate::SerializationHandler handler = QtProtobufPrivate::findHandler(userType);
+    if (handler.metaEnum.isValid()) {
+        info.kind = EnumKind;
+        info.metaEnum = handler.metaEnum;
+        info.repeated = handler.type == QtProtobufPrivate::ListHandler;
+    } else if (handler.type == QtProtobufPrivate::MapHandler && handler.mapKeyType != QMetaType::UnknownType) {
+        FieldInfo value;
+        resolveType(handler.mapValueType, value);
+        FieldKind keyKind = findKind(scalarKinds(), handler.mapKeyType);
+        if (value.repeated || value.map || keyKind == FloatKind || keyKind == DoubleKind || keyKind == BytesKind) {
+            return;
+        }
+        info.map = true;
+        info.keyKind = keyKind;
+        info.kind = keyKind != UnsupportedKind ? value.kind : UnsupportedKind;
+        info.metaObject = value.metaObject;
+        info.metaEnum = value.metaEnum;
+    } else if (handler.metaObject != nullptr) {
+        info.kind = MessageKind;
+        info.metaObject = handler.metaObject;
+        info.repeated = handler.type == QtProtobufPrivate::ListHandler;
+    }
+}
+
+std::shared_ptr<const MessageTable> buildTable(const QProtobufMetaObject &metaObject) {
+    auto table = std::make_shared<MessageTable>();
+    for (const auto &field : metaObject.propertyOrdering) {
+        QProtobufMetaProperty metaProperty(metaObject.staticMetaObject.property(field.second), field.first);
+        FieldInfo info;
+        info.fieldNumber = field.first;
+        info.jsonName = metaProperty.protoPropertyName().toUtf8();
+        info.propertyName = metaProperty.name();
+        resolveType(metaProperty.userType(), info);
+        table->fields.push_back(info);
+    }
+
+    std::sort(table->fields.begin(), table->fields.end(), [](const FieldInfo &a, const FieldInfo &b) {
+        return a.fieldNumber < b.fieldNumber;
+    });
+
+    for (size_t i = 0; i < table->fields.size(); i++) {
+        table->names.insert(table->fields[i].jsonName, static_cast<int>(i));
+        table->names.insert(table->fields[i].propertyName, static_cast<int>(i));
+    }
+    return table;
+}
+
+/*!
+ * \private
+ * \brief Returns table of fields for \a metaObject. Tables are built once and never released, so pointer stays valid
+ */
+const MessageTable *messageTable(const QProtobufMetaObject *metaObject) {
+    static TableRegistry registry;
+    {
+        const auto tables = registry.snapshot();
+        auto it = tables->find(metaObject);
+        if (it != tables->end()) {
+            return it->second.get();
+        }
+    }
+
+    auto table = buildTable(*metaObject);
+    const MessageTable *result = nullptr;
+    registry.modify([&](TableRegistry::Map &tables) {
+        //Table could be already added by other thread
+        result = tables.emplace(metaObject, table).first->second.get();
+    });
+    return result;
+}
+
+//------------------------------Binary encoding--------------------------------
+void appendHeader(QByteArray &out, int fieldNumber, WireTypes type) {
+    QProtobufSerializerPrivate::appendVarint(out, static_cast<quint32>((fieldNumber << 3) | type));
+}
+
+void appendLengthDelimited(QByteArray &out, int fieldNumber, const QByteArray &data) {
+    appendHeader(out, fieldNumber, LengthDelimited);
+    QProtobufSerializerPrivate::appendVarint(out, static_cast<quint32>(data.size()));
+    out.append(data);
+}
+
+/*!
+ * \private
+ * \brief Appends \a raw value of scalar \a kind without header. \a raw is varint payload or bits of fixed size value
+ */
+void appendScalar(QByteArray &out, FieldKind kind, quint64 raw) {
+    switch (wireType(kind)) {
+    case Fixed32: {
+        char buffer[sizeof(quint32)];
+        qToLittleEndian(static_cast<quint32>(raw), buffer);
+        out.append(buffer, sizeof(buffer));
+    } break;
+    case Fixed64: {
+        char buffer[sizeof(quint64)];
+        qToLittleEndian(raw, buffer);
+        out.append(buffer, sizeof(buffer));
+    } break;
+    default:
+        QProtobufSerializerPrivate::appendVarint(out, raw);
+        break;
+    }
+}
+
+//------------------------------Binary decoding--------------------------------
+quint64 readVarint(QProtobufSelfcheckIterator &it) {
+    return QProtobufSerializerPrivate::deserializeVarintCommon<quint64>(it);
+}
+
+void readHeader(QProtobufSelfcheckIterator &it, int &fieldNumber, WireTypes &type) {
+    if (!QProtobufSerializerPrivate::decodeHeader(it, fieldNumber, type)) {
+        throw std::invalid_argument("Invalid field header");
+    }
+}
+
+int readLength(QProtobufSelfcheckIterator &it) {
+    const uint32 length = QProtobufSerializerPrivate::deserializeVarintCommon<uint32>(it);
+    if (length > static_cast<uint32>(it.size())) {
+        throw std::out_of_range("Length delimited field is truncated");
+    }
+    return static_cast<int>(length);
+}
+
+/*!
+ * \private
+ * \brief Returns view of length delimited field pointed by \a it and moves \a it after the field.
+ *        Returned view refers data of \a it, so it has to be iterated while source data is alive
+ */
+QByteArray readLengthDelimitedView(QProtobufSelfcheckIterator &it) {
+    const int length = readLength(it);
+    QByteArray view = QByteArray::fromRawData(it.data(), length);
+    it += length;
+    return view;
+}
+
+template<typename T>
+T readFixed(QProtobufSelfcheckIterator &it) {
+    const char *data = it.data();
+    //Iterator throws if field is truncated
+    it += static_cast<int>(sizeof(T));
+    return qFromLittleEndian<T>(data);
+}
+
+//-------------------------------JSON encoding---------------------------------
+void appendUnsigned(QByteArray &out, quint64 value) {
+    char buffer[QProtobufJsonNumber::MaxIntegerLength];
+    char *end = buffer + sizeof(buffer);
+    const char *begin = QProtobufJsonNumber::formatUnsigned(value, end);
+    out.append(begin, static_cast<int>(end - begin));
+}
+
+void appendInteger(QByteArray &out, qint64 value) {
+    char buffer[QProtobufJsonNumber::MaxIntegerLength];
+    char *end = buffer + sizeof(buffer);
+    const char *begin = QProtobufJsonNumber::formatInteger(value, end);
+    out.append(begin, static_cast<int>(end - begin));
+}
+
+//-------------------------------JSON decoding---------------------------------
+
+qint64 toInteger(const QByteArray &text, bool &ok) {
+    qint64 value = QProtobufJsonNumber::parseInteger(text.constData(), text.size(), ok);
+    if (!ok) {
+        //Integer values could be written in exponent notation, e.g. 1e3
+        const double doubleValue = text.toDouble(&ok);
+        ok = ok && doubleValue == static_cast<double>(static_cast<qint64>(doubleValue))
+                && doubleValue >= -9223372036854775808.0 && doubleValue < 9223372036854775808.0;
+        value = ok ? static_cast<qint64>(doubleValue) : 0;
+    }
+    return value;
+}
+
+quint64 toUnsigned(const QByteArray &text, bool &ok) {
+    quint64 value = QProtobufJsonNumber::parseUnsigned(text.constData(), text.size(), ok);
+    if (!ok) {
+        const double doubleValue = text.toDouble(&ok);
+        ok = ok && doubleValue >= 0 && doubleValue < 18446744073709551616.0
+                && doubleValue == static_cast<double>(static_cast<quint64>(doubleValue));
+        value = ok ? static_cast<quint64>(doubleValue) : 0;
+    }
+    return value;
+}
+
+double toDouble(const QByteArray &text, bool &ok) {
+    ok = true;
+    if (text == "NaN") {
+        return qQNaN();
+    }
+    if (text == "Infinity") {
+        return qInf();
+    }
+    if (text == "-Infinity") {
+        return -qInf();
+    }
+    return QProtobufJsonNumber::parseDouble(text.constData(), text.size(), ok);
+}
+
+/*!
+ * \private
+ * \brief Converts JSON representation of scalar value to wire representation: varint payload or bits of fixed size value.
+ *        \a data must be null-terminated if value is enum name
+ */
+quint64 scalarFromText(FieldKind kind, const QMetaEnum &metaEnum, const char *data, int size) {
+    const QByteArray text = QByteArray::fromRawData(data, size);
+    bool ok = false;
+    quint64 raw = 0;
+    switch (kind) {
+    case Int32Kind:
+    case SInt32Kind:
+    case SFixed32Kind: {
+        const qint64 value = toInteger(text, ok);
+        ok = ok && value >= std::numeric_limits<qint32>::min() && value <= std::numeric_limits<qint32>::max();
+        const quint32 bits = static_cast<quint32>(value);
+        //Zigzag encoding of sint32
+        raw = kind == SInt32Kind ? ((bits << 1) ^ (value < 0 ? 0xffffffffu : 0u)) : bits;
+    } break;
+    case Int64Kind:
+    case SInt64Kind:
+    case SFixed64Kind: {
+        const qint64 value = toInteger(text, ok);
+        const quint64 bits = static_cast<quint64>(value);
+        //Zigzag encoding of sint64
+        raw = kind == SInt64Kind ? ((bits << 1) ^ (value < 0 ? std::numeric_limits<quint64>::max() : 0u)) : bits;
+    } break;
+    case UInt32Kind:
+    case Fixed32Kind:
+        raw = toUnsigned(text, ok);
+        ok = ok && raw <= std::numeric_limits<quint32>::max();
+        break;
+    case UInt64Kind:
+    case Fixed64Kind:
+        raw = toUnsigned(text, ok);
+        break;
+    case FloatKind: {
+        const float value = static_cast<float>(toDouble(text, ok));
+        quint32 bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        raw = bits;
+    } break;
+    case DoubleKind: {
+        const double value = toDouble(text, ok);
+        std::memcpy(&raw, &value, sizeof(raw));
+    } break;
+    case BoolKind:
+        ok = text == "true" || text == "false";
+        raw = text == "true" ? 1 : 0;
+        break;
+    case EnumKind: {
+        qint64 value = toInteger(text, ok);
+        if (ok) {
+            ok = value >= std::numeric_limits<qint32>::min() && value <= std::numeric_limits<qint32>::max();
+        } else {
+            value = metaEnum.keyToValue(data, &ok);
+        }
+        raw = static_cast<quint64>(value);
+    } break;
+    default:
+        break;
+    }
+
+    if (!ok) {
+        throw std::invalid_argument("Unable to convert JSON value to protobuf field value");
+    }
+    return raw;
+}
+}
+
+namespace QtProtobuf {
+
+//! \private
+class QProtobufJsonTranscoderPrivate final
+{
+    Q_DISABLE_COPY_MOVE(QProtobufJsonTranscoderPrivate)
+public:
+    QProtobufJsonTranscoderPrivate() {
+        m_name.reserve(ScratchCapacity);
+        m_propertyName.reserve(ScratchCapacity);
+        m_key.reserve(ScratchCapacity);
+        m_string.reserve(ScratchCapacity);
+        m_bytes.reserve(ScratchCapacity);
+    }
+
+    void jsonToBinary(const QByteArray &json, const QProtobufMetaObject &metaObject, QProtobufWriter &writer) {
+        m_reader.reset(json.constData(), json.size());
+        writer.flushPending();
+        QByteArray *direct = writer.buffer();
+        QByteArray &out = direct != nullptr ? *direct : buffer(0);
+        readMessage(messageTable(&metaObject), out, 1, direct == nullptr ? &writer : nullptr);
+        if (!m_reader.atEnd()) {
+            throw std::invalid_argument("Unexpected data after end of JSON");
+        }
+        if (direct == nullptr) {
+            writer.write(out);
+        }
+    }
+
+    void binaryToJson(const QByteArray &data, const QProtobufMetaObject &metaObject, QProtobufWriter &writer) {
+        writer.flushPending();
+        QByteArray *direct = writer.buffer();
+        QByteArray &out = direct != nullptr ? *direct : buffer(0);
+        writeMessage(messageTable(&metaObject), QProtobufSelfcheckIterator(data), out, 1, direct == nullptr ? &writer : nullptr);
+        if (direct == nullptr) {
+            writer.write(out);
+        }
+    }
+
+private:
+    /*!
+     * \brief Returns empty scratch buffer for nesting level \a depth. Allocated capacity is reused between calls
+     */
+    QByteArray &buffer(int depth) {
+        while (static_cast<int>(m_buffers.size()) <= depth) {
+            m_buffers.emplace_back();
+            //Reserved capacity is kept when buffer is cleared
+            m_buffers.back().reserve(ScratchCapacity);
+        }
+        QByteArray &result = m_buffers[static_cast<size_t>(depth)];
+        result.resize(0);
+        return result;
+    }
+
+    static void flushTo(QProtobufWriter *writer, QByteArray &out) {
+        if (writer != nullptr && out.size() >= FlushThreshold) {
+            writer->write(out);
+            out.resize(0);
+        }
+    }
+
+    static void checkField(const FieldInfo &field) {
+        if (field.kind == UnsupportedKind) {
+            throw std::invalid_argument("Field type is not supported by transcoder");
+        }
+    }
+
+    //------------------------------JSON to binary-----------------------------
+    void readMessage(const MessageTable *table, QByteArray &out, int depth, QProtobufWriter *writer = nullptr) {
+        if (depth > MaxNestingDepth) {
+            throw std::invalid_argument("Maximum nesting depth is exceeded");
+        }
+
+        m_reader.expect('{');
+        if (m_reader.consume('}')) {
+            return;
+        }
+
+        do {
+            m_reader.readString(m_name);
+            m_reader.expect(':');
+            const FieldInfo *field = table->field(m_name, m_propertyName);
+            if (field == nullptr) {
+                //Unknown fields are ignored same way as QProtobufJsonSerializer does
+                m_reader.skipValue(depth);
+                continue;
+            }
+
+            if (m_reader.readNull()) {
+                continue;
+            }
+
+            checkField(*field);
+            if (field->map) {
+                readMap(*field, out, depth);
+            } else if (field->repeated) {
+                readList(*field, out, depth);
+            } else {
+                readValue(field->kind, *field, field->fieldNumber, out, depth);
+            }
+            flushTo(writer, out);
+        } while (m_reader.consume(','));
+        m_reader.expect('}');
+    }
+
+    quint64 readScalar(FieldKind kind, const QMetaEnum &metaEnum) {
+        if (m_reader.peek() == '"') {
+            m_reader.readString(m_string);
+            return scalarFromText(kind, metaEnum, m_string.constData(), m_string.size());
+        }
+        const char *begin = nullptr;
+        int size = 0;
+        m_reader.readLiteral(begin, size);
+        return scalarFromText(kind, metaEnum, begin, size);
+    }
+
+    /*!
+     * \brief Reads single value of \a kind and writes it as field \a fieldNumber. Default scalar values are not written
+     */
+    void readValue(FieldKind kind, const FieldInfo &field, int fieldNumber, QByteArray &out, int depth, bool skipDefault = true) {
+        switch (kind) {
+        case MessageKind: {
+            QByteArray &body = buffer(depth);
+            readMessage(messageTable(field.metaObject), body, depth + 1);
+            appendLengthDelimited(out, fieldNumber, body);
+        } break;
+        case StringKind:
+            m_reader.readString(m_string);
+            if (!skipDefault || !m_string.isEmpty()) {
+                appendLengthDelimited(out, fieldNumber, m_string);
+            }
+            break;
+        case BytesKind:
+            m_reader.readString(m_string);
+            if (!QProtobufJsonString::decodeBase64(m_string.constData(), m_string.size(), m_bytes)) {
+                throw std::invalid_argument("Bytes field value is not valid base64");
+            }
+            if (!skipDefault || !m_bytes.isEmpty()) {
+                appendLengthDelimited(out, fieldNumber, m_bytes);
+            }
+            break;
+        default: {
+            const quint64 raw = readScalar(kind, field.metaEnum);
+            if (!skipDefault || raw != 0) {
+                appendHeader(out, fieldNumber, wireType(kind));
+                appendScalar(out, kind, raw);
+            }
+        } break;
+        }
+    }
+
+    void readList(const FieldInfo &field, QByteArray &out, int depth) {
+        m_reader.expect('[');
+        if (m_reader.consume(']')) {
+            return;
+        }
+
+        if (wireType(field.kind) != LengthDelimited) {
+            //Scalar lists are packed
+            QByteArray &body = buffer(depth);
+            do {
+                appendScalar(body, field.kind, m_reader.readNull() ? 0 : readScalar(field.kind, field.metaEnum));
+            } while (m_reader.consume(','));
+            appendLengthDelimited(out, field.fieldNumber, body);
+        } else {
+            do {
+                if (!m_reader.readNull()) {
+                    readValue(field.kind, field, field.fieldNumber, out, depth, false);
+                }
+            } while (m_reader.consume(','));
+        }
+        m_reader.expect(']');
+    }
+
+    void readMap(const FieldInfo &field, QByteArray &out, int depth) {
+        m_reader.expect('{');
+        if (m_reader.consume('}')) {
+            return;
+        }
+
+        do {
+            m_reader.readString(m_key);
+            m_reader.expect(':');
+
+            //Map entry is message with key as field 1 and value as field 2
+            QByteArray &entry = buffer(depth);
+            if (field.keyKind == StringKind) {
+                if (!m_key.isEmpty()) {
+                    appendLengthDelimited(entry, 1, m_key);
+                }
+            } else {
+                const quint64 raw = scalarFromText(field.keyKind, QMetaEnum(), m_key.constData(), m_key.size());
+                if (raw != 0) {
+                    appendHeader(entry, 1, wireType(field.keyKind));
+                    appendScalar(entry, field.keyKind, raw);
+                }
+            }
+
+            if (!m_reader.readNull()) {
+                readValue(field.kind, field, 2, entry, depth + 1);
+            }
+            appendLengthDelimited(out, field.fieldNumber, entry);
+        } while (m_reader.consume(','));
+        m_reader.expect('}');
+    }
+
+    //------------------------------Binary to JSON-----------------------------
+    void writeMessage(const MessageTable *table, QProtobufSelfcheckIterator it, QByteArray &out, int depth, QProtobufWriter *writer = nullptr) {
+        if (depth > MaxNestingDepth) {
+            throw std::invalid_argument("Maximum nesting depth is exceeded");
+        }
+
+        out.append('{');
+        bool firstField = true;
+        //Repeated and map fields, that are already written with all their records
+        QVarLengthArray<int, 8> writtenFields;
+        while (it.size() > 0) {
+            int fieldNumber = 0;
+            WireTypes type = UnknownWireType;
+            readHeader(it, fieldNumber, type);
+            const FieldInfo *field = table->field(fieldNumber);
+            if (field == nullptr
+                    || std::find(writtenFields.cbegin(), writtenFields.cend(), fieldNumber) != writtenFields.cend()) {
+                QProtobufSerializerPrivate::skipSerializedFieldBytes(it, type, fieldNumber);
+                continue;
+            }
+
+            checkField(*field);
+            if (!firstField) {
+                out.append(',');
+            }
+            firstField = false;
+            out.append('"');
+            out.append(field->jsonName);
+            out.append("\":", 2);
+
+            if (field->map || field->repeated) {
+                //All records of the same field are collected to single JSON array or object,
+                //even if records of other fields are placed between them
+                writtenFields.append(fieldNumber);
+                out.append(field->map ? '{' : '[');
+                bool firstElement = true;
+                QProtobufSelfcheckIterator next = it;
+                writeRepeatedRecord(*field, type, next, out, depth, firstElement);
+                while (next.size() > 0) {
+                    int nextFieldNumber = 0;
+                    WireTypes nextType = UnknownWireType;
+                    readHeader(next, nextFieldNumber, nextType);
+                    if (nextFieldNumber == fieldNumber) {
+                        writeRepeatedRecord(*field, nextType, next, out, depth, firstElement);
+                    } else {
+                        QProtobufSerializerPrivate::skipSerializedFieldBytes(next, nextType, nextFieldNumber);
+                    }
+                }
+                out.append(field->map ? '}' : ']');
+                //Records of this field are skipped by main loop from now on
+                QProtobufSerializerPrivate::skipSerializedFieldBytes(it, type, fieldNumber);
+            } else {
+                writeValue(field->kind, *field, type, it, out, depth);
+            }
+            flushTo(writer, out);
+        }
+        out.append('}');
+    }
+
+    void writeRepeatedRecord(const FieldInfo &field, WireTypes type, QProtobufSelfcheckIterator &it, QByteArray &out, int depth, bool &firstElement) {
+        if (field.map) {
+            writeMapEntry(field, type, it, out, depth, firstElement);
+        } else {
+            writeListElements(field, type, it, out, depth, firstElement);
+        }
+    }
+
+    void writeValue(FieldKind kind, const FieldInfo &field, WireTypes type, QProtobufSelfcheckIterator &it, QByteArray &out, int depth) {
+        if (type != wireType(kind)) {
+            throw std::invalid_argument("Unexpected wire type of field");
+        }
+
+        switch (kind) {
+        case Int32Kind:
+            appendInteger(out, static_cast<qint32>(static_cast<quint32>(readVarint(it))));
+            break;
+        case Int64Kind:
+            appendInteger(out, static_cast<qint64>(readVarint(it)));
+            break;
+        case UInt32Kind:
+            appendUnsigned(out, static_cast<quint32>(readVarint(it)));
+            break;
+        case UInt64Kind:
+            appendUnsigned(out, readVarint(it));
+            break;
+        case SInt32Kind: {
+            const quint32 value = static_cast<quint32>(readVarint(it));
+            appendInteger(out, static_cast<qint32>((value >> 1) ^ (0u - (value & 1u))));
+        } break;
+        case SInt64Kind: {
+            const quint64 value = readVarint(it);
+            appendInteger(out, static_cast<qint64>((value >> 1) ^ (0u - (value & 1u))));
+        } break;
+        case Fixed32Kind:
+            appendUnsigned(out, readFixed<quint32>(it));
+            break;
+        case SFixed32Kind:
+            appendInteger(out, static_cast<qint32>(readFixed<quint32>(it)));
+            break;
+        case Fixed64Kind:
+            appendUnsigned(out, readFixed<quint64>(it));
+            break;
+        case SFixed64Kind:
+            appendInteger(out, static_cast<qint64>(readFixed<quint64>(it)));
+            break;
+        case FloatKind: {
+            const quint32 bits = readFixed<quint32>(it);
+            float value = 0;
+            std::memcpy(&value, &bits, sizeof(value));
+            appendFloat(out, value);
+        } break;
+        case DoubleKind: {
+            const quint64 bits = readFixed<quint64>(it);
+            double value = 0;
+            std::memcpy(&value, &bits, sizeof(value));
+            appendDouble(out, value);
+        } break;
+        case BoolKind:
+            if (readVarint(it) != 0) {
+                out.append("true", 4);
+            } else {
+                out.append("false", 5);
+            }
+            break;
+        case EnumKind:
+            //Enum values are int32, negative values could be encoded as 32 or 64 bit varints
+            appendEnum(out, field.metaEnum, static_cast<qint32>(static_cast<quint32>(readVarint(it))));
+            break;
+        case StringKind: {
+            const QByteArray value = readLengthDelimitedView(it);
+            QProtobufJsonString::appendEscaped(out, value.constData(), value.size());
+        } break;
+        case BytesKind: {
+            const QByteArray value = readLengthDelimitedView(it);
+            out.append('"');
+            QProtobufJsonString::appendBase64(out, value.constData(), value.size());
+            out.append('"');
+        } break;
+        case MessageKind: {
+            const QByteArray value = readLengthDelimitedView(it);
+            writeMessage(messageTable(field.metaObject), QProtobufSelfcheckIterator(value), out, depth + 1);
+        } break;
+        default:
+            throw std::invalid_argument("Field type is not supported by transcoder");
+        }
+    }
+
+    void writeListElements(const FieldInfo &field, WireTypes type, QProtobufSelfcheckIterator &it, QByteArray &out, int depth, bool &firstElement) {
+        const WireTypes elementType = wireType(field.kind);
+        if (type == LengthDelimited && elementType != LengthDelimited) {
+            const QByteArray packed = readLengthDelimitedView(it);
+            QProtobufSelfcheckIterator packedIt(packed);
+            while (packedIt.size() > 0) {
+                appendSeparator(out, firstElement);
+                writeValue(field.kind, field, elementType, packedIt, out, depth);
+            }
+            return;
+        }
+        appendSeparator(out, firstElement);
+        writeValue(field.kind, field, type, it, out, depth);
+    }
+
+    void writeMapEntry(const FieldInfo &field, WireTypes type, QProtobufSelfcheckIterator &it, QByteArray &out, int depth, bool &firstElement) {
+        if (type != LengthDelimited) {
+            throw std::invalid_argument("Unexpected wire type of field");
+        }
+
+        const QByteArray entry = readLengthDelimitedView(it);
+        QProtobufSelfcheckIterator entryIt(entry);
+        QProtobufSelfcheckIterator key = entryIt;
+        QProtobufSelfcheckIterator value = entryIt;
+        WireTypes keyType = UnknownWireType;
+        WireTypes valueType = UnknownWireType;
+        while (entryIt.size() > 0) {
+            int fieldNumber = 0;
+            WireTypes fieldType = UnknownWireType;
+            readHeader(entryIt, fieldNumber, fieldType);
+            if (fieldNumber == 1) {
+                key = entryIt;
+                keyType = fieldType;
+            } else if (fieldNumber == 2) {
+                value = entryIt;
+                valueType = fieldType;
+            }
+            QProtobufSerializerPrivate::skipSerializedFieldBytes(entryIt, fieldType, fieldNumber);
+        }
+
+        appendSeparator(out, firstElement);
+        //JSON object keys are always strings
+        if (keyType == UnknownWireType) {
+            out.append(field.keyKind == BoolKind ? "\"false\"" : field.keyKind == StringKind ? "\"\"" : "\"0\"");
+        } else if (field.keyKind == StringKind) {
+            writeValue(field.keyKind, field, keyType, key, out, depth);
+        } else {
+            out.append('"');
+            writeValue(field.keyKind, field, keyType, key, out, depth);
+            out.append('"');
+        }
+
+        out.append(':');
+        if (valueType != UnknownWireType) {
+            writeValue(field.kind, field, valueType, value, out, depth);
+        } else {
+            appendDefault(field, out);
+        }
+    }
+
+    static void appendSeparator(QByteArray &out, bool &first) {
+        if (!first) {
+            out.append(',');
+        }
+        first = false;
+    }
+
+    static void appendDefault(const FieldInfo &field, QByteArray &out) {
+        switch (field.kind) {
+        case MessageKind:
+            out.append("{}", 2);
+            break;
+        case StringKind:
+        case BytesKind:
+            out.append("\"\"", 2);
+            break;
+        case BoolKind:
+            out.append("false", 5);
+            break;
+        case EnumKind:
+            appendEnum(out, field.metaEnum, 0);
+            break;
+        default:
+            out.append('0');
+            break;
+        }
+    }
+
+    static void appendEnum(QByteArray &out, const QMetaEnum &metaEnum, qint32 value) {
+        const char *key = metaEnum.valueToKey(value);
+        if (key == nullptr) {
+            //Unknown enum values are kept as numbers
+            appendInteger(out, value);
+            return;
+        }
+        out.append('"');
+        out.append(key);
+        out.append('"');
+    }
+
+    static bool appendSpecialDouble(QByteArray &out, double value) {
+        if (qIsNaN(value)) {
+            out.append("\"NaN\"", 5);
+        } else if (qIsInf(value)) {
+            out.append(value > 0 ? "\"Infinity\"" : "\"-Infinity\"");
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    void appendFloat(QByteArray &out, float value) {
+        if (appendSpecialDouble(out, static_cast<double>(value))) {
+            return;
+        }
+        char number[QProtobufJsonNumber::MaxRealLength];
+        out.append(number, QProtobufJsonNumber::formatFloat(value, number));
+    }
+
+    void appendDouble(QByteArray &out, double value) {
+        if (appendSpecialDouble(out, value)) {
+            return;
+        }
+        char number[QProtobufJsonNumber::MaxRealLength];
+        out.append(number, QProtobufJsonNumber::formatDouble(value, number));
+    }
+
+    QProtobufJsonReader m_reader;
+    std::deque<QByteArray> m_buffers;
+    QByteArray m_name;
+    QByteArray m_propertyName;
+    QByteArray m_key;
+    QByteArray m_string;
+    QByteArray m_bytes;
+};
+
+}
+
+QProtobufJsonTranscoder::QProtobufJsonTranscoder() : dPtr(new QProtobufJsonTranscoderPrivate)
+{
+}
+
+QProtobufJsonTranscoder::~QProtobufJsonTranscoder() = default;
+
+QByteArray QProtobufJsonTranscoder::jsonToBinary(const QByteArray &json, const QProtobufMetaObject &metaObject)
+{
+    QByteArray result;
+    QProtobufByteArrayWriter writer(result);
+    dPtr->jsonToBinary(json, metaObject, writer);
+    return result;
+}
+
+void QProtobufJsonTranscoder::jsonToBinary(const QByteArray &json, const QProtobufMetaObject &metaObject, QProtobufWriter &writer)
+{
+    dPtr->jsonToBinary(json, metaObject, writer);
+}
+
+QByteArray QProtobufJsonTranscoder::binaryToJson(const QByteArray &data, const QProtobufMetaObject &metaObject)
+{
+    QByteArray result;
+    QProtobufByteArrayWriter writer(result);
+    dPtr->binaryToJson(data, metaObject, writer);
+    return result;
+}
+
+void QProtobufJsonTranscoder::binaryToJson(const QByteArray &data, const QProtobufMetaObject &metaObject, QProtobufWriter &writer)
+{
+    dPtr->binaryToJson(data, metaObject, writer);
+}
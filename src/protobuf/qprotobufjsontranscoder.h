@@ -0,0 +1,112 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once //QProtobufJsonTranscoder
+
+#include <QByteArray>
+
+#include <memory>
+
+#include "qprotobufmetaobject.h"
+#include "qprotobufwriter.h"
+#include "qtprotobufglobal.h"
+
+namespace QtProtobuf {
+
+class QProtobufJsonTranscoderPrivate;
+
+/*!
+ * \ingroup QtProtobuf
+ * \brief The QProtobufJsonTranscoder class converts JSON to protobuf wire format and back without message objects
+ *
+ * \details Transcoder walks JSON text or serialized message once and writes result directly to the output.
+ *          Message objects, QVariant values and intermediate byte arrays per field are not created, field layout
+ *          is taken from QProtobufMetaObject of message type and cached once per type.
+ *          JSON produced by transcoder is compatible with QProtobufJsonSerializer and JSON accepted by transcoder
+ *          is superset of QProtobufJsonSerializer output: numbers could be quoted, enum values could be passed
+ *          as names or numbers, NaN and Infinity are accepted for floating point fields.
+ *          \code{.cpp}
+ *          QProtobufJsonTranscoder transcoder;
+ *          QByteArray binary = transcoder.jsonToBinary<MyMessage>(request);
+ *          ...
+ *          QByteArray json = transcoder.binaryToJson<MyMessage>(response);
+ *          \endcode
+ *
+ *          Message types and types of nested messages should be registered using qRegisterProtobufTypes()
+ *          before transcoding. Fields of Qt types, that are provided by QtProtobufQtTypes library, are not supported.
+ *          Transcoder keeps reusable scratch buffers, so it's not thread-safe. Use separate transcoder per thread.
+ *          Invalid input causes std::invalid_argument exception, truncated binary input causes std::out_of_range
+ *          exception.
+ */
+class Q_PROTOBUF_EXPORT QProtobufJsonTranscoder final
+{
+    Q_DISABLE_COPY_MOVE(QProtobufJsonTranscoder)
+public:
+    QProtobufJsonTranscoder();
+    ~QProtobufJsonTranscoder();
+
+    /*!
+     * \brief Converts \a json representation of message T to protobuf wire format
+     */
+    template<typename T>
+    QByteArray jsonToBinary(const QByteArray &json) {
+        return jsonToBinary(json, T::protobufMetaObject);
+    }
+
+    /*!
+     * \brief Converts message T serialized to protobuf wire format in \a data to JSON
+     */
+    template<typename T>
+    QByteArray binaryToJson(const QByteArray &data) {
+        return binaryToJson(data, T::protobufMetaObject);
+    }
+
+    /*!
+     * \brief Converts \a json representation of message described by \a metaObject to protobuf wire format
+     */
+    QByteArray jsonToBinary(const QByteArray &json, const QProtobufMetaObject &metaObject);
+
+    /*!
+     * \brief Converts \a json representation of message described by \a metaObject to protobuf wire format and
+     *        writes result to \a writer
+     */
+    void jsonToBinary(const QByteArray &json, const QProtobufMetaObject &metaObject, QProtobufWriter &writer);
+
+    /*!
+     * \brief Converts message described by \a metaObject and serialized to protobuf wire format in \a data to JSON
+     */
+    QByteArray binaryToJson(const QByteArray &data, const QProtobufMetaObject &metaObject);
+
+    /*!
+     * \brief Converts message described by \a metaObject and serialized to protobuf wire format in \a data to JSON and
+     *        writes result to \a writer
+     */
+    void binaryToJson(const QByteArray &data, const QProtobufMetaObject &metaObject, QProtobufWriter &writer);
+
+private:
+    std::unique_ptr<QProtobufJsonTranscoderPrivate> dPtr;
+};
+
+}
@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once //QProtobufLazyMessagePointer
+
+#include <memory>
+
+namespace QtProtobuf {
+
+/*!
+ * \ingroup QtProtobuf
+ * \brief The QProtobufLazyMessagePointer class owns singular message field of type T, that is allocated
+ *        on first mutable access
+ *
+ * \details Unset field reads as shared immutable default instance of T, so construction of message doesn't
+ *          allocate nested messages. Unset and default fields are equal, copies of unset field stay unset.
+ *          Is part of autogenerated classes.
+ */
+template<typename T>
+class QProtobufLazyMessagePointer
+{
+public:
+    QProtobufLazyMessagePointer() = default;
+    /*!
+     * \brief Takes ownership of \a value
+     */
+    explicit QProtobufLazyMessagePointer(T *value) : m_value(value) {}
+    QProtobufLazyMessagePointer(const QProtobufLazyMessagePointer &other) : m_value(other.m_value ? new T(*other.m_value) : nullptr) {}
+    QProtobufLazyMessagePointer(QProtobufLazyMessagePointer &&other) = default;
+    ~QProtobufLazyMessagePointer() = default;
+
+    QProtobufLazyMessagePointer &operator =(const QProtobufLazyMessagePointer &other) {
+        if (!other.m_value) {
+            m_value.reset();
+        } else if (m_value) {
+            //Allocated instance is kept to not invalidate pointers to it
+            *m_value = *other.m_value;
+        } else {
+            m_value.reset(new T(*other.m_value));
+        }
+        return *this;
+    }
+    QProtobufLazyMessagePointer &operator =(QProtobufLazyMessagePointer &&other) = default;
+
+    /*!
+     * \brief Returns true if field is allocated
+     */
+    bool isSet() const { return m_value != nullptr; }
+
+    /*!
+     * \brief Returns field value or default instance of T if field is not set. Never allocates
+     */
+    const T &value() const { return m_value ? *m_value : defaultInstance(); }
+
+    /*!
+     * \brief Returns pointer to mutable field, allocates it if field is not set
+     */
+    T *data() const {
+        if (!m_value) {
+            m_value.reset(new T);
+        }
+        return m_value.get();
+    }
+
+    /*!
+     * \brief Replaces field with \a value and takes ownership of it. Unsets field if \a value is nullptr
+     */
+    void reset(T *value = nullptr) { m_value.reset(value); }
+
+    /*!
+     * \brief Returns shared immutable instance of T with default values
+     */
+    static const T &defaultInstance() {
+        static const T instance;
+        return instance;
+    }
+
+private:
+    //Field is allocated by const getters of pointer properties, that are used by meta-object system
+    mutable std::unique_ptr<T> m_value;
+};
+
+}
@@ -27,8 +27,13 @@
 
 #include "qtprotobufglobal.h"
 #include "qtprotobuftypes.h"
+#include "qprotobuffieldpresence.h"
 
 #include <QMetaObject>
+#include <QMetaProperty>
+#include <QObject>
+#include <QVariant>
+
 namespace QtProtobuf {
 
 /*!
@@ -39,11 +44,42 @@ namespace QtProtobuf {
 class Q_PROTOBUF_EXPORT QProtobufMetaObject
 {
 public:
-    QProtobufMetaObject(const QMetaObject &staticMetaObject, const QProtobufPropertyOrdering &propertyOrdering);
+    /*!
+     * \brief Constructs meta object of message. Constructor is constexpr, so meta objects of generated messages are
+     *        constant initialized and don't require any code execution at startup
+     */
+    constexpr QProtobufMetaObject(const QMetaObject &_staticMetaObject, const QProtobufPropertyOrdering &_propertyOrdering,
+                                  bool _isGadget, const QProtobufFieldPresenceInfo *_presenceInfo = nullptr)
+        : staticMetaObject(_staticMetaObject)
+        , propertyOrdering(_propertyOrdering)
+        , presenceInfo(_presenceInfo)
+        , m_isGadget(_isGadget) {}
+
     const QMetaObject &staticMetaObject;
     const QProtobufPropertyOrdering &propertyOrdering;
+    const QProtobufFieldPresenceInfo *presenceInfo;/*!< optional, presence bitmap of message, nullptr if message has no fields */
+
+    /*!
+     * \brief Returns true if message is Q_GADGET value type, false if message is inherited of QObject
+     */
+    bool isGadget() const { return m_isGadget; }
+
+    /*!
+     * \brief Reads value of \a property of message \a object, that is either QObject or gadget
+     */
+    QVariant readProperty(const void *object, const QMetaProperty &property) const {
+        return m_isGadget ? property.readOnGadget(object) : property.read(static_cast<const QObject *>(object));
+    }
+
+    /*!
+     * \brief Writes \a value to \a property of message \a object, that is either QObject or gadget
+     */
+    bool writeProperty(void *object, const QMetaProperty &property, const QVariant &value) const {
+        return m_isGadget ? property.writeOnGadget(object, value) : property.write(static_cast<QObject *>(object), value);
+    }
 private:
     QProtobufMetaObject();
+    bool m_isGadget;
 };
 
 }
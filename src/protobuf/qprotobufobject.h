@@ -27,6 +27,9 @@
 
 #include "qabstractprotobufserializer.h"
 #include "qprotobufmetaobject.h"
+#include "qprotobuflazymessagepointer.h"
+#include "qprotobuffieldpresence.h"
+#include "qprotobufoneof.h"
 #include <unordered_map>
 
 /*!
@@ -37,19 +40,20 @@
 /*!
  * \ingroup QtProtobuf
  * \def Q_DECLARE_PROTOBUF_SERIALIZERS(T)
- *      Defines serializers for type T inherited of QObject. Is part of autogenerated by qtprogobufgenerator classes
+ *      Defines serializers for type T inherited of QObject or Q_GADGET type T. Is part of autogenerated by qtprogobufgenerator classes
  */
 
 #define Q_DECLARE_PROTOBUF_SERIALIZERS(T)\
     public:\
         QByteArray serialize(QtProtobuf::QAbstractProtobufSerializer *serializer) const { Q_ASSERT_X(serializer != nullptr, "QProtobufObject", "Serializer is null"); return serializer->serialize<T>(this); }\
+        bool serializeTo(QtProtobuf::QAbstractProtobufSerializer *serializer, QIODevice *device) const { Q_ASSERT_X(serializer != nullptr, "QProtobufObject", "Serializer is null"); return serializer->serializeTo<T>(this, device); }\
         void deserialize(QtProtobuf::QAbstractProtobufSerializer *serializer, const QByteArray &array) { Q_ASSERT_X(serializer != nullptr, "QProtobufObject", "Serializer is null"); serializer->deserialize<T>(this, array); }\
     private:
 
 /*!
  * \ingroup QtProtobuf
  * \def Q_PROTOBUF_OBJECT
- *      Declares propertyOrdering for type T inherited of QObject. Is part of autogenerated by qtprogobufgenerator classes
+ *      Declares propertyOrdering for type T inherited of QObject or Q_GADGET type T. Is part of autogenerated by qtprogobufgenerator classes
  */
 
 #define Q_PROTOBUF_OBJECT\
@@ -0,0 +1,190 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once //QProtobufOneof
+
+#include <QVariant>
+
+#include <type_traits>
+#include <utility>
+
+namespace QtProtobuf {
+
+/*!
+ * \ingroup QtProtobuf
+ * \brief The QProtobufOneof class is single storage slot of protobuf oneof, that holds value of one field at a time
+ *
+ * \details Slot is tagged by field number of active field, zero field number means that none of oneof fields is set.
+ *          Value of active field is kept in QVariant, so only active field occupies memory. Inactive fields are read
+ *          as default value of their type. Setting of field replaces value of previously active field. Copies of
+ *          oneof don't share value of active field, like copies of singular message fields.
+ *          Is part of autogenerated classes.
+ */
+class QProtobufOneof
+{
+public:
+    QProtobufOneof() : m_fieldNumber(0), m_equals(nullptr) {}
+    QProtobufOneof(const QProtobufOneof &other) : m_fieldNumber(other.m_fieldNumber)
+      , m_value(other.m_value)
+      , m_equals(other.m_equals) {
+        //Value is detached, so pointer properties of message copies refer to their own instances
+        m_value.detach();
+    }
+    QProtobufOneof(QProtobufOneof &&other) : m_fieldNumber(std::exchange(other.m_fieldNumber, 0))
+      , m_value(std::move(other.m_value))
+      , m_equals(std::exchange(other.m_equals, nullptr)) {
+        other.m_value.clear();
+    }
+    ~QProtobufOneof() = default;
+
+    QProtobufOneof &operator =(const QProtobufOneof &other) {
+        if (this != &other) {
+            m_fieldNumber = other.m_fieldNumber;
+            m_value = other.m_value;
+            m_equals = other.m_equals;
+            m_value.detach();
+        }
+        return *this;
+    }
+    QProtobufOneof &operator =(QProtobufOneof &&other) {
+        if (this != &other) {
+            m_fieldNumber = std::exchange(other.m_fieldNumber, 0);
+            m_value = std::move(other.m_value);
+            m_equals = std::exchange(other.m_equals, nullptr);
+            other.m_value.clear();
+        }
+        return *this;
+    }
+
+    /*!
+     * \brief Returns field number of active field or 0 if none of oneof fields is set
+     */
+    int fieldNumber() const { return m_fieldNumber; }
+
+    /*!
+     * \brief Returns true if field with \a fieldNumber is active
+     */
+    bool holds(int fieldNumber) const { return m_fieldNumber != 0 && m_fieldNumber == fieldNumber; }
+
+    /*!
+     * \brief Returns true if field with \a fieldNumber is active and holds \a value
+     */
+    template<typename T>
+    bool isEqual(int fieldNumber, const T &value) const { return holds(fieldNumber) && *storedData<T>() == value; }
+
+    /*!
+     * \brief Returns value of field with \a fieldNumber or default value of T if field is not active
+     */
+    template<typename T>
+    const T &value(int fieldNumber) const { return holds(fieldNumber) ? *storedData<T>() : defaultValue<T>(); }
+
+    /*!
+     * \brief Returns pointer to value of field with \a fieldNumber or nullptr if field is not active
+     *
+     * \details Is used by pointer properties of message fields, that are read by meta-object system. Neither
+     *          activates field nor detaches its value.
+     */
+    template<typename T>
+    const T *constData(int fieldNumber) const { return holds(fieldNumber) ? storedData<T>() : nullptr; }
+
+    /*!
+     * \brief Returns pointer to mutable value of field with \a fieldNumber. Makes field active with default value
+     *        of T if it's not active
+     */
+    template<typename T>
+    T *data(int fieldNumber) {
+        if (!holds(fieldNumber)) {
+            setValue<T>(fieldNumber, defaultValue<T>());
+        }
+        return static_cast<T *>(m_value.data());
+    }
+
+    /*!
+     * \brief Makes field with \a fieldNumber active and sets its \a value. Value of previously active field is released
+     */
+    template<typename T>
+    void setValue(int fieldNumber, const T &value) {
+        m_fieldNumber = fieldNumber;
+        m_value = QVariant::fromValue<T>(value);
+        m_equals = &equals<T>;
+    }
+
+    /*!
+     * \brief Makes field with \a fieldNumber active and moves \a value to its storage
+     *
+     * \details QVariant accepts values by const reference only, so default value of T is stored if field is not
+     *          active and \a value is moved over it.
+     */
+    template<typename T,
+             typename std::enable_if_t<!std::is_reference<T>::value, int> = 0>
+    void setValue(int fieldNumber, T &&value) {
+        if (!holds(fieldNumber)) {
+            m_fieldNumber = fieldNumber;
+            m_value = QVariant::fromValue<T>(T());
+            m_equals = &equals<T>;
+        }
+        *static_cast<T *>(m_value.data()) = std::move(value);
+    }
+
+    /*!
+     * \brief Releases value of active field, none of oneof fields is set after call
+     */
+    void clear() {
+        m_fieldNumber = 0;
+        m_value.clear();
+        m_equals = nullptr;
+    }
+
+    bool operator ==(const QProtobufOneof &other) const {
+        return m_fieldNumber == other.m_fieldNumber
+                && (m_fieldNumber == 0 || m_equals(m_value, other.m_value));
+    }
+
+    bool operator !=(const QProtobufOneof &other) const {
+        return !operator ==(other);
+    }
+
+private:
+    template<typename T>
+    const T *storedData() const { return static_cast<const T *>(m_value.constData()); }
+
+    template<typename T>
+    static const T &defaultValue() {
+        static const T instance{};
+        return instance;
+    }
+
+    //QVariant compares user types without registered comparators bytewise, so values are compared as type T
+    template<typename T>
+    static bool equals(const QVariant &left, const QVariant &right) {
+        return *static_cast<const T *>(left.constData()) == *static_cast<const T *>(right.constData());
+    }
+
+    int m_fieldNumber;
+    QVariant m_value;
+    bool (*m_equals)(const QVariant &, const QVariant &);
+};
+
+}
@@ -0,0 +1,253 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "qprotobufrecordfilereader.h"
+#include "qprotobufsizeprefix_p.h"
+
+#include <QDataStream>
+#include <QSaveFile>
+
+#include <stdexcept>
+
+using namespace QtProtobuf;
+
+namespace {
+const quint32 IndexMagic = 0x51504249; //"QPBI"
+const quint32 IndexVersion = 1;
+}
+
+QProtobufRecordFileReader::QProtobufRecordFileReader(QAbstractProtobufSerializer *serializer, const QString &fileName) : m_serializer(serializer)
+  , m_file(fileName)
+  , m_data(nullptr)
+  , m_size(0)
+  , m_indexValid(false)
+{
+    Q_ASSERT_X(serializer != nullptr, "QProtobufRecordFileReader", "Serializer is null");
+}
+
+QProtobufRecordFileReader::~QProtobufRecordFileReader()
+{
+    close();
+}
+
+bool QProtobufRecordFileReader::open()
+{
+    close();
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qProtoWarning() << "Unable to open" << m_file.fileName() << m_file.errorString();
+        return false;
+    }
+
+    m_size = m_file.size();
+    if (m_size == 0) {
+        //Empty files can't be mapped, but still are valid record files
+        static const uchar empty = 0;
+        m_data = &empty;
+        return true;
+    }
+
+    m_data = m_file.map(0, m_size);
+    if (m_data == nullptr) {
+        qProtoWarning() << "Unable to map" << m_file.fileName() << m_file.errorString();
+        m_file.close();
+        return false;
+    }
+    return true;
+}
+
+void QProtobufRecordFileReader::close()
+{
+    if (m_data != nullptr && m_size > 0) {
+        m_file.unmap(const_cast<uchar *>(m_data));
+    }
+    m_file.close();
+    m_data = nullptr;
+    m_size = 0;
+    m_offsets.clear();
+    m_indexValid = false;
+}
+
+QByteArray QProtobufRecordFileReader::recordAt(qint64 offset, qint64 *nextOffset) const
+{
+    if (m_data == nullptr || offset < 0 || offset >= m_size) {
+        throw std::out_of_range("Record offset is out of file range");
+    }
+
+    QProtobufSizePrefixDecoder prefix;
+    qint64 position = offset;
+    do {
+        if (position >= m_size) {
+            throw std::out_of_range("Record size is truncated. Seems file is broken");
+        }
+    } while (!prefix.addByte(m_data[position++]));
+
+    if (prefix.size() > m_size - position) {
+        throw std::out_of_range("Record is truncated. Seems file is broken");
+    }
+
+    if (nextOffset != nullptr) {
+        *nextOffset = position + prefix.size();
+    }
+    //Mapped memory is not changed and stays valid until reader is closed, so data is not copied
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(m_data + position), prefix.size());
+}
+
+QByteArray QProtobufRecordFileReader::record(int index) const
+{
+    if (index < 0 || index >= recordCount()) {
+        throw std::out_of_range("Record index is out of range");
+    }
+    return recordAt(m_offsets[static_cast<size_t>(index)]);
+}
+
+bool QProtobufRecordFileReader::buildIndex()
+{
+    m_offsets.clear();
+    m_indexValid = false;
+    if (m_data == nullptr) {
+        return false;
+    }
+
+    qint64 offset = 0;
+    try {
+        while (offset < m_size) {
+            m_offsets.push_back(offset);
+            recordAt(offset, &offset);
+        }
+    } catch (const std::exception &e) {
+        qProtoWarning() << "Unable to build index for" << m_file.fileName() << e.what();
+        m_offsets.clear();
+        return false;
+    }
+
+    m_indexValid = true;
+    return true;
+}
+
+bool QProtobufRecordFileReader::loadIndex(const QString &fileName)
+{
+    m_offsets.clear();
+    m_indexValid = false;
+    if (m_data == nullptr) {
+        return false;
+    }
+
+    QFile indexFile(indexFileName(fileName));
+    if (!indexFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&indexFile);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 size = 0;
+    quint64 count = 0;
+    stream >> magic >> version >> size >> count;
+    //Index file that was created for other version of records file is ignored
+    if (stream.status() != QDataStream::Ok || magic != IndexMagic || version != IndexVersion
+            || size != m_size || count > static_cast<quint64>(indexFile.size() / sizeof(qint64))) {
+        qProtoWarning() << "Index" << indexFile.fileName() << "doesn't match" << m_file.fileName();
+        return false;
+    }
+
+    m_offsets.resize(static_cast<size_t>(count));
+    qint64 previous = -1;
+    for (auto &offset : m_offsets) {
+        stream >> offset;
+        if (offset <= previous || offset >= m_size) {
+            qProtoWarning() << "Index" << indexFile.fileName() << "is broken";
+            m_offsets.clear();
+            return false;
+        }
+        previous = offset;
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        m_offsets.clear();
+        return false;
+    }
+
+    //Stale index may have increasing offsets, that don't point to record boundaries. Each record must end
+    //exactly where the next one starts, only size prefixes are read for that
+    try {
+        qint64 end = 0;
+        for (size_t i = 0; i < m_offsets.size(); i++) {
+            if (m_offsets[i] != end) {
+                throw std::invalid_argument("Record offset doesn't match end of previous record");
+            }
+            recordAt(m_offsets[i], &end);
+        }
+        if (end != m_size) {
+            throw std::invalid_argument("Index doesn't cover complete file");
+        }
+    } catch (const std::exception &e) {
+        qProtoWarning() << "Index" << indexFile.fileName() << "doesn't match" << m_file.fileName() << e.what();
+        m_offsets.clear();
+        return false;
+    }
+
+    m_indexValid = true;
+    return true;
+}
+
+bool QProtobufRecordFileReader::saveIndex(const QString &fileName) const
+{
+    if (!m_indexValid) {
+        return false;
+    }
+
+    QSaveFile indexFile(indexFileName(fileName));
+    if (!indexFile.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&indexFile);
+    stream << IndexMagic << IndexVersion << m_size << static_cast<quint64>(m_offsets.size());
+    for (auto offset : m_offsets) {
+        stream << offset;
+    }
+    return stream.status() == QDataStream::Ok && indexFile.commit();
+}
+
+QList<QPair<int, int>> QProtobufRecordFileReader::partitions(int count) const
+{
+    QList<QPair<int, int>> result;
+    int records = recordCount();
+    if (count <= 0 || records == 0) {
+        return result;
+    }
+
+    count = qMin(count, records);
+    for (int i = 0; i < count; i++) {
+        result.append({static_cast<int>(static_cast<qint64>(records) * i / count),
+                       static_cast<int>(static_cast<qint64>(records) * (i + 1) / count)});
+    }
+    return result;
+}
+
+QString QProtobufRecordFileReader::indexFileName(const QString &indexFileName) const
+{
+    return indexFileName.isEmpty() ? m_file.fileName() + QLatin1String(".idx") : indexFileName;
+}
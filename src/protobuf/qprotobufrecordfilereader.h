@@ -0,0 +1,141 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once //QProtobufRecordFileReader
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QPair>
+#include <QString>
+
+#include <vector>
+
+#include "qabstractprotobufserializer.h"
+#include "qtprotobufglobal.h"
+
+namespace QtProtobuf {
+
+/*!
+ * \ingroup QtProtobuf
+ * \brief The QProtobufRecordFileReader class provides random access to files of length-delimited messages
+ *
+ * \details File is mapped to memory using QFileDevice::map, records are exposed as QByteArray views
+ *          that refer to mapped memory without copying. Views stay valid until reader is closed.
+ *          Record offsets index is built by scanning of file or loaded from sidecar index file, that
+ *          makes access to record by number O(1) and allows to split file to partitions for parallel processing.
+ *          Records are decoded using given serializer.
+ *          \code{.cpp}
+ *          QProtobufRecordFileReader reader(&serializer, "records.bin");
+ *          if (reader.open() && (reader.loadIndex() || reader.buildIndex())) {
+ *              MyMessage message;
+ *              reader.read(reader.recordCount() - 1, &message);
+ *          }
+ *          \endcode
+ * \see QProtobufDelimitedWriter
+ */
+class Q_PROTOBUF_EXPORT QProtobufRecordFileReader
+{
+    Q_DISABLE_COPY_MOVE(QProtobufRecordFileReader)
+public:
+    QProtobufRecordFileReader(QAbstractProtobufSerializer *serializer, const QString &fileName);
+    ~QProtobufRecordFileReader();
+
+    /*!
+     * \brief Opens and maps file to memory
+     * \return false if file could not be opened or mapped
+     */
+    bool open();
+    /*!
+     * \brief Unmaps and closes file. All record views become invalid
+     */
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    /*!
+     * \brief Builds record offsets index by scanning of complete file
+     * \return false if file is not open or contains truncated/invalid record
+     */
+    bool buildIndex();
+    /*!
+     * \brief Loads record offsets index from sidecar file \a indexFileName. "<fileName>.idx" is used by default
+     * \details Offsets are checked to be record boundaries of records file, that cover it completely
+     * \return false if index file doesn't exist or doesn't match records file
+     */
+    bool loadIndex(const QString &indexFileName = {});
+    /*!
+     * \brief Saves record offsets index to sidecar file \a indexFileName. "<fileName>.idx" is used by default
+     */
+    bool saveIndex(const QString &indexFileName = {}) const;
+    bool hasIndex() const { return m_indexValid; }
+
+    /*!
+     * \brief Returns number of records in file. Index is required
+     */
+    int recordCount() const { return static_cast<int>(m_offsets.size()); }
+
+    /*!
+     * \brief Returns view to serialized message with number \a index. Index is required
+     * \throws std::out_of_range if \a index is out of range
+     */
+    QByteArray record(int index) const;
+
+    /*!
+     * \brief Returns view to serialized message that starts at \a offset of file. Is used for sequential reading
+     *        without index
+     * \param[in] offset Offset of record size prefix in file
+     * \param[out] nextOffset Offset of next record
+     * \throws std::out_of_range if record is truncated
+     * \throws std::invalid_argument if record size prefix is invalid or exceeds INT_MAX
+     */
+    QByteArray recordAt(qint64 offset, qint64 *nextOffset = nullptr) const;
+
+    /*!
+     * \brief Deserializes record with number \a index to \a message. Index is required
+     */
+    template<typename T>
+    void read(int index, T *message) const {
+        Q_ASSERT(message != nullptr);
+        m_serializer->deserialize<T>(message, record(index));
+    }
+
+    /*!
+     * \brief Splits records to \a count partitions of close size
+     * \return List of [first, last) record number ranges
+     */
+    QList<QPair<int, int>> partitions(int count) const;
+
+private:
+    QString indexFileName(const QString &indexFileName) const;
+
+    QAbstractProtobufSerializer *m_serializer;
+    QFile m_file;
+    const uchar *m_data;
+    qint64 m_size;
+    std::vector<qint64> m_offsets;
+    bool m_indexValid;
+};
+
+}
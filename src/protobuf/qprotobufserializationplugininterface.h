@@ -33,6 +33,7 @@
 
 #include "qtprotobufglobal.h"
 #include "qabstractprotobufserializer.h"
+#include "qabstractprotobufsinkserializer.h"
 
 namespace QtProtobuf {
 
@@ -94,6 +95,46 @@ public:
     virtual std::shared_ptr<QtProtobuf::QAbstractProtobufSerializer> serializer(const QString &serializerName) = 0;
 };
 
+/*!
+ * \ingroup QtProtobuf
+ * \brief The QProtobufSinkSerializationPluginInterface class is second generation of serialization plugin interface.
+ *
+ * \details Plugin provides serializers inherited of QAbstractProtobufSinkSerializer, so serialization core passes
+ *          data sink to serializers of plugin and serialized data is not collected in intermediate byte arrays.
+ *          Plugin is declared same way as plugin with QProtobufSerializationPluginInterface, but with different
+ *          interface identifier:
+ *
+ *          \code{.cpp}
+ *          class SERIALIZATIONSHARED_EXPORT QtSinkSerializationPlugin : public QObject, QtProtobuf::QProtobufSinkSerializationPluginInterface
+ *          {
+ *              Q_OBJECT
+ *              Q_PLUGIN_METADATA(IID SinkSerializatorInterface_iid FILE "serializeinfo.json")
+ *              Q_INTERFACES(QtProtobuf::QProtobufSinkSerializationPluginInterface)
+ *
+ *          public:
+ *              std::shared_ptr<QtProtobuf::QAbstractProtobufSinkSerializer> sinkSerializer(const QString &serializerName) override;
+ *          }
+ *          \endcode
+ *
+ *          Plugins that implement QProtobufSerializationPluginInterface are still loaded, their serializers are
+ *          adapted by default implementations of write family methods of QAbstractProtobufSerializer.
+ */
+class Q_PROTOBUF_EXPORT QProtobufSinkSerializationPluginInterface
+{
+public:
+    explicit QProtobufSinkSerializationPluginInterface() = default;
+    virtual ~QProtobufSinkSerializationPluginInterface() = default;
+
+    /*!
+     * \brief Method finds and returns pointer to specific serialization implementation by serializer name, otherwise returns nullptr.
+     * \param[in] name of specific serializer that should be supplied by plugin.
+     * \return An object to serializer realization.
+     */
+    virtual std::shared_ptr<QtProtobuf::QAbstractProtobufSinkSerializer> sinkSerializer(const QString &serializerName) = 0;
+};
+
 }
 #define SerializatorInterface_iid "com.qtprotobuf.QProtobufSerializationPluginInterface"
 Q_DECLARE_INTERFACE(QtProtobuf::QProtobufSerializationPluginInterface, SerializatorInterface_iid)
+#define SinkSerializatorInterface_iid "com.qtprotobuf.QProtobufSinkSerializationPluginInterface"
+Q_DECLARE_INTERFACE(QtProtobuf::QProtobufSinkSerializationPluginInterface, SinkSerializatorInterface_iid)
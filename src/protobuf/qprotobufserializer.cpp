@@ -28,9 +28,83 @@
 
 #include "qprotobufmetaproperty.h"
 #include "qprotobufmetaobject.h"
+#include "qprotobufsnapshotregistry_p.h"
+
+#include <QtEndian>
+#include <QtAlgorithms>
+#include <QVarLengthArray>
+#include <QIODevice>
 
 using namespace QtProtobuf;
 
+namespace {
+
+/*!
+ * \private
+ * \brief The SizeCounter is writer that only counts written bytes. Is used to precalculate sizes of nested messages
+ */
+class SizeCounter final : public QProtobufWriter
+{
+public:
+    int size() const { return m_size; }
+
+protected:
+    void writeData(const char */*data*/, int size) override { m_size += size; }
+
+private:
+    int m_size = 0;
+};
+
+/*!
+ * \private
+ * \brief Returns serialized default value of field with \a wireType. Is used for fields with explicit presence,
+ *        that are set to default value
+ */
+QByteArray defaultValuePayload(WireTypes wireType)
+{
+    switch (wireType) {
+    case Fixed32:
+        return QByteArray(4, '\0');
+    case Fixed64:
+        return QByteArray(8, '\0');
+    default:
+        //Zero varint and zero length of length delimited field are both single zero byte
+        return QByteArray(1, '\0');
+    }
+}
+
+/*!
+ * \private
+ * \brief Calls \a visitor with property index, field number and explicit presence flag of each \a object field,
+ *        that is to be serialized. If message has presence bitmap, only set fields are visited in declaration
+ *        order, bitmap words are scanned by lowest set bit
+ */
+template <typename Visitor>
+void forEachSerializedField(const void *object, const QProtobufMetaObject &metaObject, Visitor visitor)
+{
+    const QProtobufFieldPresenceInfo *presenceInfo = metaObject.presenceInfo;
+    if (presenceInfo == nullptr) {
+        for (const auto &field : metaObject.propertyOrdering) {
+            visitor(field.second, field.first, false);
+        }
+        return;
+    }
+
+    const quint32 *bits = presenceInfo->bits(object);
+    int propertyOffset = metaObject.staticMetaObject.propertyOffset();
+    for (int word = 0; word * 32 < presenceInfo->fieldCount; ++word) {
+        quint32 wordBits = bits[word];
+        while (wordBits != 0) {
+            int index = word * 32 + static_cast<int>(qCountTrailingZeroBits(wordBits));
+            wordBits &= wordBits - 1;
+            bool explicitPresence = (presenceInfo->explicitPresence[word] & (1u << (index & 31))) != 0;
+            visitor(propertyOffset + index, presenceInfo->fieldNumbers[index], explicitPresence);
+        }
+    }
+}
+
+}
+
 template<>
 QByteArray QProtobufSerializerPrivate::serializeListType<QByteArray>(const QByteArrayList &listValue, int &outFieldIndex)
 {
@@ -78,48 +152,56 @@ QProtobufSerializer::QProtobufSerializer() : dPtr(new QProtobufSerializerPrivate
 {
 }
 
-QByteArray QProtobufSerializer::serializeMessage(const QObject *object, const QProtobufMetaObject &metaObject) const
+QByteArray QProtobufSerializer::serializeMessage(const void *object, const QProtobufMetaObject &metaObject) const
 {
-    QByteArray result;
-    for (const auto &field : metaObject.propertyOrdering) {
-        int propertyIndex = field.second;
-        int fieldIndex = field.first;
-        Q_ASSERT_X(fieldIndex < 536870912 && fieldIndex > 0, "", "fieldIndex is out of range");
-        QMetaProperty metaProperty = metaObject.staticMetaObject.property(propertyIndex);
-        const char *propertyName = metaProperty.name();
-        QVariant propertyValue = object->property(propertyName);
-        result.append(dPtr->serializeProperty(propertyValue, QProtobufMetaProperty(metaProperty, fieldIndex)));
-    }
+    return dPtr->serializeMessage(object, metaObject);
+}
 
-    return result;
+bool QProtobufSerializer::serializeMessageTo(const void *object, const QProtobufMetaObject &metaObject, QIODevice *device) const
+{
+    return dPtr->serializeMessageTo(object, metaObject, device);
 }
 
-void QProtobufSerializer::deserializeMessage(QObject *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const
+void QProtobufSerializer::deserializeMessage(void *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const
 {
-    for (QProtobufSelfcheckIterator it(data); it != data.end();) {
-        dPtr->deserializeProperty(object, metaObject, it);
-    }
+    dPtr->deserializeMessage(object, metaObject, data);
 }
 
-QByteArray QProtobufSerializer::serializeObject(const QObject *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const
+QByteArray QProtobufSerializer::serializeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const
 {
-    QByteArray result = QProtobufSerializerPrivate::encodeHeader(metaProperty.protoFieldIndex(), LengthDelimited);
-    result.append(QProtobufSerializerPrivate::prependLengthDelimitedSize(serializeMessage(object, metaObject)));
+    QByteArray result;
+    QProtobufByteArrayWriter writer(result);
+    writeObject(object, metaObject, metaProperty, writer);
     return result;
 }
 
-void QProtobufSerializer::deserializeObject(QObject *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const
+void QProtobufSerializer::writeMessage(const void *object, const QProtobufMetaObject &metaObject, QProtobufWriter &writer) const
+{
+    dPtr->writeMessage(object, metaObject, writer);
+}
+
+void QProtobufSerializer::writeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const
+{
+    dPtr->writeObject(object, metaObject, metaProperty, writer);
+}
+
+void QProtobufSerializer::deserializeObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const
 {
     QByteArray array = QProtobufSerializerPrivate::deserializeLengthDelimited(it);
     deserializeMessage(object, metaObject, array);
 }
 
-QByteArray QProtobufSerializer::serializeListObject(const QObject *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const
+QByteArray QProtobufSerializer::serializeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const
 {
     return serializeObject(object, metaObject, metaProperty);
 }
 
-bool QProtobufSerializer::deserializeListObject(QObject *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const
+void QProtobufSerializer::writeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const
+{
+    writeObject(object, metaObject, metaProperty, writer);
+}
+
+bool QProtobufSerializer::deserializeListObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const
 {
     deserializeObject(object, metaObject, it);
     return true;
@@ -176,8 +258,8 @@ void QProtobufSerializer::deserializeEnumList(QList<int64> &value, const QMetaEn
 
 QProtobufSerializerPrivate::QProtobufSerializerPrivate(QProtobufSerializer *q) : q_ptr(q)
 {
-    //if handlers is not empty intialization already done
-    if (handlers.empty()) {
+    //Initialization of function-local static is thread-safe, so handlers are filled exactly once
+    static const bool initialized = [] {
         wrapSerializer<float, serializeBasic, deserializeBasic<float>, Fixed32>();
         wrapSerializer<double, serializeBasic, deserializeBasic<double>, Fixed64>();
         wrapSerializer<int32, serializeBasic, deserializeBasic<int32>, Varint>();
@@ -208,11 +290,25 @@ QProtobufSerializerPrivate::QProtobufSerializerPrivate(QProtobufSerializer *q) :
         wrapSerializer<uint64List, serializeListType, deserializeList<uint64>, LengthDelimited>();
         wrapSerializer<QStringList, QStringList, serializeListType<QString>, deserializeList<QString>, LengthDelimited>();
         wrapSerializer<QByteArrayList, serializeListType, deserializeList<QByteArray>, LengthDelimited>();
-    }
+        return true;
+    }();
+    Q_UNUSED(initialized);
 }
 
 void QProtobufSerializerPrivate::skipVarint(QProtobufSelfcheckIterator &it)
 {
+    //Look for varint terminator, byte with most significant bit unset, in 8 bytes chunks
+    constexpr quint64 continuationBits = 0x8080808080808080ULL;
+    while (it.size() >= static_cast<int>(sizeof(quint64))) {
+        quint64 chunk = qFromLittleEndian<quint64>(it.data());
+        quint64 terminators = ~chunk & continuationBits;
+        if (terminators != 0) {
+            it += qCountTrailingZeroBits(terminators) / 8 + 1;
+            return;
+        }
+        it += sizeof(quint64);
+    }
+
     while ((*it) & 0x80) {
         ++it;
     }
@@ -223,10 +319,42 @@ void QProtobufSerializerPrivate::skipLengthDelimited(QProtobufSelfcheckIterator
 {
     //Get length of lenght-delimited field
     uint32 length = QProtobufSerializerPrivate::deserializeVarintCommon<uint32>(it);
-    it += length;
+    if (length > static_cast<uint32>(it.size())) {
+        throw std::out_of_range("Container is less than required fields number. Deserialization failed");
+    }
+    it += static_cast<int>(length);
 }
 
-int QProtobufSerializerPrivate::skipSerializedFieldBytes(QProtobufSelfcheckIterator &it, WireTypes type)
+void QProtobufSerializerPrivate::skipGroup(QProtobufSelfcheckIterator &it, int fieldNumber)
+{
+    //Nested groups are tracked iteratively, to avoid recursion on malicious input
+    QVarLengthArray<int, 8> openGroups;
+    openGroups.append(fieldNumber);
+    while (!openGroups.isEmpty()) {
+        int nestedFieldNumber = QtProtobufPrivate::NotUsedFieldIndex;
+        WireTypes wireType = UnknownWireType;
+        if (!decodeHeader(it, nestedFieldNumber, wireType)) {
+            throw std::invalid_argument("Group contains invalid field header. Seems stream is broken");
+        }
+
+        switch (wireType) {
+        case WireTypes::StartGroup:
+            openGroups.append(nestedFieldNumber);
+            break;
+        case WireTypes::EndGroup:
+            if (openGroups.last() != nestedFieldNumber) {
+                throw std::invalid_argument("Group end doesn't match group start. Seems stream is broken");
+            }
+            openGroups.removeLast();
+            break;
+        default:
+            skipSerializedFieldBytes(it, wireType, nestedFieldNumber);
+            break;
+        }
+    }
+}
+
+int QProtobufSerializerPrivate::skipSerializedFieldBytes(QProtobufSelfcheckIterator &it, WireTypes type, int fieldNumber)
 {
     const auto initialIt = QByteArray::const_iterator(it);
     switch (type) {
@@ -242,6 +370,11 @@ int QProtobufSerializerPrivate::skipSerializedFieldBytes(QProtobufSelfcheckItera
     case WireTypes::LengthDelimited:
         skipLengthDelimited(it);
         break;
+    case WireTypes::StartGroup:
+        skipGroup(it, fieldNumber);
+        break;
+    case WireTypes::EndGroup:
+        throw std::invalid_argument("Unexpected group end without group start. Seems stream is broken");
     case WireTypes::UnknownWireType:
     default:
         throw std::invalid_argument("Cannot skip due to undefined length of the redundant field.");
@@ -251,7 +384,7 @@ int QProtobufSerializerPrivate::skipSerializedFieldBytes(QProtobufSelfcheckItera
 }
 
 
-QByteArray QProtobufSerializerPrivate::serializeProperty(const QVariant &propertyValue, const QProtobufMetaProperty &metaProperty)
+QByteArray QProtobufSerializerPrivate::serializeProperty(const QVariant &propertyValue, const QProtobufMetaProperty &metaProperty, bool explicitPresence)
 {
     qProtoDebug() << __func__ << "propertyValue" << propertyValue << "fieldIndex" << metaProperty.protoFieldIndex()
                   << static_cast<QMetaType::Type>(propertyValue.type());
@@ -270,15 +403,155 @@ QByteArray QProtobufSerializerPrivate::serializeProperty(const QVariant &propert
         if (fieldIndex != QtProtobufPrivate::NotUsedFieldIndex
                 && type != UnknownWireType) {
             result.prepend(QProtobufSerializerPrivate::encodeHeader(metaProperty.protoFieldIndex(), type));
+        } else if (explicitPresence && type != UnknownWireType) {
+            //Field with explicit presence is sent even if it's set to default value
+            result = QProtobufSerializerPrivate::encodeHeader(metaProperty.protoFieldIndex(), type) + defaultValuePayload(type);
         }
     } else {
         auto handler = QtProtobufPrivate::findHandler(userType);
-        handler.serializer(q_ptr, propertyValue, QProtobufMetaProperty(metaProperty, metaProperty.protoFieldIndex()), result);
+        QProtobufByteArrayWriter writer(result);
+        handler.serializer(q_ptr, propertyValue, QProtobufMetaProperty(metaProperty, metaProperty.protoFieldIndex()), writer);
+        //Enum is the only type with explicit presence, that is serialized by handler
+        if (explicitPresence && result.isEmpty()) {
+            result = QProtobufSerializerPrivate::encodeHeader(metaProperty.protoFieldIndex(), Varint) + defaultValuePayload(Varint);
+        }
     }
     return result;
 }
 
-void QProtobufSerializerPrivate::deserializeProperty(QObject *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it)
+QByteArray QProtobufSerializerPrivate::serializeMessage(const void *object, const QProtobufMetaObject &metaObject)
+{
+    QByteArray result;
+    forEachSerializedField(object, metaObject, [&](int propertyIndex, int fieldIndex, bool explicitPresence) {
+        Q_ASSERT_X(fieldIndex < 536870912 && fieldIndex > 0, "", "fieldIndex is out of range");
+        QMetaProperty metaProperty = metaObject.staticMetaObject.property(propertyIndex);
+        QVariant propertyValue = metaObject.readProperty(object, metaProperty);
+        result.append(serializeProperty(propertyValue, QProtobufMetaProperty(metaProperty, fieldIndex), explicitPresence));
+    });
+
+    return result;
+}
+
+bool QProtobufSerializerPrivate::serializeMessageTo(const void *object, const QProtobufMetaObject &metaObject, QIODevice *device)
+{
+    QProtobufDeviceWriter writer(device);
+    MessageSizes sizes;
+    writeMessage(writer, object, metaObject, sizes);
+    return writer.flush();
+}
+
+void QProtobufSerializerPrivate::deserializeMessage(void *object, const QProtobufMetaObject &metaObject, const QByteArray &data)
+{
+    if (q_ptr->parallelListThreshold() > 0 && hasRepeatedMessageFields(metaObject)) {
+        deserializeMessageIndexed(object, metaObject, data);
+        return;
+    }
+
+    for (QProtobufSelfcheckIterator it(data); it != data.end();) {
+        deserializeProperty(object, metaObject, it);
+    }
+}
+
+void QProtobufSerializerPrivate::writeMessage(const void *object, const QProtobufMetaObject &metaObject, QProtobufWriter &writer)
+{
+    MessageSizes sizes;
+    writeMessage(writer, object, metaObject, sizes);
+}
+
+void QProtobufSerializerPrivate::writeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer)
+{
+    MessageSizes sizes;
+    writeHeader(writer, metaProperty.protoFieldIndex(), LengthDelimited);
+    QByteArray *buffer = writer.buffer();
+    if (buffer == nullptr) {
+        //Size is calculated first, so message is streamed to writer after its length prefix
+        writeVarint(writer, static_cast<uint32_t>(messageSize(object, metaObject, sizes)));
+        writeMessage(writer, object, metaObject, sizes);
+        return;
+    }
+
+    //Message is serialized in place, its length prefix is inserted in front of it afterwards.
+    //It's cheaper than size calculation pass for nested messages, that are not accessible by iterators
+    writer.flushPending();
+    const int start = buffer->size();
+    writeMessage(writer, object, metaObject, sizes);
+    buffer->insert(start, serializeVarintCommon<uint32_t>(buffer->size() - start));
+}
+
+void QProtobufSerializerPrivate::writeMessage(QProtobufWriter &writer, const void *object, const QProtobufMetaObject &metaObject, MessageSizes &sizes, bool sizeOnly)
+{
+    //Fields are written in same order as serializeMessage does, to produce identical output
+    forEachSerializedField(object, metaObject, [&](int propertyIndex, int fieldIndex, bool explicitPresence) {
+        Q_ASSERT_X(fieldIndex < 536870912 && fieldIndex > 0, "", "fieldIndex is out of range");
+        QMetaProperty metaProperty = metaObject.staticMetaObject.property(propertyIndex);
+        QVariant propertyValue = metaObject.readProperty(object, metaProperty);
+        writeProperty(writer, propertyValue, QProtobufMetaProperty(metaProperty, fieldIndex), sizes, sizeOnly, explicitPresence);
+    });
+}
+
+void QProtobufSerializerPrivate::writeProperty(QProtobufWriter &writer, const QVariant &propertyValue, const QProtobufMetaProperty &metaProperty,
+                                               MessageSizes &sizes, bool sizeOnly, bool explicitPresence)
+{
+    int userType = propertyValue.userType();
+    int fieldIndex = metaProperty.protoFieldIndex();
+
+    //Raw bytes are written as is, to avoid copying of potentially large buffers.
+    //Empty bytes are skipped same way as serializeBasic does
+    if (userType == QMetaType::QByteArray) {
+        const QByteArray &value = *static_cast<const QByteArray *>(propertyValue.constData());
+        if (!value.isEmpty() || explicitPresence) {
+            writeHeader(writer, fieldIndex, LengthDelimited);
+            writeVarint(writer, static_cast<uint32_t>(value.size()));
+            writer.write(value.constData(), value.size());
+        }
+        return;
+    }
+
+    if (handlers.find(userType) == handlers.end()) {
+        auto handler = QtProtobufPrivate::findHandler(userType);
+        if (handler.iterator) {
+            handler.iterator(propertyValue, [&](const QVariant &key, const void *object, const QProtobufMetaObject &objectMetaObject) {
+                int size = messageSize(object, objectMetaObject, sizes);
+                writeHeader(writer, fieldIndex, LengthDelimited);
+                if (key.isValid()) {
+                    //Map pair is written as message with key in field 1 and value in field 2
+                    QByteArray pairPrefix = serializeProperty(key, QProtobufMetaProperty(metaProperty, 1));
+                    pairPrefix.append(encodeHeader(2, LengthDelimited));
+                    appendVarint(pairPrefix, static_cast<uint32_t>(size));
+                    writeVarint(writer, static_cast<uint32_t>(pairPrefix.size() + size));
+                    writer.write(pairPrefix);
+                } else {
+                    writeVarint(writer, static_cast<uint32_t>(size));
+                }
+                if (sizeOnly) {
+                    //Size of nested message is known already, its content is not needed to count bytes
+                    writer.write(nullptr, size);
+                } else {
+                    writeMessage(writer, object, objectMetaObject, sizes);
+                }
+            });
+            return;
+        }
+    }
+
+    //Fields of basic types and types without access to nested messages are serialized as usual
+    writer.write(serializeProperty(propertyValue, metaProperty, explicitPresence));
+}
+
+int QProtobufSerializerPrivate::messageSize(const void *object, const QProtobufMetaObject &metaObject, MessageSizes &sizes)
+{
+    auto it = sizes.constFind(object);
+    if (it != sizes.constEnd()) {
+        return *it;
+    }
+
+    SizeCounter counter;
+    writeMessage(counter, object, metaObject, sizes, true);
+    sizes.insert(object, counter.size());
+    return counter.size();
+}
+
+void QProtobufSerializerPrivate::deserializeProperty(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it)
 {
     //Each iteration we expect iterator is setup to beginning of next chunk
     int fieldNumber = QtProtobufPrivate::NotUsedFieldIndex;
@@ -291,8 +564,10 @@ void QProtobufSerializerPrivate::deserializeProperty(QObject *object, const QPro
     }
 
     auto propertyNumberIt = metaObject.propertyOrdering.find(fieldNumber);
-    if (propertyNumberIt == std::end(metaObject.propertyOrdering)) {
-        auto bytesCount = QProtobufSerializerPrivate::skipSerializedFieldBytes(it, wireType);
+    //Groups are deprecated and never generated by QtProtobuf, so they are skipped even if field number is known
+    if (propertyNumberIt == std::end(metaObject.propertyOrdering)
+            || wireType == StartGroup || wireType == EndGroup) {
+        auto bytesCount = QProtobufSerializerPrivate::skipSerializedFieldBytes(it, wireType, fieldNumber);
         qProtoWarning() << "Message received contains unexpected/optional field. WireType:" << wireType
                         << ", field number: " << fieldNumber << "Skipped:" << (bytesCount + 1) << "bytes";
         return;
@@ -305,19 +580,100 @@ void QProtobufSerializerPrivate::deserializeProperty(QObject *object, const QPro
                   << "currentByte:" << QString::number((*it), 16);
 
     QVariant newPropertyValue;
-    newPropertyValue = metaProperty.read(object);
     int userType = metaProperty.userType();
 
     //TODO: replace with some common function
     auto basicIt = handlers.find(userType);
     if (basicIt != handlers.end()) {
+        newPropertyValue = metaObject.readProperty(object, metaProperty);
         basicIt->second.deserializer(it, newPropertyValue);
     } else {
         auto handler = QtProtobufPrivate::findHandler(userType);
+        //Objects are deserialized to new instance, previous value is not read to not allocate unset message fields
+        if (handler.type != QtProtobufPrivate::ObjectHandler) {
+            newPropertyValue = metaObject.readProperty(object, metaProperty);
+        }
         handler.deserializer(q_ptr, it, newPropertyValue);
     }
 
-    metaProperty.write(object, newPropertyValue);
+    metaObject.writeProperty(object, metaProperty, newPropertyValue);
+}
+
+bool QProtobufSerializerPrivate::hasRepeatedMessageFields(const QProtobufMetaObject &metaObject)
+{
+    using Registry = QtProtobufPrivate::QProtobufSnapshotRegistry<const QProtobufMetaObject *, bool>;
+    static Registry registry;
+    {
+        const auto messages = registry.snapshot();
+        auto it = messages->find(&metaObject);
+        if (it != messages->end()) {
+            return it->second;
+        }
+    }
+
+    bool result = false;
+    for (const auto &field : metaObject.propertyOrdering) {
+        int userType = metaObject.staticMetaObject.property(field.second).userType();
+        if (handlers.find(userType) == handlers.end()
+                && QtProtobufPrivate::findHandler(userType).listDeserializer) {
+            result = true;
+            break;
+        }
+    }
+
+    registry.modify([&](Registry::Map &messages) {
+        messages.emplace(&metaObject, result);
+    });
+    return result;
+}
+
+void QProtobufSerializerPrivate::deserializeMessageIndexed(void *object, const QProtobufMetaObject &metaObject, const QByteArray &data)
+{
+    //Elements of repeated message fields are collected during first pass and deserialized at once
+    //afterwards. All other fields are deserialized as usual
+    QHash<int/*propertyIndex*/, QtProtobufPrivate::ListDeserializer> listDeserializers;
+    QHash<int/*propertyIndex*/, QVector<QByteArray>> listElements;
+    for (QProtobufSelfcheckIterator it(data); it != data.end();) {
+        QProtobufSelfcheckIterator fieldIt = it;
+        int fieldNumber = QtProtobufPrivate::NotUsedFieldIndex;
+        WireTypes wireType = UnknownWireType;
+        if (decodeHeader(it, fieldNumber, wireType) && wireType == LengthDelimited) {
+            auto propertyNumberIt = metaObject.propertyOrdering.find(fieldNumber);
+            if (propertyNumberIt != std::end(metaObject.propertyOrdering)) {
+                int propertyIndex = propertyNumberIt->second;
+                auto deserializerIt = listDeserializers.find(propertyIndex);
+                if (deserializerIt == listDeserializers.end()) {
+                    int userType = metaObject.staticMetaObject.property(propertyIndex).userType();
+                    QtProtobufPrivate::ListDeserializer deserializer;
+                    if (handlers.find(userType) == handlers.end()) {
+                        deserializer = QtProtobufPrivate::findHandler(userType).listDeserializer;
+                    }
+                    deserializerIt = listDeserializers.insert(propertyIndex, deserializer);
+                }
+
+                if (*deserializerIt) {
+                    uint32 length = deserializeVarintCommon<uint32>(it);
+                    if (length > static_cast<uint32>(it.size())) {
+                        throw std::out_of_range("Container is less than required fields number. Deserialization failed");
+                    }
+                    //data is kept unchanged until the end of deserialization, so elements refer to it without copying
+                    listElements[propertyIndex].append(QByteArray::fromRawData(it.data(), static_cast<int>(length)));
+                    it += static_cast<int>(length);
+                    continue;
+                }
+            }
+        }
+
+        it = fieldIt;
+        deserializeProperty(object, metaObject, it);
+    }
+
+    for (auto elementsIt = listElements.constBegin(); elementsIt != listElements.constEnd(); ++elementsIt) {
+        QMetaProperty metaProperty = metaObject.staticMetaObject.property(elementsIt.key());
+        QVariant propertyValue = metaObject.readProperty(object, metaProperty);
+        listDeserializers.value(elementsIt.key())(q_ptr, elementsIt.value(), propertyValue);
+        metaObject.writeProperty(object, metaProperty, propertyValue);
+    }
 }
 
 void QProtobufSerializerPrivate::deserializeMapPair(QVariant &key, QVariant &value, QProtobufSelfcheckIterator &it)
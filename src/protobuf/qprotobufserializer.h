@@ -34,6 +34,12 @@ class QProtobufSerializerPrivate;
 /*!
  * \ingroup QtProtobuf
  * \brief The QProtobufSerializer class
+ *
+ * \details Nested messages, that are accessible by object iterators of serialization handlers, are written to
+ *          QProtobufWriter directly after their length prefix. Values of other property types, e.g. gadget
+ *          messages or maps of scalar values, are serialized to intermediate buffer first.
+ *          Size of each nested message is calculated before the message is written and is kept until serialization
+ *          is finished, so serializeTo() memory usage grows with number of nested messages, but not with their data.
  */
 class Q_PROTOBUF_EXPORT QProtobufSerializer : public QAbstractProtobufSerializer
 {
@@ -42,14 +48,19 @@ public:
     ~QProtobufSerializer();
 
 protected:
-    QByteArray serializeMessage(const QObject *object, const QProtobufMetaObject &metaObject) const override;
-    void deserializeMessage(QObject *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const override;
+    QByteArray serializeMessage(const void *object, const QProtobufMetaObject &metaObject) const override;
+    bool serializeMessageTo(const void *object, const QProtobufMetaObject &metaObject, QIODevice *device) const override;
+    void deserializeMessage(void *object, const QProtobufMetaObject &metaObject, const QByteArray &data) const override;
+
+    QByteArray serializeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const override;
+    void deserializeObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const override;
 
-    QByteArray serializeObject(const QObject *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const override;
-    void deserializeObject(QObject *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const override;
+    QByteArray serializeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const override;
+    bool deserializeListObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const override;
 
-    QByteArray serializeListObject(const QObject *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty) const override;
-    bool deserializeListObject(QObject *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const override;
+    void writeMessage(const void *object, const QProtobufMetaObject &metaObject, QProtobufWriter &writer) const override;
+    void writeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
+    void writeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override;
 
     QByteArray serializeMapPair(const QVariant &key, const QVariant &value, const QProtobufMetaProperty &metaProperty) const override;
     bool deserializeMapPair(QVariant &key, QVariant &value, QProtobufSelfcheckIterator &it) const override;
@@ -25,6 +25,7 @@
 
 #include <QString>
 #include <QByteArray>
+#include <QHash>
 
 #include "qprotobufselfcheckiterator.h"
 #include "qtprotobuftypes.h"
@@ -77,22 +78,61 @@ public:
                                         && std::is_unsigned<V>::value, int> = 0>
     static QByteArray serializeVarintCommon(const V &value) {
         qProtoDebug() << __func__ << "value" << value;
-        V varint = value;
         QByteArray result;
+        appendVarint(result, value);
+        return result;
+    }
 
-        while (varint != 0) {
-            //Put 7 bits to result buffer and mark as "not last" (0b10000000)
-            result.append((varint & 0b01111111) | 0b10000000);
+    /*!
+     * \brief Encodes \a value as varint to \a buffer, that must have space for at least 10 bytes
+     * \return number of bytes used by encoded value
+     */
+    template <typename V,
+              typename std::enable_if_t<std::is_integral<V>::value
+                                        && std::is_unsigned<V>::value, int> = 0>
+    static int encodeVarint(char *buffer, V value) {
+        int size = 0;
+        do {
+            //Put 7 bits to buffer and mark as "not last" (0b10000000) if there are more chunks
+            buffer[size] = static_cast<char>(value & 0b01111111);
             //Divide values to chunks of 7 bits and move to next chunk
-            varint >>= 7;
-        }
+            value >>= 7;
+            if (value != 0) {
+                buffer[size] |= static_cast<char>(0b10000000);
+            }
+            ++size;
+        } while (value != 0);
+        return size;
+    }
 
-        if (result.isEmpty()) {
-            result.append('\0');
-        }
+    /*!
+     * \brief Appends varint encoded \a value to \a out, without intermediate buffers
+     */
+    template <typename V,
+              typename std::enable_if_t<std::is_integral<V>::value
+                                        && std::is_unsigned<V>::value, int> = 0>
+    static void appendVarint(QByteArray &out, V value) {
+        char buffer[10];
+        out.append(buffer, encodeVarint(buffer, value));
+    }
 
-        result.data()[result.size() - 1] &= ~0b10000000;
-        return result;
+    /*!
+     * \brief Writes varint encoded \a value to \a writer
+     */
+    template <typename V,
+              typename std::enable_if_t<std::is_integral<V>::value
+                                        && std::is_unsigned<V>::value, int> = 0>
+    static void writeVarint(QProtobufWriter &writer, V value) {
+        char buffer[10];
+        writer.write(buffer, encodeVarint(buffer, value));
+    }
+
+    /*!
+     * \brief Writes encoded \a fieldIndex and \a wireType to \a writer
+     * \see encodeHeader
+     */
+    static void writeHeader(QProtobufWriter &writer, int fieldIndex, WireTypes wireType) {
+        writeVarint(writer, static_cast<uint32_t>((fieldIndex << 3) | wireType));
     }
 
     //---------------Integral and floating point types serializers---------------
@@ -211,15 +251,29 @@ public:
     }
 
     //------------------QString and QByteArray types serializers-----------------
+    /*!
+     * \brief Serialization of string and bytes fields
+     *
+     * \details Empty values, either null or of zero length, are not sent. writeProperty follows same rule for
+     *          bytes, that it writes without copying
+     */
     template <typename V,
               typename std::enable_if_t<std::is_same<V, QString>::value, int> = 0>
-    static QByteArray serializeBasic(const V &value, int &/*outFieldIndex*/) {
+    static QByteArray serializeBasic(const V &value, int &outFieldIndex) {
+        if (value.isEmpty()) {
+            outFieldIndex = QtProtobufPrivate::NotUsedFieldIndex;
+            return QByteArray();
+        }
         return serializeLengthDelimited(value.toUtf8());
     }
 
     template <typename V,
               typename std::enable_if_t<std::is_same<V, QByteArray>::value, int> = 0>
-    static QByteArray serializeBasic(const V &value, int &/*outFieldIndex*/) {
+    static QByteArray serializeBasic(const V &value, int &outFieldIndex) {
+        if (value.isEmpty()) {
+            outFieldIndex = QtProtobufPrivate::NotUsedFieldIndex;
+            return QByteArray();
+        }
         return serializeLengthDelimited(value);
     }
 
@@ -281,6 +335,9 @@ public:
         V value = 0;
         int k = 0;
         while (true) {
+            if (k >= 64) {
+                throw std::invalid_argument("Varint is too long. Seems stream is broken");
+            }
             uint64_t byte = static_cast<uint64_t>(*it);
             value += (byte & 0b01111111) << k;
             k += 7;
@@ -434,14 +491,38 @@ public:
         };
     }
 
-    // this set of 3 methods is used to skip bytes corresponding to an unexpected property
+    // this set of methods is used to skip bytes corresponding to an unexpected property
     // in a serialized message met while the message being deserialized
-    static int skipSerializedFieldBytes(QProtobufSelfcheckIterator &it, WireTypes type);
+    static int skipSerializedFieldBytes(QProtobufSelfcheckIterator &it, WireTypes type, int fieldNumber);
     static void skipVarint(QProtobufSelfcheckIterator &it);
     static void skipLengthDelimited(QProtobufSelfcheckIterator &it);
+    static void skipGroup(QProtobufSelfcheckIterator &it, int fieldNumber);
+
+    QByteArray serializeProperty(const QVariant &propertyValue, const QProtobufMetaProperty &metaProperty, bool explicitPresence = false);
 
-    QByteArray serializeProperty(const QVariant &propertyValue, const QProtobufMetaProperty &metaProperty);
-    void deserializeProperty(QObject *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it);
+    //---------------------------Streaming serializers---------------------------
+    /*!
+     * \brief Sizes of nested messages, that are used as length prefixes. Sizes are calculated once per
+     *        serialization call and kept until it's finished, so memory usage grows with number of nested messages
+     */
+    using MessageSizes = QHash<const void *, int>;
+
+    QByteArray serializeMessage(const void *object, const QProtobufMetaObject &metaObject);
+    bool serializeMessageTo(const void *object, const QProtobufMetaObject &metaObject, QIODevice *device);
+    void deserializeMessage(void *object, const QProtobufMetaObject &metaObject, const QByteArray &data);
+    void writeMessage(const void *object, const QProtobufMetaObject &metaObject, QProtobufWriter &writer);
+    void writeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer);
+
+    void writeMessage(QProtobufWriter &writer, const void *object, const QProtobufMetaObject &metaObject, MessageSizes &sizes, bool sizeOnly = false);
+    void writeProperty(QProtobufWriter &writer, const QVariant &propertyValue, const QProtobufMetaProperty &metaProperty, MessageSizes &sizes, bool sizeOnly, bool explicitPresence = false);
+    int messageSize(const void *object, const QProtobufMetaObject &metaObject, MessageSizes &sizes);
+    void deserializeProperty(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it);
+    void deserializeMessageIndexed(void *object, const QProtobufMetaObject &metaObject, const QByteArray &data);
+    /*!
+     * \brief Returns true if message of \a metaObject has repeated message fields, that could be deserialized in
+     *        parallel. Is checked once per message type, messages without such fields are never indexed
+     */
+    static bool hasRepeatedMessageFields(const QProtobufMetaObject &metaObject);
 
     void deserializeMapPair(QVariant &key, QVariant &value, QProtobufSelfcheckIterator &it);
 private:
@@ -489,7 +570,9 @@ inline bool QProtobufSerializerPrivate::decodeHeader(QProtobufSelfcheckIterator
     return fieldIndex <= maxFieldIndex && fieldIndex > 0 && (wireType == Varint
                                                              || wireType == Fixed64
                                                              || wireType == Fixed32
-                                                             || wireType == LengthDelimited);
+                                                             || wireType == LengthDelimited
+                                                             || wireType == StartGroup
+                                                             || wireType == EndGroup);
 }
 
 }
@@ -28,6 +28,7 @@
 #include "qprotobufserializer.h"
 #include "qprotobufjsonserializer.h"
 #include "qprotobufserializationplugininterface.h"
+#include "qprotobufsnapshotregistry_p.h"
 
 #include <QDir>
 #include <QString>
@@ -35,6 +36,7 @@
 #include <QPluginLoader>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QMutex>
 
 namespace {
 const QLatin1String TypeNames("types");
@@ -98,8 +100,23 @@ struct QProtobufSerializerRegistryPrivateRecord final
 
     void loadPlugin()
     {
-        QProtobufSerializationPluginInterface *loadedPlugin = qobject_cast<QProtobufSerializationPluginInterface*>(loadPluginImpl());
-        if (!pluginData.isEmpty() && loadedPlugin) {
+        QObject *instance = loadPluginImpl();
+        if (pluginData.isEmpty() || instance == nullptr) {
+            return;
+        }
+
+        //Second generation plugins are preferred, if plugin implements both interfaces
+        QProtobufSinkSerializationPluginInterface *sinkPlugin = qobject_cast<QProtobufSinkSerializationPluginInterface*>(instance);
+        if (sinkPlugin) {
+            for (int i = 0; i < typeArray.count(); i++) {
+                QString typeName = typeArray.at(i).toString();
+                serializers[typeName] = std::shared_ptr<QAbstractProtobufSerializer>(sinkPlugin->sinkSerializer(typeName));
+            }
+            return;
+        }
+
+        QProtobufSerializationPluginInterface *loadedPlugin = qobject_cast<QProtobufSerializationPluginInterface*>(instance);
+        if (loadedPlugin) {
             for (int i = 0; i < typeArray.count(); i++) {
                 QString typeName = typeArray.at(i).toString();
                 serializers[typeName] = std::shared_ptr<QAbstractProtobufSerializer>(loadedPlugin->serializer(typeName));
@@ -136,7 +153,9 @@ public:
         // create default impl
         std::shared_ptr<QProtobufSerializerRegistryPrivateRecord> plugin = std::shared_ptr<QProtobufSerializerRegistryPrivateRecord>(new QProtobufSerializerRegistryPrivateRecord());
         plugin->createDefaultImpl();
-        m_plugins[DefaultImpl] = plugin;
+        m_plugins.modify([&plugin](PluginsRegistry::Map &registry) {
+            registry[DefaultImpl] = plugin;
+        });
         m_pluginPath = QString::fromUtf8(QtProtobufPluginPath);
         QString envPluginPath = QString::fromUtf8(qgetenv("QT_PROTOBUF_PLUGIN_PATH"));
         if (!envPluginPath.isEmpty()) {
@@ -153,9 +172,14 @@ public:
         plugin->loadPluginMetadata(libPath);
 
         const QString &pluginName = plugin->pluginLoadedName;
-        if (m_plugins.find(pluginName) == m_plugins.end()) {
+        //Loading is serialized to avoid loading of same plugin twice, lookups of loaded plugins are not blocked
+        QMutexLocker locker(&m_loadLock);
+        const auto plugins = m_plugins.snapshot();
+        if (plugins->find(pluginName) == plugins->end()) {
             plugin->loadPlugin();
-            m_plugins[pluginName] = plugin;
+            m_plugins.modify([&pluginName, &plugin](PluginsRegistry::Map &registry) {
+                registry[pluginName] = plugin;
+            });
         } else {
             plugin->loader = nullptr;
             qProtoInfo() << "Serializer plugin with name" << pluginName << "is already loaded";
@@ -164,7 +188,22 @@ public:
     }
 
 
-    std::unordered_map<QString/*pluginName*/, std::shared_ptr<QProtobufSerializerRegistryPrivateRecord>> m_plugins;
+    std::shared_ptr<QAbstractProtobufSerializer> serializer(const QString &id, const QString &plugin) const
+    {
+        //Plugin records are not modified after publishing, so serializers are accessed without locking
+        return m_plugins.snapshot()->at(plugin)->serializers.at(id); //throws
+    }
+
+    std::shared_ptr<QProtobufSerializerRegistryPrivateRecord> plugin(const QString &name) const
+    {
+        const auto plugins = m_plugins.snapshot();
+        auto it = plugins->find(name);
+        return it != plugins->end() ? it->second : nullptr;
+    }
+
+    using PluginsRegistry = QtProtobufPrivate::QProtobufSnapshotRegistry<QString/*pluginName*/, std::shared_ptr<QProtobufSerializerRegistryPrivateRecord>>;
+    PluginsRegistry m_plugins;
+    QMutex m_loadLock;
     QString m_pluginPath;
 };
 
@@ -186,12 +225,12 @@ QString QProtobufSerializerRegistry::loadPlugin(const QString &name)
 
 std::shared_ptr<QAbstractProtobufSerializer> QProtobufSerializerRegistry::getSerializer(const QString &id)
 {
-    return dPtr->m_plugins[DefaultImpl]->serializers.at(id); //throws
+    return dPtr->serializer(id, DefaultImpl); //throws
 }
 
 std::shared_ptr<QAbstractProtobufSerializer> QProtobufSerializerRegistry::getSerializer(const QString &id, const QString &plugin)
 {
-    return dPtr->m_plugins[plugin]->serializers.at(id); //throws
+    return dPtr->serializer(id, plugin); //throws
 }
 
 std::unique_ptr<QAbstractProtobufSerializer> QProtobufSerializerRegistry::acquireSerializer(const QString &/*id*/, const QString &/*plugin*/)
@@ -202,10 +241,9 @@ std::unique_ptr<QAbstractProtobufSerializer> QProtobufSerializerRegistry::acquir
 
 float QProtobufSerializerRegistry::pluginVersion(const QString &plugin)
 {
-    if (dPtr->m_plugins.find(plugin) == dPtr->m_plugins.end())
+    std::shared_ptr<QProtobufSerializerRegistryPrivateRecord> implementation = dPtr->plugin(plugin);
+    if (!implementation)
         return 0.0;
-
-    std::shared_ptr<QProtobufSerializerRegistryPrivateRecord> implementation = dPtr->m_plugins[plugin];
     if (implementation->metaData.isEmpty())
         return 0.0;
 
@@ -216,11 +254,10 @@ QStringList QProtobufSerializerRegistry::pluginSerializers(const QString &plugin
 {
     QStringList strList;
 
-    if (dPtr->m_plugins.find(plugin) == dPtr->m_plugins.end())
+    std::shared_ptr<QProtobufSerializerRegistryPrivateRecord> implementation = dPtr->plugin(plugin);
+    if (!implementation)
         return strList;
 
-    std::shared_ptr<QProtobufSerializerRegistryPrivateRecord> implementation = dPtr->m_plugins[plugin];
-
     QVariantList typeArray = implementation->metaData.value(TypeNames).toList();
     foreach(QVariant value, typeArray) {
         if (!value.toString().isEmpty()) {
@@ -232,10 +269,9 @@ QStringList QProtobufSerializerRegistry::pluginSerializers(const QString &plugin
 
 float QProtobufSerializerRegistry::pluginProtobufVersion(const QString &plugin)
 {
-    if (dPtr->m_plugins.find(plugin) == dPtr->m_plugins.end())
+    std::shared_ptr<QProtobufSerializerRegistryPrivateRecord> implementation = dPtr->plugin(plugin);
+    if (!implementation)
         return 0.0;
-
-    std::shared_ptr<QProtobufSerializerRegistryPrivateRecord> implementation = dPtr->m_plugins[plugin];
     if (implementation.get() && implementation->metaData.isEmpty())
         return 0.0;
 
@@ -244,10 +280,9 @@ float QProtobufSerializerRegistry::pluginProtobufVersion(const QString &plugin)
 
 int QProtobufSerializerRegistry::pluginRating(const QString &plugin)
 {
-    if (dPtr->m_plugins.find(plugin) == dPtr->m_plugins.end())
+    std::shared_ptr<QProtobufSerializerRegistryPrivateRecord> implementation = dPtr->plugin(plugin);
+    if (!implementation)
         return 0;
-
-    std::shared_ptr<QProtobufSerializerRegistryPrivateRecord> implementation = dPtr->m_plugins[plugin];
     if (implementation->metaData.isEmpty())
         return 0;
 
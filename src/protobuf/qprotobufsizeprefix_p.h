@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <climits>
+#include <stdexcept>
+
+#include "qtprotobufglobal.h"
+
+namespace QtProtobuf {
+
+/*!
+ * \private
+ * \brief The QProtobufSizePrefixDecoder class decodes varint size prefix of length-delimited record byte by byte
+ *
+ * \details Is used by readers of length-delimited records, that get prefix bytes either from memory or from
+ *          device. Sizes that don't fit to 32 bits or exceed INT_MAX, maximum size of QByteArray, are rejected,
+ *          so broken prefix never turns to negative record size.
+ */
+class QProtobufSizePrefixDecoder
+{
+public:
+    //! Varint encoded 32-bit size takes 5 bytes at most
+    static const int MaxLength = 5;
+
+    /*!
+     * \brief Adds next prefix \a byte
+     * \return true if prefix is complete and size() returns record size
+     * \throws std::invalid_argument if prefix is longer than 5 bytes or encoded size exceeds INT_MAX
+     */
+    bool addByte(uchar byte) {
+        //Only 4 lowest bits of 5th byte belong to 32-bit value, continuation bit is not allowed there
+        if (m_length == MaxLength - 1 && byte > 0x0F) {
+            throw std::invalid_argument("Record size is invalid. Seems stream is broken");
+        }
+
+        m_size |= static_cast<quint32>(byte & 0b01111111) << (7 * m_length);
+        ++m_length;
+        if ((byte & 0b10000000) != 0) {
+            return false;
+        }
+
+        if (m_size > static_cast<quint32>(INT_MAX)) {
+            throw std::invalid_argument("Record size is too large. Seems stream is broken");
+        }
+        return true;
+    }
+
+    /*!
+     * \brief Returns number of prefix bytes added so far
+     */
+    int length() const { return m_length; }
+
+    /*!
+     * \brief Returns decoded record size
+     */
+    int size() const { return static_cast<int>(m_size); }
+
+private:
+    quint32 m_size = 0;
+    int m_length = 0;
+};
+
+}
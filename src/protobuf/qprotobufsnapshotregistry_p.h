@@ -0,0 +1,107 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>, Viktor Kopp <vifactor@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QMutex>
+#include <QAtomicInt>
+
+#include <memory>
+#include <unordered_map>
+
+#include "qtprotobufglobal.h"
+
+namespace QtProtobufPrivate {
+
+/*!
+ * \private
+ * \brief The QProtobufSnapshotRegistry class is map optimized for frequent concurrent lookups and rare modifications
+ *
+ * \details Readers use immutable snapshot of map. Last snapshot of each registry is cached per thread and is
+ *          refreshed only when map was modified, so lookups don't take any lock. Snapshot stays alive while
+ *          it's held by reader, even if map is modified concurrently or snapshot() is called again in between.
+ *          Modifications are serialized, map is copied on modification if any reader holds current snapshot.
+ */
+template<typename Key, typename Value>
+class QProtobufSnapshotRegistry
+{
+    Q_DISABLE_COPY_MOVE(QProtobufSnapshotRegistry)
+public:
+    using Map = std::unordered_map<Key, Value>;
+    using Snapshot = std::shared_ptr<const Map>;
+
+    QProtobufSnapshotRegistry() : m_current(std::make_shared<Map>())
+      , m_generation(0)
+      , m_id(nextId()) {}
+
+    /*!
+     * \brief Returns snapshot of map
+     */
+    Snapshot snapshot() const {
+        //Caches are kept per registry instance, so lookups in different registries don't evict each other
+        static thread_local std::unordered_map<int/*registry id*/, Cache> caches;
+        Cache &cache = caches[m_id];
+        const int generation = m_generation.loadAcquire();
+        if (cache.generation != generation || !cache.map) {
+            QMutexLocker locker(&m_writeLock);
+            cache.generation = m_generation.load();
+            cache.map = m_current;
+        }
+        return cache.map;
+    }
+
+    /*!
+     * \brief Calls \a modifier with writable map and publishes result to readers
+     */
+    template<typename Modifier>
+    void modify(Modifier modifier) {
+        QMutexLocker locker(&m_writeLock);
+        //Map is modified in place while none of threads holds it as snapshot
+        if (m_current.use_count() > 1) {
+            m_current = std::make_shared<Map>(*m_current);
+        }
+        modifier(*m_current);
+        m_generation.fetchAndAddRelease(1);
+    }
+
+private:
+    struct Cache {
+        int generation = 0;
+        Snapshot map;
+    };
+
+    //Ids are never reused, so cache of destroyed registry is never taken for cache of new one
+    static int nextId() {
+        static QAtomicInt lastId(0);
+        return lastId.fetchAndAddRelaxed(1) + 1;
+    }
+
+    mutable QMutex m_writeLock;
+    std::shared_ptr<Map> m_current;
+    QAtomicInt m_generation;
+    const int m_id;
+};
+
+}
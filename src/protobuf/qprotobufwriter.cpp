@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "qprotobufwriter.h"
+
+using namespace QtProtobuf;
+
+namespace {
+const int BufferCapacity = 16 * 1024;
+}
+
+QProtobufDeviceWriter::QProtobufDeviceWriter(QIODevice *device) : m_device(device)
+  , m_error(false)
+{
+    Q_ASSERT_X(device != nullptr, "QProtobufDeviceWriter", "Device is null");
+    m_buffer.reserve(BufferCapacity);
+}
+
+QProtobufDeviceWriter::~QProtobufDeviceWriter()
+{
+    flush();
+}
+
+void QProtobufDeviceWriter::writeData(const char *data, int size)
+{
+    if (m_error) {
+        return;
+    }
+
+    if (m_buffer.size() + size > BufferCapacity) {
+        flush();
+        //Large blocks are passed to device directly, without copying to buffer
+        if (size >= BufferCapacity) {
+            m_error = m_device->write(data, size) != size;
+            return;
+        }
+    }
+    m_buffer.append(data, size);
+}
+
+bool QProtobufDeviceWriter::flush()
+{
+    if (!m_error && !m_buffer.isEmpty()) {
+        m_error = m_device->write(m_buffer) != m_buffer.size();
+    }
+    //Keep allocated capacity, buffer is reused for next writes
+    m_buffer.resize(0);
+    return !m_error;
+}
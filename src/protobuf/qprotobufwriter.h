@@ -0,0 +1,160 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once //QProtobufWriter
+
+#include <QByteArray>
+#include <QIODevice>
+
+#include "qtprotobufglobal.h"
+
+namespace QtProtobuf {
+
+/*!
+ * \ingroup QtProtobuf
+ * \brief The QProtobufWriter class is sink that receives serialized data from serializers
+ *
+ * \details Serializers write encoded bytes to the sink as soon as they are produced, so intermediate
+ *          buffers are not required to pass serialized data between serialization core and serializers.
+ * \see QProtobufByteArrayWriter, QProtobufDeviceWriter
+ */
+class Q_PROTOBUF_EXPORT QProtobufWriter
+{
+public:
+    virtual ~QProtobufWriter() = default;
+
+    /*!
+     * \brief Writes \a size bytes from \a data to sink. Pending data is written first
+     */
+    void write(const char *data, int size) {
+        flushPending();
+        writeData(data, size);
+    }
+
+    /*!
+     * \brief Writes content of \a data to sink
+     */
+    void write(const QByteArray &data) { write(data.constData(), data.size()); }
+
+    /*!
+     * \brief Writes previously pending data and keeps \a data pending until next write
+     * \details Is used for data, that may be changed by following calls, e.g. separator after list element,
+     *          that is dropped when list is closed. Pending data never reaches the sink before it's known
+     *          that it's not changed, so it may be dropped for any sink, including devices.
+     */
+    void setPending(const QByteArray &data) {
+        flushPending();
+        m_pending = data;
+    }
+
+    /*!
+     * \brief Returns pending data and removes it from writer
+     */
+    QByteArray takePending() {
+        QByteArray pending;
+        pending.swap(m_pending);
+        return pending;
+    }
+
+    /*!
+     * \brief Writes pending data to sink
+     */
+    void flushPending() {
+        if (!m_pending.isEmpty()) {
+            QByteArray pending = takePending();
+            writeData(pending.constData(), pending.size());
+        }
+    }
+
+    /*!
+     * \brief Returns byte array that collects written data, if sink is backed by QByteArray, otherwise nullptr
+     * \details Used by serializers that produce data directly to byte array. Pending data must be flushed
+     *          before writing to returned buffer
+     */
+    virtual QByteArray *buffer() { return nullptr; }
+
+protected:
+    /*!
+     * \brief Passes \a size bytes from \a data to the sink
+     */
+    virtual void writeData(const char *data, int size) = 0;
+
+private:
+    QByteArray m_pending;
+};
+
+/*!
+ * \ingroup QtProtobuf
+ * \brief The QProtobufByteArrayWriter class appends written data to QByteArray
+ */
+class Q_PROTOBUF_EXPORT QProtobufByteArrayWriter final : public QProtobufWriter
+{
+public:
+    explicit QProtobufByteArrayWriter(QByteArray &buffer) : m_buffer(buffer) {}
+
+    QByteArray *buffer() override { return &m_buffer; }
+
+protected:
+    void writeData(const char *data, int size) override { m_buffer.append(data, size); }
+
+private:
+    QByteArray &m_buffer;
+};
+
+/*!
+ * \ingroup QtProtobuf
+ * \brief The QProtobufDeviceWriter class writes data to QIODevice
+ *
+ * \details Small writes are collected in internal buffer, that is flushed to device once it's full,
+ *          when flush() is called or when writer is destroyed.
+ */
+class Q_PROTOBUF_EXPORT QProtobufDeviceWriter final : public QProtobufWriter
+{
+    Q_DISABLE_COPY_MOVE(QProtobufDeviceWriter)
+public:
+    explicit QProtobufDeviceWriter(QIODevice *device);
+    ~QProtobufDeviceWriter();
+
+    /*!
+     * \brief Writes collected data to device
+     * \return true if all written data was passed to device successfully
+     */
+    bool flush();
+
+    /*!
+     * \brief Returns true if writing to device failed
+     */
+    bool hasError() const { return m_error; }
+
+protected:
+    void writeData(const char *data, int size) override;
+
+private:
+    QIODevice *m_device;
+    QByteArray m_buffer;
+    bool m_error;
+};
+
+}
@@ -88,45 +88,45 @@ std::list<RegisterFunction>& registerFunctions() {
 }
 
 void qRegisterProtobufTypes() {
-    static bool registred = false;
-    if (registred) {
-        return;
-    }
-    registred = true;
-    registerProtobufType(int32);
-    registerProtobufType(int64);
-    registerProtobufType(uint32);
-    registerProtobufType(uint64);
-    registerProtobufType(sint32);
-    registerProtobufType(sint64);
-    registerProtobufType(fixed32);
-    registerProtobufType(fixed64);
-    registerProtobufType(sfixed32);
-    registerProtobufType(sfixed64);
-
-    registerProtobufType(int32List);
-    registerProtobufType(int64List);
-    registerProtobufType(uint32List);
-    registerProtobufType(uint64List);
-    registerProtobufType(sint32List);
-    registerProtobufType(sint64List);
-    registerProtobufType(fixed32List);
-    registerProtobufType(fixed64List);
-    registerProtobufType(sfixed32List);
-    registerProtobufType(sfixed64List);
-
-    registerProtobufType(DoubleList);
-    registerProtobufType(FloatList);
-
-    registerBasicConverters<int32>();
-    registerBasicConverters<int64>();
-    registerBasicConverters<sfixed32>();
-    registerBasicConverters<sfixed64>();
-    registerBasicConverters<fixed32>();
-    registerBasicConverters<fixed64>();
-
-    for (auto registerFunc : registerFunctions()) {
-        registerFunc();
-    }
+    //Initialization of function-local static is thread-safe, concurrent callers wait until registration is done
+    static const bool registered = [] {
+        registerProtobufType(int32);
+        registerProtobufType(int64);
+        registerProtobufType(uint32);
+        registerProtobufType(uint64);
+        registerProtobufType(sint32);
+        registerProtobufType(sint64);
+        registerProtobufType(fixed32);
+        registerProtobufType(fixed64);
+        registerProtobufType(sfixed32);
+        registerProtobufType(sfixed64);
+
+        registerProtobufType(int32List);
+        registerProtobufType(int64List);
+        registerProtobufType(uint32List);
+        registerProtobufType(uint64List);
+        registerProtobufType(sint32List);
+        registerProtobufType(sint64List);
+        registerProtobufType(fixed32List);
+        registerProtobufType(fixed64List);
+        registerProtobufType(sfixed32List);
+        registerProtobufType(sfixed64List);
+
+        registerProtobufType(DoubleList);
+        registerProtobufType(FloatList);
+
+        registerBasicConverters<int32>();
+        registerBasicConverters<int64>();
+        registerBasicConverters<sfixed32>();
+        registerBasicConverters<sfixed64>();
+        registerBasicConverters<fixed32>();
+        registerBasicConverters<fixed64>();
+
+        for (auto registerFunc : registerFunctions()) {
+            registerFunc();
+        }
+        return true;
+    }();
+    Q_UNUSED(registered);
 }
 }
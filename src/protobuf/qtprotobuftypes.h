@@ -28,11 +28,16 @@
 #include "qtprotobufglobal.h"
 
 #include <QList>
+#include <QHash>
 #include <QMetaType>
 
 #include <unordered_map>
 #include <functional>
 #include <list>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
 
 namespace QtProtobuf {
 
@@ -48,13 +53,61 @@ enum WireTypes {
     Varint = 0,           //!< int32, int64, uint32, uint64, sint32, sint64, bool, enum
     Fixed64 = 1,          //!< fixed64, sfixed64, double
     LengthDelimited = 2,  //!< string, bytes, embedded messages, packed repeated fields
-    StartGroup = 3,       //!< groups \deprecated Is deprecated in proto syntax 3. Not supported by QtProtobuf
-    EndGroup = 4,         //!< groups \deprecated Is deprecated in proto syntax 3. Not supported by QtProtobuf
+    StartGroup = 3,       //!< groups \deprecated Is deprecated in proto syntax 3. Skipped as unknown field by QtProtobuf
+    EndGroup = 4,         //!< groups \deprecated Is deprecated in proto syntax 3. Skipped as unknown field by QtProtobuf
     Fixed32 = 5           //!< fixed32, sfixed32, float
 };
 
-//! \private
-using QProtobufPropertyOrdering = std::unordered_map<int, int>;
+/*!
+ * \private
+ * \ingroup QtProtobuf
+ * \brief The QProtobufPropertyOrdering class maps protobuf field numbers of message to its property indexes
+ *
+ * \details Ordering refers to array of field number and property index pairs, that is sorted by field number.
+ *          Both array and ordering are constant initialized, so no code is executed to build them at startup.
+ *          Fields are looked up using binary search and iterated in field number order.
+ */
+class QProtobufPropertyOrdering
+{
+public:
+    using value_type = std::pair<int, int>;
+    using const_iterator = const value_type *;
+    using iterator = const_iterator;
+
+    constexpr QProtobufPropertyOrdering() : m_fields(nullptr), m_size(0) {}
+    template<std::size_t N>
+    constexpr QProtobufPropertyOrdering(const value_type (&fields)[N]) : m_fields(fields), m_size(N) {}
+
+    const_iterator begin() const { return m_fields; }
+    const_iterator end() const { return m_fields + m_size; }
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    /*!
+     * \brief Returns iterator to field with \a fieldNumber or end() if message has no such field
+     */
+    const_iterator find(int fieldNumber) const {
+        const_iterator it = std::lower_bound(begin(), end(), fieldNumber, [](const value_type &field, int number) {
+            return field.first < number;
+        });
+        return it != end() && it->first == fieldNumber ? it : end();
+    }
+
+    /*!
+     * \brief Returns property index of field with \a fieldNumber, throws std::out_of_range if message has no such field
+     */
+    int at(int fieldNumber) const {
+        const_iterator it = find(fieldNumber);
+        if (it == end()) {
+            throw std::out_of_range("Message has no field with given number");
+        }
+        return it->second;
+    }
+
+private:
+    const value_type *m_fields;
+    std::size_t m_size;
+};
 
 /*!
  * \private
@@ -75,6 +128,15 @@ struct transparent {
     static QString toString(transparent t) { return QString::number(t._t); }
 };
 
+/*!
+ * \private
+ * \brief hash function for transparent types, used by maps with integral keys generated as QHash
+ */
+template<typename T, int N>
+inline uint qHash(transparent<T, N> key, uint seed = 0) {
+    return ::qHash(key._t, seed);
+}
+
 /*!
  * \brief int32 signed 32-bit integer
  * \ingroup QtProtobuf
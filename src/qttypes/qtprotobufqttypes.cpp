@@ -278,9 +278,9 @@ namespace QtProtobuf {
 template <typename QType, typename PType>
 void registerQtTypeHandler() {
     QtProtobufPrivate::registerHandler(qMetaTypeId<QType>(), {
-                                           [](const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &value, const QtProtobuf::QProtobufMetaProperty &property, QByteArray &buffer) {
+                                           [](const QtProtobuf::QAbstractProtobufSerializer *serializer, const QVariant &value, const QtProtobuf::QProtobufMetaProperty &property, QtProtobuf::QProtobufWriter &writer) {
                                                PType object(convert(value.value<QType>()));
-                                               buffer.append(serializer->serializeObject(&object, PType::protobufMetaObject, property));
+                                               serializer->writeObject(&object, PType::protobufMetaObject, property, writer);
                                            },
                                            [](const QtProtobuf::QAbstractProtobufSerializer *serializer, QtProtobuf::QProtobufSelfcheckIterator &it, QVariant &value) {
                                                PType object;
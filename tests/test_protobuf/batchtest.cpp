@@ -0,0 +1,184 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "serializationtest.h"
+
+#include "simpletest.qpb.h"
+
+#include <QThread>
+#include <QThreadPool>
+#include <QElapsedTimer>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace qtprotobufnamespace::tests;
+using namespace QtProtobuf::tests;
+using namespace QtProtobuf;
+
+namespace {
+QList<QSharedPointer<RepeatedComplexMessage>> createBatch(int count)
+{
+    QList<QSharedPointer<RepeatedComplexMessage>> batch;
+    for (int i = 0; i < count; i++) {
+        QSharedPointer<ComplexMessage> element(new ComplexMessage{i, {QString::number(i)}});
+        QSharedPointer<RepeatedComplexMessage> message(new RepeatedComplexMessage);
+        message->setTestRepeatedComplex({element, element});
+        batch.append(message);
+    }
+    return batch;
+}
+}
+
+TEST_F(SerializationTest, SerializeBatchTest)
+{
+    auto batch = createBatch(1000);
+    QList<QByteArray> payloads = serializer->serializeBatch(batch);
+    ASSERT_EQ(payloads.size(), batch.size());
+    for (int i = 0; i < batch.size(); i++) {
+        ASSERT_TRUE(payloads.at(i) == batch.at(i)->serialize(serializer.get()));
+    }
+
+    ASSERT_TRUE(serializer->serializeBatch(QList<QSharedPointer<RepeatedComplexMessage>>()).isEmpty());
+}
+
+TEST_F(SerializationTest, DeserializeBatchTest)
+{
+    auto batch = createBatch(1000);
+    QList<QByteArray> payloads;
+    for (const auto &message : batch) {
+        payloads.append(message->serialize(serializer.get()));
+    }
+
+    QList<QSharedPointer<RepeatedComplexMessage>> results = serializer->deserializeBatch<RepeatedComplexMessage>(payloads);
+    ASSERT_EQ(results.size(), batch.size());
+    for (int i = 0; i < results.size(); i++) {
+        const auto &result = results.at(i);
+        //Decoded objects must belong to thread that requested deserialization
+        ASSERT_EQ(result->thread(), QThread::currentThread());
+        ASSERT_EQ(result->testRepeatedComplex().size(), 2);
+        const auto &element = result->testRepeatedComplex().first();
+        ASSERT_EQ(element->testFieldInt(), i);
+        ASSERT_TRUE(element->testComplexField().testFieldString() == QString::number(i));
+        ASSERT_EQ(element->thread(), QThread::currentThread());
+        ASSERT_EQ(element->testComplexField().thread(), QThread::currentThread());
+    }
+
+    payloads.append(QByteArray::fromHex("0a0c08"));
+    EXPECT_THROW(serializer->deserializeBatch<RepeatedComplexMessage>(payloads), std::out_of_range);
+}
+
+TEST_F(SerializationTest, DISABLED_BatchScalingBenchmarkTest)
+{
+    auto batch = createBatch(10000);
+    QList<QByteArray> payloads = serializer->serializeBatch(batch);
+    for (int threads = 1; threads <= QThread::idealThreadCount(); threads++) {
+        QThreadPool pool;
+        pool.setMaxThreadCount(threads);
+        QElapsedTimer timer;
+        timer.start();
+        serializer->serializeBatch(batch, &pool);
+        qint64 serializationTime = timer.restart();
+        serializer->deserializeBatch<RepeatedComplexMessage>(payloads, &pool);
+        qint64 deserializationTime = timer.elapsed();
+        qInfo() << "threads:" << threads << "serializeBatch:" << serializationTime << "ms"
+                << "deserializeBatch:" << deserializationTime << "ms";
+    }
+}
+
+TEST_F(SerializationTest, ParallelRepeatedMessageTest)
+{
+    QList<QSharedPointer<ComplexMessage>> elements;
+    for (int i = 0; i < 5000; i++) {
+        elements.append(QSharedPointer<ComplexMessage>(new ComplexMessage{i, {QString::number(i)}}));
+    }
+    RepeatedComplexMessage message;
+    message.setTestRepeatedComplex(elements);
+
+    QByteArray expected = message.serialize(serializer.get());
+    serializer->setParallelListThreshold(100);
+    ASSERT_TRUE(message.serialize(serializer.get()) == expected);
+
+    RepeatedComplexMessage result;
+    result.deserialize(serializer.get(), expected);
+    ASSERT_EQ(result.testRepeatedComplex().size(), 5000);
+    for (int i = 0; i < result.testRepeatedComplex().size(); i++) {
+        const auto &element = result.testRepeatedComplex().at(i);
+        ASSERT_EQ(element->testFieldInt(), i);
+        ASSERT_TRUE(element->testComplexField().testFieldString() == QString::number(i));
+        ASSERT_EQ(element->thread(), QThread::currentThread());
+    }
+
+    //Elements of list below threshold and other fields are deserialized as usual
+    ComplexMessage complex;
+    complex.deserialize(serializer.get(), QByteArray::fromHex("1208320671776572747908ffffffff0f"));
+    ASSERT_EQ(complex.testFieldInt(), -1);
+    ASSERT_TRUE(complex.testComplexField().testFieldString() == "qwerty");
+
+    EXPECT_THROW(result.deserialize(serializer.get(), QByteArray::fromHex("0a0c08")), std::out_of_range);
+}
+
+TEST_F(SerializationTest, RegistryStressTest)
+{
+    SimpleStringMessage stringMsg;
+    stringMsg.setTestFieldString("qwerty");
+    QSharedPointer<ComplexMessage> msg(new ComplexMessage);
+    msg->setTestFieldInt(25);
+    msg->setTestComplexField(stringMsg);
+    RepeatedComplexMessage message;
+    message.setTestRepeatedComplex({msg, msg});
+    const QByteArray expected = message.serialize(serializer.get());
+
+    std::atomic<bool> running(true);
+    std::atomic<int> failures(0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < 8; i++) {
+        workers.emplace_back([&] {
+            //Each thread uses own serializer, serializers are constructed while types are registered
+            QProtobufSerializer threadSerializer;
+            while (running) {
+                RepeatedComplexMessage result;
+                result.deserialize(&threadSerializer, expected);
+                if (result.serialize(&threadSerializer) != expected) {
+                    ++failures;
+                }
+            }
+        });
+    }
+
+    //Registration of existing and new types
+    for (int i = 0; i < 1000; i++) {
+        qRegisterProtobufType<ComplexMessage>();
+        QtProtobufPrivate::registerHandler(QMetaType::User + 100000 + i, QtProtobufPrivate::findHandler(qMetaTypeId<ComplexMessage *>()));
+        QtProtobuf::qRegisterProtobufTypes();
+    }
+
+    running = false;
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    ASSERT_EQ(failures, 0);
+}
@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "serializationtest.h"
+
+#include "simpletest.qpb.h"
+
+#include <qprotobufcompressedserializer.h>
+#include <qprotobufjsonserializer.h>
+
+using namespace qtprotobufnamespace::tests;
+using namespace QtProtobuf::tests;
+using namespace QtProtobuf;
+
+TEST_F(SerializationTest, CompressedSerializerStoredTest)
+{
+    QProtobufCompressedSerializer compressedSerializer;
+    SimpleStringMessage message("qwerty");
+    QByteArray result = message.serialize(&compressedSerializer);
+    ASSERT_STREQ(result.toHex().toStdString().c_str(), "003206717765727479");
+
+    SimpleStringMessage deserialized;
+    deserialized.deserialize(&compressedSerializer, result);
+    ASSERT_STREQ(deserialized.testFieldString().toStdString().c_str(), "qwerty");
+}
+
+TEST_F(SerializationTest, CompressedSerializerDeflateTest)
+{
+    QProtobufCompressedSerializer compressedSerializer;
+    SimpleStringMessage message(QString(10000, 'a'));
+    QByteArray plain = message.serialize(serializer.get());
+    QByteArray result = message.serialize(&compressedSerializer);
+    ASSERT_EQ(result.at(0), 0x01);
+    ASSERT_LT(result.size(), plain.size() / 10);
+
+    SimpleStringMessage deserialized;
+    deserialized.deserialize(&compressedSerializer, result);
+    ASSERT_TRUE(deserialized == message);
+}
+
+TEST_F(SerializationTest, CompressedSerializerThresholdTest)
+{
+    SimpleStringMessage message(QString(1000, 'a'));
+    QByteArray plain = message.serialize(serializer.get());
+
+    QProtobufCompressedSerializer compressedSerializer(nullptr, QProtobufCompressedSerializer::DefaultCompressionLevel, 2000);
+    QByteArray result = message.serialize(&compressedSerializer);
+    ASSERT_EQ(result, QByteArray(1, 0x00) + plain);
+
+    compressedSerializer.setCompressionThreshold(500);
+    result = message.serialize(&compressedSerializer);
+    ASSERT_EQ(result.at(0), 0x01);
+
+    compressedSerializer.setCompressionLevel(0);
+    result = message.serialize(&compressedSerializer);
+    ASSERT_EQ(result, QByteArray(1, 0x00) + plain);
+}
+
+TEST_F(SerializationTest, CompressedSerializerJsonTest)
+{
+    QProtobufCompressedSerializer compressedSerializer(std::make_shared<QProtobufJsonSerializer>(), 9, 0);
+    SimpleStringMessage message(QString(1000, 'a'));
+    QByteArray result = message.serialize(&compressedSerializer);
+    ASSERT_EQ(result.at(0), 0x01);
+
+    SimpleStringMessage deserialized;
+    deserialized.deserialize(&compressedSerializer, result);
+    ASSERT_TRUE(deserialized == message);
+}
+
+TEST_F(SerializationTest, CompressedSerializerInvalidDataTest)
+{
+    QProtobufCompressedSerializer compressedSerializer;
+    SimpleStringMessage message;
+    ASSERT_THROW(message.deserialize(&compressedSerializer, QByteArray::fromHex("0100000010ffff")), std::invalid_argument);
+    ASSERT_THROW(message.deserialize(&compressedSerializer, QByteArray::fromHex("07320171")), std::invalid_argument);
+}
@@ -0,0 +1,187 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "serializationtest.h"
+
+#include "simpletest.qpb.h"
+
+#include <qprotobufdelimitedwriter.h>
+#include <qprotobufdelimitedreader.h>
+#include <qprotobufrecordfilereader.h>
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QTemporaryDir>
+
+using namespace qtprotobufnamespace::tests;
+using namespace QtProtobuf::tests;
+using namespace QtProtobuf;
+
+TEST_F(SerializationTest, DelimitedWriterTest)
+{
+    QByteArray result;
+    {
+        QProtobufDelimitedWriter writer(serializer.get(), &result);
+        ASSERT_TRUE(writer.write(SimpleIntMessage{15}));
+        ASSERT_TRUE(writer.write(SimpleIntMessage{0}));
+        ASSERT_TRUE(writer.write(SimpleIntMessage{300}));
+    }
+    ASSERT_STREQ(result.toHex().toStdString().c_str(), "02080f000308ac02");
+}
+
+TEST_F(SerializationTest, DelimitedReaderTest)
+{
+    QList<int> values;
+    QProtobufDelimitedReader reader(serializer.get(), QByteArray::fromHex("02080f000308ac02"));
+    for (const auto &message : reader.messages<SimpleIntMessage>()) {
+        values.append(message.testFieldInt());
+    }
+    ASSERT_TRUE(values == QList<int>({15, 0, 300}));
+
+    SimpleIntMessage message;
+    QProtobufDelimitedReader truncatedReader(serializer.get(), QByteArray::fromHex("02080f0308ac"));
+    ASSERT_TRUE(truncatedReader.read(&message));
+    ASSERT_EQ(message.testFieldInt(), 15);
+    EXPECT_THROW(truncatedReader.read(&message), std::out_of_range);
+}
+
+TEST_F(SerializationTest, DelimitedReaderInvalidSizeTest)
+{
+    QByteArray record;
+    //5th byte carries bits above 32-bit range
+    QProtobufDelimitedReader overflowReader(serializer.get(), QByteArray::fromHex("ffffffff1f00"));
+    EXPECT_THROW(overflowReader.readRecord(record), std::invalid_argument);
+    //Size exceeds INT_MAX
+    QProtobufDelimitedReader hugeReader(serializer.get(), QByteArray::fromHex("ffffffff0f00"));
+    EXPECT_THROW(hugeReader.readRecord(record), std::invalid_argument);
+    //Size prefix is longer than 5 bytes
+    QProtobufDelimitedReader longReader(serializer.get(), QByteArray::fromHex("808080808000"));
+    EXPECT_THROW(longReader.readRecord(record), std::invalid_argument);
+
+    QByteArray data = QByteArray::fromHex("ffffffff0f00");
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QProtobufDelimitedReader deviceReader(serializer.get(), &buffer);
+    EXPECT_THROW(deviceReader.readRecord(record), std::invalid_argument);
+}
+
+TEST_F(SerializationTest, DelimitedDeviceTest)
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    {
+        QProtobufDelimitedWriter writer(serializer.get(), &buffer);
+        for (int i = 0; i < 100000; i++) {
+            ASSERT_TRUE(writer.write(SimpleIntMessage{i}));
+        }
+    }
+    buffer.close();
+
+    buffer.open(QIODevice::ReadOnly);
+    QProtobufDelimitedReader reader(serializer.get(), &buffer);
+    int expected = 0;
+    for (const auto &message : reader.messages<SimpleIntMessage>()) {
+        ASSERT_EQ(message.testFieldInt(), expected++);
+    }
+    ASSERT_EQ(expected, 100000);
+}
+
+TEST_F(SerializationTest, RecordFileReaderTest)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QString fileName = dir.filePath("records.bin");
+    {
+        QFile file(fileName);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        QProtobufDelimitedWriter writer(serializer.get(), &file);
+        for (int i = 0; i < 1000; i++) {
+            ASSERT_TRUE(writer.write(SimpleIntMessage{i}));
+        }
+    }
+
+    QProtobufRecordFileReader reader(serializer.get(), fileName);
+    ASSERT_TRUE(reader.open());
+    ASSERT_FALSE(reader.loadIndex());
+    ASSERT_TRUE(reader.buildIndex());
+    ASSERT_EQ(reader.recordCount(), 1000);
+    ASSERT_TRUE(reader.saveIndex());
+
+    SimpleIntMessage message;
+    reader.read(999, &message);
+    ASSERT_EQ(message.testFieldInt(), 999);
+    reader.read(0, &message);
+    ASSERT_EQ(message.testFieldInt(), 0);
+    EXPECT_THROW(reader.record(1000), std::out_of_range);
+
+    auto partitions = reader.partitions(3);
+    ASSERT_EQ(partitions.size(), 3);
+    ASSERT_EQ(partitions.first().first, 0);
+    ASSERT_EQ(partitions.last().second, 1000);
+    ASSERT_EQ(partitions[0].second, partitions[1].first);
+
+    QProtobufRecordFileReader indexedReader(serializer.get(), fileName);
+    ASSERT_TRUE(indexedReader.open());
+    ASSERT_TRUE(indexedReader.loadIndex());
+    ASSERT_EQ(indexedReader.recordCount(), 1000);
+    indexedReader.read(500, &message);
+    ASSERT_EQ(message.testFieldInt(), 500);
+
+    //Sequential reading without index
+    qint64 offset = 0;
+    ASSERT_TRUE(indexedReader.recordAt(offset, &offset).isEmpty());
+    ASSERT_EQ(offset, 1);
+    ASSERT_STREQ(indexedReader.recordAt(offset, &offset).toHex().toStdString().c_str(), "0801");
+    ASSERT_EQ(offset, 4);
+}
+
+TEST_F(SerializationTest, RecordFileReaderInvalidDataTest)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QString fileName = dir.filePath("records.bin");
+    {
+        QFile file(fileName);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        ASSERT_EQ(file.write(QByteArray::fromHex("00020801020802ffffffff0f00")), 13);
+    }
+
+    //Size of 4th record exceeds INT_MAX
+    QProtobufRecordFileReader reader(serializer.get(), fileName);
+    ASSERT_TRUE(reader.open());
+    ASSERT_FALSE(reader.buildIndex());
+    EXPECT_THROW(reader.recordAt(7), std::invalid_argument);
+
+    //Index, that was created for other layout of file with same size, is rejected
+    {
+        QFile indexFile(fileName + QLatin1String(".idx"));
+        ASSERT_TRUE(indexFile.open(QIODevice::WriteOnly));
+        QDataStream stream(&indexFile);
+        stream << quint32(0x51504249) << quint32(1) << qint64(13) << quint64(2) << qint64(0) << qint64(2);
+    }
+    ASSERT_FALSE(reader.loadIndex());
+    ASSERT_FALSE(reader.hasIndex());
+}
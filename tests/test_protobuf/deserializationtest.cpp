@@ -867,6 +867,34 @@ TEST_F(DeserializationTest, RedundantFieldIsIgnoredAtDeserializationTest)
     EXPECT_STREQ(test.testComplexField().testFieldString().toStdString().c_str(), "qwerty");
 }
 
+TEST_F(DeserializationTest, RedundantGroupIsIgnoredAtDeserializationTest)
+{
+    ComplexMessage test;
+    //4b ... 4c group field number 9, contains varint, length delimited, nested group number 10 and fixed32 fields
+    ASSERT_NO_THROW(test.deserialize(serializer.get(), QByteArray::fromHex("4b089601531202616254"
+                                                                          "2d010203044c12083206717765727479")));
+    EXPECT_EQ(test.testFieldInt(), 0);
+    EXPECT_STREQ(test.testComplexField().testFieldString().toStdString().c_str(), "qwerty");
+
+    //Varint terminator is located in second 8 bytes chunk
+    ASSERT_NO_THROW(test.deserialize(serializer.get(), QByteArray::fromHex("4b60d3ffffffffffffffff014c08011208"
+                                                                          "3206717765727479")));
+    EXPECT_EQ(test.testFieldInt(), 1);
+    EXPECT_STREQ(test.testComplexField().testFieldString().toStdString().c_str(), "qwerty");
+
+    //Group end field number doesn't match group start
+    EXPECT_THROW(test.deserialize(serializer.get(), QByteArray::fromHex("4b0896015412083206717765727479")),
+                 std::invalid_argument);
+
+    //Group end without group start
+    EXPECT_THROW(test.deserialize(serializer.get(), QByteArray::fromHex("4c12083206717765727479")),
+                 std::invalid_argument);
+
+    //Group is not closed
+    EXPECT_THROW(test.deserialize(serializer.get(), QByteArray::fromHex("120832067177657274794b089601")),
+                 std::out_of_range);
+}
+
 TEST_F(DeserializationTest, FieldIndexRangeTest)
 {
     FieldIndexTest1Message msg1(0);
@@ -30,6 +30,7 @@
 #include <qprotobufjsonserializer.h>
 
 #include "simpletest.qpb.h"
+#include "sequencetest.qpb.h"
 
 using namespace qtprotobufnamespace::tests;
 
@@ -270,6 +271,12 @@ TEST_F(JsonDeserializationTest, BytesMessageSerializeTest)
     test.setTestFieldBytes("qwerty");
     test.deserialize(serializer.get(), QByteArray("{\"testFieldBytes\":null}"));
     EXPECT_TRUE(test.testFieldBytes().isEmpty());
+
+    test.deserialize(serializer.get(), QByteArray("{\"testFieldBytes\":\"-_-_+/8\"}"));
+    EXPECT_STREQ(test.testFieldBytes().toHex().toStdString().c_str(), "fbffbffbff");
+
+    test.deserialize(serializer.get(), QByteArray("{\"testFieldBytes\":\"qw$rty==\"}"));
+    EXPECT_TRUE(test.testFieldBytes().isEmpty());
 }
 
 TEST_F(JsonDeserializationTest, ComplexTypeSerializeTest)
@@ -744,5 +751,45 @@ TEST_F(JsonDeserializationTest, SimpleStringStringMapSerializeTest)
     ASSERT_EQ(test.mapField().size(), 0);
 }
 
+TEST_F(JsonDeserializationTest, ProtoFieldNameTest)
+{
+    ComplexMessage test;
+    test.deserialize(serializer.get(), QByteArray("{\"test_field_int\":42,\"test_complex_field\":{\"test_field_string\":\"qwerty\"}}"));
+    EXPECT_EQ(test.testFieldInt(), 42);
+    EXPECT_STREQ(test.testComplexField().testFieldString().toStdString().c_str(), "qwerty");
+}
+
+TEST_F(JsonDeserializationTest, SinglePassParserTest)
+{
+    ComplexMessage test;
+    test.deserialize(serializer.get(), QByteArray(" {\"unknownField\": {\"a\": [1, {\"b\": \"}]\"}]},"
+                                                  " \"testComplexField\" : {\"testFieldString\": \"q\\\"\\u0077\\n\"} ,"
+                                                  " \"testFieldInt\": 42 } "));
+    EXPECT_EQ(test.testFieldInt(), 42);
+    EXPECT_STREQ(test.testComplexField().testFieldString().toStdString().c_str(), "q\"w\n");
+
+    EXPECT_THROW(test.deserialize(serializer.get(), QByteArray("{\"testFieldInt\":42")), std::invalid_argument);
+    EXPECT_THROW(test.deserialize(serializer.get(), QByteArray("{\"testFieldInt\":42}}")), std::invalid_argument);
+    EXPECT_THROW(test.deserialize(serializer.get(), QByteArray("{\"testComplexField\":{\"testFieldString\":\"q}}")), std::invalid_argument);
+    EXPECT_THROW(test.deserialize(serializer.get(), QByteArray("{\"unknownField\":\"q\\")), std::invalid_argument);
+}
+
+TEST_F(JsonDeserializationTest, NestingDepthTest)
+{
+    auto nested = [](int depth) {
+        QByteArray json;
+        for (int i = 0; i < depth; i++) {
+            json.append("{\"testField\":");
+        }
+        json.append("{}");
+        json.append(QByteArray(depth, '}'));
+        return json;
+    };
+
+    sequence::CyclingFirstDependency test;
+    EXPECT_NO_THROW(test.deserialize(serializer.get(), nested(50)));
+    EXPECT_THROW(test.deserialize(serializer.get(), nested(10000)), std::invalid_argument);
+}
+
 }
 }
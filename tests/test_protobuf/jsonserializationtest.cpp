@@ -24,12 +24,14 @@
  */
 
 #include <gtest/gtest.h>
+#include <QBuffer>
 #include <QByteArray>
 #include <QString>
 
 #include <qprotobufjsonserializer.h>
 
 #include "simpletest.qpb.h"
+#include "sequencetest.qpb.h"
 
 using namespace qtprotobufnamespace::tests;
 
@@ -148,11 +150,11 @@ TEST_F(JsonSerializationTest, FloatMessageSerializeTest)
 
     test.setTestFieldFloat(FLT_MIN);
     result = test.serialize(serializer.get());
-    EXPECT_STREQ(QString::fromUtf8(result).toStdString().c_str(), "{\"testFieldFloat\":1.17549e-38}");
+    EXPECT_STREQ(QString::fromUtf8(result).toStdString().c_str(), "{\"testFieldFloat\":1.1754944e-38}");
 
     test.setTestFieldFloat(FLT_MAX);
     result = test.serialize(serializer.get());
-    EXPECT_STREQ(QString::fromUtf8(result).toStdString().c_str(), "{\"testFieldFloat\":3.40282e+38}");
+    EXPECT_STREQ(QString::fromUtf8(result).toStdString().c_str(), "{\"testFieldFloat\":3.4028235e+38}");
 
     test.setTestFieldFloat(-4.2f);
     result = test.serialize(serializer.get());
@@ -161,6 +163,14 @@ TEST_F(JsonSerializationTest, FloatMessageSerializeTest)
     test.setTestFieldFloat(-0.0f);
     result = test.serialize(serializer.get());
     EXPECT_STREQ(QString::fromUtf8(result).toStdString().c_str(), "{\"testFieldFloat\":0}");
+
+    //Shortest representation is parsed back to the same value
+    for (float value : {FLT_MIN, FLT_MAX, 1.0f / 3.0f, 16777217.0f, -1.2345678e-20f}) {
+        test.setTestFieldFloat(value);
+        SimpleFloatMessage restored;
+        restored.deserialize(serializer.get(), test.serialize(serializer.get()));
+        EXPECT_EQ(restored.testFieldFloat(), value);
+    }
 }
 
 TEST_F(JsonSerializationTest, DoubleMessageSerializeTest)
@@ -574,5 +584,52 @@ TEST_F(JsonSerializationTest, SimpleStringStringMapSerializeTest)
                  "{\"mapField\":{\"ben\":\"ten\",\"sweet\":\"fifteen\",\"what is the answer?\":\"fourty two\"}}");
 }
 
+TEST_F(JsonSerializationTest, EmptyMessageSerializeTest)
+{
+    EmptyMessage test;
+    QByteArray result = test.serialize(serializer.get());
+    EXPECT_STREQ(result.toStdString().c_str(), "{}");
+}
+
+TEST_F(JsonSerializationTest, StringEscapingSerializeTest)
+{
+    SimpleStringMessage test;
+    test.setTestFieldString("tab\t\"quoted\" back\\slash\nline\x01");
+    QByteArray result = test.serialize(serializer.get());
+    EXPECT_STREQ(result.toStdString().c_str(), "{\"testFieldString\":\"tab\\t\\\"quoted\\\" back\\\\slash\\nline\\u0001\"}");
+
+    SimpleStringMessage deserialized;
+    deserialized.deserialize(serializer.get(), result);
+    EXPECT_TRUE(deserialized.testFieldString() == test.testFieldString());
+}
+
+TEST_F(JsonSerializationTest, SerializeToDeviceTest)
+{
+    RepeatedComplexMessage test;
+    QList<QSharedPointer<ComplexMessage>> messages;
+    for (int i = 0; i < 2000; i++) {
+        messages.append(QSharedPointer<ComplexMessage>(new ComplexMessage({i, {"qwerty"}})));
+    }
+    test.setTestRepeatedComplex(messages);
+    QByteArray expected = test.serialize(serializer.get());
+
+    //Output exceeds internal buffer of writer, so it's written to device by several chunks
+    QByteArray result;
+    QBuffer buffer(&result);
+    buffer.open(QIODevice::WriteOnly);
+    ASSERT_TRUE(test.serializeTo(serializer.get(), &buffer));
+    EXPECT_TRUE(result == expected);
+
+    serializer->setParallelListThreshold(100);
+    EXPECT_TRUE(test.serialize(serializer.get()) == expected);
+}
+
+TEST_F(JsonSerializationTest, RecursiveMessageSerializeTest)
+{
+    sequence::CyclingFirstDependency test;
+    EXPECT_STREQ(test.serialize(serializer.get()).toStdString().c_str(), "{}");
+    EXPECT_FALSE(test.hasTestField());
+}
+
 }
 }
@@ -0,0 +1,166 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "serializationtest.h"
+
+#include "simpletest.qpb.h"
+
+#include <qprotobufjsonserializer.h>
+#include <qprotobufjsontranscoder.h>
+
+#include <QBuffer>
+
+using namespace qtprotobufnamespace::tests;
+using namespace QtProtobuf::tests;
+using namespace QtProtobuf;
+
+TEST_F(SerializationTest, JsonTranscoderJsonToBinaryTest)
+{
+    QProtobufJsonTranscoder transcoder;
+    QByteArray result = transcoder.jsonToBinary<RepeatedIntMessage>("{\"testRepeatedInt\":[0,1,321,-65999,123245,-3,3]}");
+    ASSERT_STREQ(result.toHex().toStdString().c_str(), "0a120001c102b1fcfbff0fedc207fdffffff0f03");
+
+    result = transcoder.jsonToBinary<SimpleStringStringMapMessage>("{\"mapField\":{\"ben\":\"ten\"}}");
+    ASSERT_STREQ(result.toHex().toStdString().c_str(), "6a0a0a0362656e120374656e");
+
+    result = transcoder.jsonToBinary<ComplexMessage>(" { \"unknownField\" : [1, {\"a\": null}], \"testFieldInt\" : \"-45\" ,\n"
+                                                     "\"testComplexField\" : {\"testFieldString\":\"qw\\\"er\\u0074y\"} }");
+    ComplexMessage message;
+    message.deserialize(serializer.get(), result);
+    ASSERT_EQ(message.testFieldInt(), -45);
+    ASSERT_STREQ(message.testComplexField().testFieldString().toStdString().c_str(), "qw\"erty");
+
+    SimpleEnumListMessage enumMessage;
+    enumMessage.deserialize(serializer.get(), transcoder.jsonToBinary<SimpleEnumListMessage>("{\"localEnumList\":[\"LOCAL_ENUM_VALUE2\",3,null]}"));
+    ASSERT_TRUE(enumMessage.localEnumList() == SimpleEnumListMessage::LocalEnumRepeated({SimpleEnumListMessage::LOCAL_ENUM_VALUE2,
+                                                                                         SimpleEnumListMessage::LOCAL_ENUM_VALUE3,
+                                                                                         SimpleEnumListMessage::LOCAL_ENUM_VALUE0}));
+}
+
+TEST_F(SerializationTest, JsonTranscoderBinaryToJsonTest)
+{
+    QProtobufJsonTranscoder transcoder;
+    QByteArray result = transcoder.binaryToJson<RepeatedIntMessage>(QByteArray::fromHex("0a120001c102b1fcfbff0fedc207fdffffff0f03"));
+    ASSERT_STREQ(result.toStdString().c_str(), "{\"testRepeatedInt\":[0,1,321,-65999,123245,-3,3]}");
+
+    SimpleStringMessage stringMessage("qwe\"rty\n");
+    result = transcoder.binaryToJson<SimpleStringMessage>(stringMessage.serialize(serializer.get()));
+    ASSERT_STREQ(result.toStdString().c_str(), "{\"testFieldString\":\"qwe\\\"rty\\n\"}");
+
+    SimpleEnumMessage enumMessage;
+    enumMessage.setLocalEnum(SimpleEnumMessage::LOCAL_ENUM_VALUE2);
+    result = transcoder.binaryToJson<SimpleEnumMessage>(enumMessage.serialize(serializer.get()));
+    ASSERT_STREQ(result.toStdString().c_str(), "{\"localEnum\":\"LOCAL_ENUM_VALUE2\"}");
+
+    ASSERT_STREQ(transcoder.binaryToJson<ComplexMessage>(QByteArray()).toStdString().c_str(), "{}");
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    {
+        QProtobufDeviceWriter writer(&buffer);
+        transcoder.binaryToJson(stringMessage.serialize(serializer.get()), SimpleStringMessage::protobufMetaObject, writer);
+    }
+    ASSERT_STREQ(buffer.data().toStdString().c_str(), "{\"testFieldString\":\"qwe\\\"rty\\n\"}");
+}
+
+TEST_F(SerializationTest, JsonTranscoderInterleavedRepeatedTest)
+{
+    QProtobufJsonTranscoder transcoder;
+    //Records of repeated field are separated by record of other field
+    QByteArray result = transcoder.binaryToJson<SimpleFileEnumMessage>(QByteArray::fromHex("100108021002"));
+    ASSERT_STREQ(result.toStdString().c_str(),
+                 "{\"globalEnumList\":[\"TEST_ENUM_VALUE1\",\"TEST_ENUM_VALUE2\"],\"globalEnum\":\"TEST_ENUM_VALUE2\"}");
+
+    result = transcoder.binaryToJson<SimpleStringStringMapMessage>(QByteArray::fromHex("6a0a0a0362656e120374656e"
+                                                                                       "ea0700"
+                                                                                       "6a0a0a03737765120366"
+                                                                                       "6966"));
+    SimpleStringStringMapMessage mapMessage;
+    mapMessage.deserialize(serializer.get(), transcoder.jsonToBinary<SimpleStringStringMapMessage>(result));
+    ASSERT_EQ(mapMessage.mapField().size(), 2);
+    EXPECT_STREQ(mapMessage.mapField().value("ben").toStdString().c_str(), "ten");
+    EXPECT_STREQ(mapMessage.mapField().value("swe").toStdString().c_str(), "fif");
+}
+
+TEST_F(SerializationTest, JsonTranscoderNegativeEnumTest)
+{
+    QProtobufJsonTranscoder transcoder;
+    //Unknown negative enum value encoded as 64 bit and 32 bit varint
+    ASSERT_STREQ(transcoder.binaryToJson<SimpleEnumMessage>(QByteArray::fromHex("08feffffffffffffffff01")).toStdString().c_str(),
+                 "{\"localEnum\":-2}");
+    ASSERT_STREQ(transcoder.binaryToJson<SimpleEnumMessage>(QByteArray::fromHex("08feffffff0f")).toStdString().c_str(),
+                 "{\"localEnum\":-2}");
+    ASSERT_EQ(transcoder.jsonToBinary<SimpleEnumMessage>("{\"localEnum\":-2}"), QByteArray::fromHex("08feffffffffffffffff01"));
+    EXPECT_THROW(transcoder.jsonToBinary<SimpleEnumMessage>("{\"localEnum\":4294967294}"), std::invalid_argument);
+}
+
+TEST_F(SerializationTest, JsonTranscoderRoundTripTest)
+{
+    QProtobufJsonTranscoder transcoder;
+    QProtobufJsonSerializer jsonSerializer;
+
+    RepeatedComplexMessage message;
+    message.setTestRepeatedComplex({QSharedPointer<ComplexMessage>(new ComplexMessage({25, {"qwerty"}})),
+                                    QSharedPointer<ComplexMessage>(new ComplexMessage({-1, {"\t\\"}}))});
+
+    //Binary -> JSON -> binary
+    RepeatedComplexMessage result;
+    result.deserialize(serializer.get(), transcoder.jsonToBinary<RepeatedComplexMessage>(
+                           transcoder.binaryToJson<RepeatedComplexMessage>(message.serialize(serializer.get()))));
+    ASSERT_EQ(result.testRepeatedComplex().size(), 2);
+    EXPECT_EQ(result.testRepeatedComplex().at(0)->testFieldInt(), 25);
+    EXPECT_STREQ(result.testRepeatedComplex().at(0)->testComplexField().testFieldString().toStdString().c_str(), "qwerty");
+    EXPECT_EQ(result.testRepeatedComplex().at(1)->testFieldInt(), -1);
+    EXPECT_STREQ(result.testRepeatedComplex().at(1)->testComplexField().testFieldString().toStdString().c_str(), "\t\\");
+
+    //Output of JSON serializer is accepted by transcoder and transcoder output is accepted by JSON serializer
+    SimpleStringStringMapMessage mapMessage;
+    mapMessage.setMapField({{"ben", "ten"}, {"what is the answer?", "fourty two"}, {"sweet", "fifteen"}});
+    SimpleStringStringMapMessage mapResult;
+    mapResult.deserialize(serializer.get(), transcoder.jsonToBinary<SimpleStringStringMapMessage>(mapMessage.serialize(&jsonSerializer)));
+    EXPECT_TRUE(mapResult == mapMessage);
+
+    mapResult.setMapField({});
+    mapResult.deserialize(&jsonSerializer, transcoder.binaryToJson<SimpleStringStringMapMessage>(mapMessage.serialize(serializer.get())));
+    EXPECT_TRUE(mapResult == mapMessage);
+
+    RepeatedBytesMessage bytesMessage;
+    bytesMessage.setTestRepeatedBytes({QByteArray::fromHex("010203040506"), QByteArray::fromHex("ffffffff"), QByteArray(), QByteArray::fromHex("eaeaeaeaea01")});
+    RepeatedBytesMessage bytesResult;
+    bytesResult.deserialize(serializer.get(), transcoder.jsonToBinary<RepeatedBytesMessage>(
+                                transcoder.binaryToJson<RepeatedBytesMessage>(bytesMessage.serialize(serializer.get()))));
+    EXPECT_TRUE(bytesResult == bytesMessage);
+}
+
+TEST_F(SerializationTest, JsonTranscoderInvalidDataTest)
+{
+    QProtobufJsonTranscoder transcoder;
+    EXPECT_THROW(transcoder.jsonToBinary<ComplexMessage>("{\"testFieldInt\":\"abc\"}"), std::invalid_argument);
+    EXPECT_THROW(transcoder.jsonToBinary<ComplexMessage>("{\"testFieldInt\":42"), std::invalid_argument);
+    EXPECT_THROW(transcoder.jsonToBinary<ComplexMessage>("{\"testFieldInt\":42} 42"), std::invalid_argument);
+    EXPECT_THROW(transcoder.jsonToBinary<RepeatedBytesMessage>("{\"testRepeatedBytes\":[\"#$\"]}"), std::invalid_argument);
+    EXPECT_THROW(transcoder.binaryToJson<SimpleStringMessage>(QByteArray::fromHex("3206717765")), std::out_of_range);
+    EXPECT_THROW(transcoder.binaryToJson<SimpleStringMessage>(QByteArray::fromHex("3001")), std::invalid_argument);
+}
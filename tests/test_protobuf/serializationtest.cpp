@@ -26,23 +26,14 @@
 #include "serializationtest.h"
 
 #include "simpletest.qpb.h"
+#include "sequencetest.qpb.h"
+
+#include <QBuffer>
 
 using namespace qtprotobufnamespace::tests;
 using namespace QtProtobuf::tests;
 using namespace QtProtobuf;
 
-
-void SerializationTest::SetUpTestCase()
-{
-    //Register all types
-    QtProtobuf::qRegisterProtobufTypes();
-}
-
-void SerializationTest::SetUp()
-{
-    serializer.reset(new QProtobufSerializer);
-}
-
 TEST_F(SerializationTest, IntMessageSerializeTest)
 {
     SimpleIntMessage test;
@@ -1088,6 +1079,34 @@ TEST_F(SerializationTest, RepeatedFloatMessageTest)
     ASSERT_TRUE(result.isEmpty());
 }
 
+TEST_F(SerializationTest, UnsetComplexTypeSerializeTest)
+{
+    ComplexMessage test;
+    test.setTestFieldInt(42);
+    ComplexMessage defaultField(42, SimpleStringMessage{});
+
+    ASSERT_STREQ(test.serialize(serializer.get()).toHex().toStdString().c_str(), "082a");
+    ASSERT_FALSE(test.hasTestComplexField());
+    ASSERT_STREQ(defaultField.serialize(serializer.get()).toHex().toStdString().c_str(), "082a1200");
+    ASSERT_TRUE(defaultField.hasTestComplexField());
+
+    ComplexMessage result;
+    result.deserialize(serializer.get(), QByteArray::fromHex("082a"));
+    ASSERT_FALSE(result.hasTestComplexField());
+    ASSERT_TRUE(result == defaultField);
+}
+
+TEST_F(SerializationTest, RecursiveMessageSerializeTest)
+{
+    sequence::CyclingFirstDependency test;
+    ASSERT_TRUE(test.serialize(serializer.get()).isEmpty());
+    ASSERT_FALSE(test.hasTestField());
+
+    test.deserialize(serializer.get(), QByteArray::fromHex("0a020a00"));
+    ASSERT_STREQ(test.serialize(serializer.get()).toHex().toStdString().c_str(), "0a020a00");
+    ASSERT_TRUE(test.hasTestField());
+}
+
 TEST_F(SerializationTest, RepeatedComplexMessageTest)
 {
     SimpleStringMessage stringMsg;
@@ -1302,6 +1321,74 @@ TEST_F(SerializationTest, EmptyStringMessageTest)
     ASSERT_TRUE(result.isEmpty());
 }
 
+TEST_F(SerializationTest, SerializeToDeviceTest)
+{
+    SimpleStringMessage stringMsg;
+    stringMsg.setTestFieldString("qwerty");
+    QSharedPointer<ComplexMessage> msg(new ComplexMessage);
+    msg->setTestFieldInt(25);
+    msg->setTestComplexField(stringMsg);
+    RepeatedComplexMessage repeated;
+    repeated.setTestRepeatedComplex({msg, msg, msg});
+
+    QByteArray result;
+    QBuffer buffer(&result);
+    buffer.open(QIODevice::WriteOnly);
+    ASSERT_TRUE(repeated.serializeTo(serializer.get(), &buffer));
+    ASSERT_TRUE(result == repeated.serialize(serializer.get()));
+
+    SimpleSInt32ComplexMessageMapMessage map;
+    map.setMapField({{10, QSharedPointer<ComplexMessage>(new ComplexMessage{16 , {"ten sixteen"}})}, {-65555, QSharedPointer<ComplexMessage>(new ComplexMessage{10 , {"minus WUT?"}})}});
+    result.clear();
+    buffer.seek(0);
+    ASSERT_TRUE(map.serializeTo(serializer.get(), &buffer));
+    ASSERT_TRUE(result == map.serialize(serializer.get()));
+
+    //Bytes that exceed internal buffer size
+    SimpleBytesMessage bytes;
+    bytes.setTestFieldBytes(QByteArray(100000, 'q'));
+    result.clear();
+    buffer.seek(0);
+    ASSERT_TRUE(bytes.serializeTo(serializer.get(), &buffer));
+    ASSERT_TRUE(result == bytes.serialize(serializer.get()));
+
+    buffer.close();
+    ASSERT_FALSE(bytes.serializeTo(serializer.get(), &buffer));
+}
+
+TEST_F(SerializationTest, SerializeToDeviceDefaultValuesTest)
+{
+    QByteArray result;
+    QBuffer buffer(&result);
+    buffer.open(QIODevice::WriteOnly);
+
+    SimpleBytesMessage bytes;
+    ASSERT_TRUE(bytes.serializeTo(serializer.get(), &buffer));
+    ASSERT_TRUE(result == bytes.serialize(serializer.get()));
+
+    //Empty, but not null bytes are skipped by both serialize and serializeTo
+    bytes.setTestFieldBytes(QByteArray(""));
+    result.clear();
+    buffer.seek(0);
+    ASSERT_TRUE(bytes.serializeTo(serializer.get(), &buffer));
+    ASSERT_TRUE(result == bytes.serialize(serializer.get()));
+    ASSERT_TRUE(result.isEmpty());
+
+    SimpleStringMessage string;
+    string.setTestFieldString(QString(""));
+    result.clear();
+    buffer.seek(0);
+    ASSERT_TRUE(string.serializeTo(serializer.get(), &buffer));
+    ASSERT_TRUE(result == string.serialize(serializer.get()));
+    ASSERT_TRUE(result.isEmpty());
+
+    ComplexMessage complex(42, SimpleStringMessage{});
+    result.clear();
+    buffer.seek(0);
+    ASSERT_TRUE(complex.serializeTo(serializer.get(), &buffer));
+    ASSERT_STREQ(result.toHex().toStdString().c_str(), complex.serialize(serializer.get()).toHex().toStdString().c_str());
+}
+
 TEST_F(SerializationTest, DISABLED_BenchmarkTest)
 {
     SimpleIntMessage msg;
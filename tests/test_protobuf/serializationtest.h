@@ -31,12 +31,18 @@
 namespace QtProtobuf {
 namespace tests {
 
+//Fixture is shared by tests of all generator options, so it's defined inline
 class SerializationTest : public ::testing::Test
 {
 public:
     SerializationTest() = default;
-    void SetUp() override;
-    static void SetUpTestCase();
+    void SetUp() override {
+        serializer.reset(new QProtobufSerializer);
+    }
+    static void SetUpTestCase() {
+        //Register all types
+        QtProtobuf::qRegisterProtobufTypes();
+    }
 protected:
     std::unique_ptr<QProtobufSerializer> serializer;
 };
@@ -0,0 +1,211 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "serializationtest.h"
+
+#include "simpletest.qpb.h"
+
+#include <qabstractprotobufsinkserializer.h>
+#include <qprotobufjsonserializer.h>
+#include <qprotobufmetaobject.h>
+#include <qprotobufmetaproperty.h>
+
+#include <QBuffer>
+
+#include <map>
+
+using namespace qtprotobufnamespace::tests;
+using namespace QtProtobuf::tests;
+using namespace QtProtobuf;
+
+namespace {
+//Simple text format to verify that core passes same sink to serializer for nested messages
+class TextSinkSerializer : public QAbstractProtobufSinkSerializer
+{
+public:
+    void readMessage(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const override {
+        const QList<QByteArray> fields = QByteArray::fromRawData(it.data(), it.size()).split(';');
+        for (const auto &field : fields) {
+            int separator = field.indexOf('=');
+            if (separator < 0) {
+                continue;
+            }
+            auto ordering = metaObject.propertyOrdering.find(field.left(separator).toInt());
+            if (ordering != metaObject.propertyOrdering.end()) {
+                metaObject.writeProperty(object, metaObject.staticMetaObject.property(ordering->second), QString::fromUtf8(field.mid(separator + 1)));
+            }
+        }
+        it += it.size();
+    }
+
+    void writeMessage(const void *object, const QProtobufMetaObject &metaObject, QProtobufWriter &writer) const override {
+        const std::map<int, int> ordering(metaObject.propertyOrdering.begin(), metaObject.propertyOrdering.end());
+        for (const auto &field : ordering) {
+            QMetaProperty metaProperty = metaObject.staticMetaObject.property(field.second);
+            QVariant value = metaObject.readProperty(object, metaProperty);
+            auto handler = QtProtobufPrivate::findHandler(value.userType());
+            if (handler.serializer) {
+                handler.serializer(this, value, QProtobufMetaProperty(metaProperty, field.first), writer);
+            } else {
+                writer.write(QByteArray::number(field.first) + "=" + toText(value) + ";");
+            }
+        }
+    }
+
+    void writeObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override {
+        writer.write(QByteArray::number(metaProperty.protoFieldIndex()) + "{");
+        writeMessage(object, metaObject, writer);
+        writer.write(QByteArray("}"));
+    }
+
+    void writeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override {
+        writeObject(object, metaObject, metaProperty, writer);
+    }
+
+    void writeMapPair(const QVariant &key, const QVariant &value, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override {
+        writer.write(QByteArray::number(metaProperty.protoFieldIndex()) + "{" + toText(key) + "=" + toText(value) + "}");
+    }
+
+    void writeEnum(int64 value, const QMetaEnum &/*metaEnum*/, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override {
+        writer.write(QByteArray::number(metaProperty.protoFieldIndex()) + "=" + QByteArray::number(value._t) + ";");
+    }
+
+    void writeEnumList(const QList<int64> &value, const QMetaEnum &metaEnum, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override {
+        for (auto enumValue : value) {
+            writeEnum(enumValue, metaEnum, metaProperty, writer);
+        }
+    }
+
+    void deserializeObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const override {
+        readMessage(object, metaObject, it);
+    }
+
+    bool deserializeListObject(void *object, const QProtobufMetaObject &metaObject, QProtobufSelfcheckIterator &it) const override {
+        readMessage(object, metaObject, it);
+        return true;
+    }
+
+    bool deserializeMapPair(QVariant &/*key*/, QVariant &/*value*/, QProtobufSelfcheckIterator &/*it*/) const override {
+        return false;
+    }
+
+    void deserializeEnum(int64 &/*value*/, const QMetaEnum &/*metaEnum*/, QProtobufSelfcheckIterator &/*it*/) const override {}
+    void deserializeEnumList(QList<int64> &/*value*/, const QMetaEnum &/*metaEnum*/, QProtobufSelfcheckIterator &/*it*/) const override {}
+
+private:
+    static QByteArray toText(const QVariant &value) {
+        return value.userType() == QMetaType::QString ? value.toString().toUtf8() : QByteArray::number(value.toLongLong());
+    }
+};
+
+//JSON serializer that falls back to default list adapters, so list separators are handled by writer
+class JsonListAdapterSerializer : public QProtobufJsonSerializer
+{
+protected:
+    void writeListBegin(const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override {
+        QAbstractProtobufSerializer::writeListBegin(metaProperty, writer);
+    }
+    void writeListObject(const void *object, const QProtobufMetaObject &metaObject, const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override {
+        QAbstractProtobufSerializer::writeListObject(object, metaObject, metaProperty, writer);
+    }
+    void writeListEnd(const QProtobufMetaProperty &metaProperty, QProtobufWriter &writer) const override {
+        QAbstractProtobufSerializer::writeListEnd(metaProperty, writer);
+    }
+};
+}
+
+TEST_F(SerializationTest, SinkSerializerTest)
+{
+    TextSinkSerializer textSerializer;
+    ComplexMessage message;
+    message.setTestFieldInt(25);
+    message.setTestComplexField(SimpleStringMessage("qwerty"));
+
+    ASSERT_STREQ(message.serialize(&textSerializer).toStdString().c_str(), "1=25;2{6=qwerty;}");
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    ASSERT_TRUE(message.serializeTo(&textSerializer, &buffer));
+    ASSERT_STREQ(data.toStdString().c_str(), "1=25;2{6=qwerty;}");
+}
+
+TEST_F(SerializationTest, SinkSerializerRepeatedTest)
+{
+    TextSinkSerializer textSerializer;
+    QSharedPointer<ComplexMessage> first(new ComplexMessage);
+    first->setTestFieldInt(1);
+    first->setTestComplexField(SimpleStringMessage("a"));
+    QSharedPointer<ComplexMessage> second(new ComplexMessage);
+    second->setTestFieldInt(2);
+    second->setTestComplexField(SimpleStringMessage("b"));
+    RepeatedComplexMessage message;
+    message.setTestRepeatedComplex({first, second});
+
+    ASSERT_STREQ(message.serialize(&textSerializer).toStdString().c_str(), "1{1=1;2{6=a;}}1{1=2;2{6=b;}}");
+}
+
+TEST_F(SerializationTest, SinkSerializerReadTest)
+{
+    TextSinkSerializer textSerializer;
+    SimpleStringMessage message;
+    message.deserialize(&textSerializer, "6=qwerty;");
+    ASSERT_STREQ(message.testFieldString().toStdString().c_str(), "qwerty");
+}
+
+TEST_F(SerializationTest, LegacySerializerWriterAdapterTest)
+{
+    QSharedPointer<ComplexMessage> element(new ComplexMessage);
+    element->setTestFieldInt(25);
+    element->setTestComplexField(SimpleStringMessage("qwerty"));
+    RepeatedComplexMessage message;
+    message.setTestRepeatedComplex({element, element});
+
+    //QByteArray based serializers are adapted by default implementations of write family methods
+    QProtobufJsonSerializer jsonSerializer;
+    QAbstractProtobufSerializer *legacySerializer = &jsonSerializer;
+    QByteArray data;
+    QProtobufByteArrayWriter writer(data);
+    legacySerializer->writeMessage(&message, RepeatedComplexMessage::protobufMetaObject, writer);
+    ASSERT_EQ(data, message.serialize(&jsonSerializer));
+}
+
+TEST_F(SerializationTest, ListAdapterDeviceSeparatorTest)
+{
+    QSharedPointer<ComplexMessage> element(new ComplexMessage);
+    element->setTestFieldInt(25);
+    element->setTestComplexField(SimpleStringMessage("qwerty"));
+    RepeatedComplexMessage message;
+    message.setTestRepeatedComplex({element, element});
+
+    //Trailing separator of the last list element must be dropped even if writer has no buffer
+    JsonListAdapterSerializer adapterSerializer;
+    QProtobufJsonSerializer jsonSerializer;
+    QByteArray data;
+    QBuffer buffer(&data);
+    ASSERT_TRUE(buffer.open(QIODevice::WriteOnly));
+    ASSERT_TRUE(message.serializeTo(&adapterSerializer, &buffer));
+    ASSERT_EQ(data, message.serialize(&jsonSerializer));
+}
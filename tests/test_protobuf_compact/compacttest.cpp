@@ -0,0 +1,107 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "compacttest.qpb.h"
+
+#include "../test_protobuf/serializationtest.h"
+
+#include <qprotobufjsonserializer.h>
+
+#include <QThread>
+
+using namespace qtprotobufnamespace::compact::tests;
+
+namespace QtProtobuf {
+namespace tests {
+
+using CompactTest = SerializationTest;
+
+TEST_F(CompactTest, ComplexSerializationTest)
+{
+    CompactComplexMessage test;
+    test.setTestComplexField(CompactSimpleMessage(1, {"a"}));
+    EXPECT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("0a060802120161"));
+}
+
+TEST_F(CompactTest, ComplexDeserializationTest)
+{
+    CompactComplexMessage test;
+    test.deserialize(serializer.get(), QByteArray::fromHex("0a060802120161"));
+    EXPECT_EQ(test.testComplexField().testFieldInt(), 1);
+    EXPECT_STREQ(test.testComplexField().testFieldString().toStdString().c_str(), "a");
+}
+
+TEST_F(CompactTest, RepeatedSerializationTest)
+{
+    CompactRepeatedMessage test;
+    test.setTestRepeatedComplex({QSharedPointer<CompactSimpleMessage>(new CompactSimpleMessage(1, {"a"})),
+                                 QSharedPointer<CompactSimpleMessage>(new CompactSimpleMessage(-1, {"b"}))});
+    EXPECT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("0a0608021201610a060801120162"));
+}
+
+TEST_F(CompactTest, RepeatedDeserializationTest)
+{
+    CompactRepeatedMessage test;
+    test.deserialize(serializer.get(), QByteArray::fromHex("0a0608021201610a060801120162"));
+    ASSERT_EQ(test.testRepeatedComplex().count(), 2);
+    EXPECT_EQ(test.testRepeatedComplex().at(0)->testFieldInt(), 1);
+    EXPECT_STREQ(test.testRepeatedComplex().at(0)->testFieldString().toStdString().c_str(), "a");
+    EXPECT_EQ(test.testRepeatedComplex().at(1)->testFieldInt(), -1);
+    EXPECT_STREQ(test.testRepeatedComplex().at(1)->testFieldString().toStdString().c_str(), "b");
+}
+
+TEST_F(CompactTest, ParallelRepeatedTest)
+{
+    serializer->setParallelListThreshold(2);
+    CompactRepeatedMessage test;
+    for (int i = 0; i < 100; i++) {
+        test.testRepeatedComplex().append(QSharedPointer<CompactSimpleMessage>(new CompactSimpleMessage(i, QString::number(i))));
+    }
+    QByteArray data = test.serialize(serializer.get());
+
+    serializer->setParallelListThreshold(0);
+    EXPECT_TRUE(test.serialize(serializer.get()) == data);
+
+    serializer->setParallelListThreshold(2);
+    CompactRepeatedMessage result;
+    result.deserialize(serializer.get(), data);
+    EXPECT_TRUE(result == test);
+    for (const auto &message : result.testRepeatedComplex()) {
+        EXPECT_EQ(message->thread(), QThread::currentThread());
+    }
+}
+
+TEST_F(CompactTest, JsonTest)
+{
+    QProtobufJsonSerializer jsonSerializer;
+    CompactRepeatedMessage test;
+    test.setTestRepeatedComplex({QSharedPointer<CompactSimpleMessage>(new CompactSimpleMessage(1, {"a"}))});
+    CompactRepeatedMessage result;
+    result.deserialize(&jsonSerializer, test.serialize(&jsonSerializer));
+    EXPECT_TRUE(result == test);
+}
+
+}
+}
@@ -0,0 +1,83 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "contiguoustest.qpb.h"
+
+#include "../test_protobuf/serializationtest.h"
+
+#include <type_traits>
+
+using namespace qtprotobufnamespace::contiguous::tests;
+
+namespace QtProtobuf {
+namespace tests {
+
+using ContiguousTest = SerializationTest;
+
+TEST_F(ContiguousTest, StorageTest)
+{
+    ASSERT_FALSE((std::is_base_of<QObject, ContiguousSimpleMessage>::value));
+    ASSERT_TRUE((std::is_same<ContiguousSimpleMessageRepeated, QVector<ContiguousSimpleMessage>>::value));
+
+    ContiguousRepeatedMessage test;
+    test.testRepeatedComplex().append(ContiguousSimpleMessage(1, {"a"}));
+    test.testRepeatedComplex().append(ContiguousSimpleMessage(-1, {"b"}));
+
+    const ContiguousSimpleMessageRepeated &list = test.testRepeatedComplex();
+    ASSERT_EQ(list.count(), 2);
+    EXPECT_EQ(&list.at(1) - &list.at(0), 1);
+}
+
+TEST_F(ContiguousTest, SerializationTest)
+{
+    ContiguousRepeatedMessage test({ContiguousSimpleMessage(1, {"a"}), ContiguousSimpleMessage(-1, {"b"})});
+    EXPECT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("0a0608021201610a060801120162"));
+}
+
+TEST_F(ContiguousTest, DeserializationTest)
+{
+    ContiguousRepeatedMessage test;
+    test.deserialize(serializer.get(), QByteArray::fromHex("0a0608021201610a060801120162"));
+    ASSERT_EQ(test.testRepeatedComplex().count(), 2);
+    EXPECT_EQ(test.testRepeatedComplex().at(0).testFieldInt(), 1);
+    EXPECT_STREQ(test.testRepeatedComplex().at(0).testFieldString().toStdString().c_str(), "a");
+    EXPECT_EQ(test.testRepeatedComplex().at(1).testFieldInt(), -1);
+    EXPECT_STREQ(test.testRepeatedComplex().at(1).testFieldString().toStdString().c_str(), "b");
+}
+
+TEST_F(ContiguousTest, ParallelDeserializationTest)
+{
+    serializer->setParallelListThreshold(2);
+    ContiguousRepeatedMessage test({ContiguousSimpleMessage(1, {"a"}), ContiguousSimpleMessage(-1, {"b"}),
+                                    ContiguousSimpleMessage(2, {"c"})});
+    QByteArray data = test.serialize(serializer.get());
+
+    ContiguousRepeatedMessage result;
+    result.deserialize(serializer.get(), data);
+    EXPECT_TRUE(result == test);
+}
+
+}
+}
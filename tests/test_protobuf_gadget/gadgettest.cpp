@@ -0,0 +1,135 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "gadgettest.qpb.h"
+
+#include "../test_protobuf/serializationtest.h"
+
+#include <qprotobufjsonserializer.h>
+
+using namespace qtprotobufnamespace::gadget::tests;
+
+namespace QtProtobuf {
+namespace tests {
+
+using GadgetTest = SerializationTest;
+
+TEST_F(GadgetTest, GadgetMessageTypeTest)
+{
+    ASSERT_FALSE((std::is_base_of<QObject, GadgetSimpleMessage>::value));
+    ASSERT_FALSE(GadgetSimpleMessage::protobufMetaObject.staticMetaObject.inherits(&QObject::staticMetaObject));
+    ASSERT_EQ(GadgetSimpleMessage::staticMetaObject.propertyCount(), 2);
+    ASSERT_STREQ(GadgetSimpleMessage::staticMetaObject.property(0).name(), "testFieldInt");
+}
+
+TEST_F(GadgetTest, ComplexMessageSerializeTest)
+{
+    GadgetComplexMessage test;
+    test.setTestComplexField(GadgetSimpleMessage{15, {}});
+    ASSERT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("1202081e"));
+}
+
+TEST_F(GadgetTest, ComplexMessageDeserializeTest)
+{
+    GadgetComplexMessage test;
+    test.deserialize(serializer.get(), QByteArray::fromHex("08031207081e12036f6e65"));
+    EXPECT_EQ(test.testFieldInt(), 3);
+    EXPECT_EQ(test.testComplexField().testFieldInt(), 15);
+    EXPECT_STREQ(test.testComplexField().testFieldString().toStdString().c_str(), "one");
+}
+
+TEST_F(GadgetTest, RepeatedMessageSerializeTest)
+{
+    GadgetRepeatedMessage test;
+    test.setTestRepeatedComplex({GadgetSimpleMessage{15, {}}, GadgetSimpleMessage{1, {}}});
+    ASSERT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("0a02081e0a020802"));
+}
+
+TEST_F(GadgetTest, RepeatedMessageDeserializeTest)
+{
+    GadgetRepeatedMessage test;
+    test.deserialize(serializer.get(), QByteArray::fromHex("0a02081e0a020802"));
+    ASSERT_EQ(test.testRepeatedComplex().count(), 2);
+    EXPECT_EQ(test.testRepeatedComplex().at(0).testFieldInt(), 15);
+    EXPECT_EQ(test.testRepeatedComplex().at(1).testFieldInt(), 1);
+}
+
+TEST_F(GadgetTest, MapMessageSerializeTest)
+{
+    GadgetMapMessage test;
+    test.setMapField({{1, GadgetSimpleMessage{15, {}}}});
+    ASSERT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("0a0608021202081e"));
+}
+
+TEST_F(GadgetTest, MapMessageDeserializeTest)
+{
+    GadgetMapMessage test;
+    test.deserialize(serializer.get(), QByteArray::fromHex("0a0608021202081e"));
+    ASSERT_EQ(test.mapField().count(), 1);
+    EXPECT_EQ(test.mapField().value(1).testFieldInt(), 15);
+}
+
+TEST_F(GadgetTest, JsonRoundTripTest)
+{
+    QProtobufJsonSerializer jsonSerializer;
+    GadgetRepeatedMessage test;
+    test.setTestRepeatedComplex({GadgetSimpleMessage{15, {"fifteen"}}, GadgetSimpleMessage{-1, {"minus one"}}});
+    test.setTestRepeatedInt({1, -2, 3});
+
+    GadgetRepeatedMessage result;
+    result.deserialize(&jsonSerializer, test.serialize(&jsonSerializer));
+    EXPECT_TRUE(result == test);
+}
+
+TEST_F(GadgetTest, CopyIndependenceTest)
+{
+    GadgetComplexMessage test(1, GadgetSimpleMessage{15, {"fifteen"}});
+    GadgetComplexMessage copy(test);
+    copy.setTestComplexField(GadgetSimpleMessage{16, {"sixteen"}});
+
+    EXPECT_EQ(test.testComplexField().testFieldInt(), 15);
+    EXPECT_EQ(copy.testComplexField().testFieldInt(), 16);
+    EXPECT_FALSE(test == copy);
+
+    copy = test;
+    EXPECT_TRUE(test == copy);
+
+    GadgetComplexMessage moved(std::move(copy));
+    EXPECT_TRUE(test == moved);
+}
+
+TEST_F(GadgetTest, VariantRoundTripTest)
+{
+    GadgetComplexMessage test(1, GadgetSimpleMessage{15, {"fifteen"}});
+    QVariant value = QVariant::fromValue(test);
+    ASSERT_TRUE(value.canConvert<GadgetComplexMessage>());
+    EXPECT_TRUE(value.value<GadgetComplexMessage>() == test);
+
+    QVariant property = GadgetComplexMessage::staticMetaObject.property(1).readOnGadget(&test);
+    EXPECT_EQ(property.value<GadgetSimpleMessage>().testFieldInt(), 15);
+}
+
+}
+}
@@ -0,0 +1,114 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "hashmaptest.qpb.h"
+
+#include "../test_protobuf/serializationtest.h"
+
+#include <qprotobufjsonserializer.h>
+#include <type_traits>
+
+using namespace qtprotobufnamespace::hashmap::tests;
+
+namespace QtProtobuf {
+namespace tests {
+
+using HashMapTest = SerializationTest;
+
+TEST_F(HashMapTest, StorageTest)
+{
+    static_assert(std::is_same<HashSInt32StringMapMessage::MapFieldEntry, QHash<QtProtobuf::sint32, QString>>::value,
+                  "Map field is not generated as QHash");
+    static_assert(std::is_same<HashStringComplexMessageMapMessage::MapFieldEntry,
+                  QHash<QString, QSharedPointer<HashComplexMessage>>>::value,
+                  "Message map field is not generated as QHash");
+
+    HashSInt32StringMapMessage test;
+    test.setMapField({{10, {"ten"}}, {-42, {"minus fourty two"}}});
+    test.mapField().insert(15, {"fifteen"});
+    EXPECT_EQ(test.mapField().count(), 3);
+    EXPECT_STREQ(test.mapField().value(15).toStdString().c_str(), "fifteen");
+}
+
+TEST_F(HashMapTest, SerializationTest)
+{
+    HashSInt32StringMapMessage test;
+    test.setMapField({{-42, {"minus fourty two"}}});
+    EXPECT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("0a14085312106d696e757320666f757274792074776f"));
+
+    HashFixed32StringMapMessage fixedTest;
+    fixedTest.setMapField({{10, {"ten"}}});
+    EXPECT_EQ(fixedTest.serialize(serializer.get()).toHex(), QByteArray("3a0a0d0a000000120374656e"));
+}
+
+TEST_F(HashMapTest, DeserializationTest)
+{
+    HashSInt32StringMapMessage test;
+    test.deserialize(serializer.get(), QByteArray::fromHex("0a14085312106d696e757320666f757274792074776f0a070814120374656e0a0b081e12076669667465656e"));
+    EXPECT_TRUE(test.mapField() == HashSInt32StringMapMessage::MapFieldEntry({{10, {"ten"}}, {-42, {"minus fourty two"}}, {15, {"fifteen"}}}));
+
+    HashFixed32StringMapMessage fixedTest;
+    fixedTest.deserialize(serializer.get(), QByteArray::fromHex("3a0a0d0a000000120374656e3a0e0d0f00000012076669667465656e3a110d2a000000120a666f757274792074776f"));
+    EXPECT_TRUE(fixedTest.mapField() == HashFixed32StringMapMessage::MapFieldEntry({{10, {"ten"}}, {42, {"fourty two"}}, {15, {"fifteen"}}}));
+}
+
+TEST_F(HashMapTest, ComplexMessageDeserializationTest)
+{
+    HashStringComplexMessageMapMessage test;
+    test.deserialize(serializer.get(), QByteArray::fromHex("6a140a055755543f3f120b120732053f5755543f080a6a170a0362656e1210120c320a74656e20656c6576656e080b6a350a157768657265206973206d792063617220647564653f121c12183216666f757274792074776f2074656e207369787465656e080a"));
+    ASSERT_EQ(test.mapField().count(), 3);
+    EXPECT_TRUE(*test.mapField()["ben"] == HashComplexMessage({11 , {"ten eleven"}}));
+    EXPECT_TRUE(*test.mapField()["where is my car dude?"] == HashComplexMessage({10 , {"fourty two ten sixteen"}}));
+    EXPECT_TRUE(*test.mapField()["WUT??"] == HashComplexMessage({10 , {"?WUT?"}}));
+}
+
+TEST_F(HashMapTest, RoundTripTest)
+{
+    HashSInt32StringMapMessage::MapFieldEntry map;
+    for (int i = -500; i < 500; i++) {
+        map.insert(i, QString::number(i));
+    }
+    HashSInt32StringMapMessage test;
+    test.setMapField(map);
+
+    HashSInt32StringMapMessage result;
+    result.deserialize(serializer.get(), test.serialize(serializer.get()));
+    EXPECT_TRUE(result.mapField() == map);
+}
+
+TEST_F(HashMapTest, JsonTest)
+{
+    QProtobufJsonSerializer jsonSerializer;
+    HashSInt32StringMapMessage test;
+    test.setMapField({{-42, {"minus fourty two"}}});
+    EXPECT_STREQ(test.serialize(&jsonSerializer).toStdString().c_str(), "{\"mapField\":{\"-42\":\"minus fourty two\"}}");
+
+    HashSInt32StringMapMessage result;
+    result.deserialize(&jsonSerializer, QByteArray("{\"mapField\":{\"10\":\"ten\",\"-42\":\"minus fourty two\"}}"));
+    EXPECT_TRUE(result.mapField() == HashSInt32StringMapMessage::MapFieldEntry({{10, {"ten"}}, {-42, {"minus fourty two"}}}));
+}
+
+}
+}
@@ -64,6 +64,7 @@
 #include "qtprotobufnamespace/tests/simplesint32stringmapmessage.h"
 #include "qtprotobufnamespace/tests/simplestringstringmapmessage.h"
 #include "qtprotobufnamespace/tests/emptymessage.h"
+#include "qtprotobufnamespace/tests/simpleunorderedfieldsmessage.h"
 #include "qtprotobufnamespace/tests/message_uderscore_name.h"
 #include "qtprotobufnamespace/tests/messageuderscorename.h"
 #include "qtprotobufnamespace/tests/messageunderscorefield.h"
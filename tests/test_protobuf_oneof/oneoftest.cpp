@@ -0,0 +1,202 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include "oneoftest.qpb.h"
+
+#include "../test_protobuf/serializationtest.h"
+
+#include <qprotobufjsonserializer.h>
+
+using namespace qtprotobufnamespace::oneof::tests;
+
+namespace QtProtobuf {
+namespace tests {
+
+using OneofTest = SerializationTest;
+
+TEST_F(OneofTest, CaseTest)
+{
+    OneofMessage test;
+    EXPECT_EQ(test.payloadCase(), OneofMessage::PayloadCase::NotSet);
+    EXPECT_EQ(test.secondChoiceCase(), OneofMessage::SecondChoiceCase::NotSet);
+    EXPECT_FALSE(test.hasPayloadInt());
+    EXPECT_EQ(test.payloadInt(), 0);
+    EXPECT_TRUE(test.payloadString().isEmpty());
+
+    test.setPayloadInt(0);
+    EXPECT_EQ(test.payloadCase(), OneofMessage::PayloadCase::PayloadInt);
+    EXPECT_TRUE(test.hasPayloadInt());
+    EXPECT_EQ(test.secondChoiceCase(), OneofMessage::SecondChoiceCase::NotSet);
+
+    test.setSecondDouble(1.5);
+    EXPECT_EQ(test.payloadCase(), OneofMessage::PayloadCase::PayloadInt);
+    EXPECT_EQ(test.secondChoiceCase(), OneofMessage::SecondChoiceCase::SecondDouble);
+    EXPECT_EQ(test.secondDouble(), 1.5);
+}
+
+TEST_F(OneofTest, LastOneWinsTest)
+{
+    OneofMessage test;
+    test.setPayloadInt(5);
+    test.setPayloadString("qwerty");
+    EXPECT_EQ(test.payloadCase(), OneofMessage::PayloadCase::PayloadString);
+    EXPECT_FALSE(test.hasPayloadInt());
+    EXPECT_TRUE(test.hasPayloadString());
+    EXPECT_EQ(test.payloadInt(), 0);
+    EXPECT_EQ(test.payloadString(), QString("qwerty"));
+
+    test.setPayloadMessage(OneofSubMessage(3));
+    EXPECT_EQ(test.payloadCase(), OneofMessage::PayloadCase::PayloadMessage);
+    EXPECT_TRUE(test.payloadString().isEmpty());
+    EXPECT_EQ(test.payloadMessage().testFieldInt(), 3);
+
+    test.setPayloadEnum(OneofEnumGadget::ONEOF_VALUE);
+    EXPECT_EQ(test.payloadCase(), OneofMessage::PayloadCase::PayloadEnum);
+    EXPECT_EQ(test.payloadMessage().testFieldInt(), 0);
+    EXPECT_EQ(test.payloadEnum(), OneofEnumGadget::ONEOF_VALUE);
+}
+
+TEST_F(OneofTest, ClearTest)
+{
+    OneofMessage test;
+    test.setPayloadString("qwerty");
+    test.clearPayloadInt();
+    EXPECT_EQ(test.payloadCase(), OneofMessage::PayloadCase::PayloadString);
+
+    test.clearPayloadString();
+    EXPECT_EQ(test.payloadCase(), OneofMessage::PayloadCase::NotSet);
+    EXPECT_TRUE(test.payloadString().isEmpty());
+
+    test.setPayloadInt(1);
+    test.setSecondBytes(QByteArray::fromHex("0102"));
+    test.clearPayload();
+    EXPECT_EQ(test.payloadCase(), OneofMessage::PayloadCase::NotSet);
+    EXPECT_EQ(test.secondChoiceCase(), OneofMessage::SecondChoiceCase::SecondBytes);
+}
+
+TEST_F(OneofTest, SerializationTest)
+{
+    OneofMessage test;
+    EXPECT_TRUE(test.serialize(serializer.get()).isEmpty());
+
+    test.setPayloadInt(5);
+    test.setPayloadString("ab");
+    EXPECT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("1a026162"));
+
+    test.setPayloadInt(0);
+    EXPECT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("1000"));
+
+    test.setPayloadMessage(OneofSubMessage());
+    test.setPlainInt(-1);
+    EXPECT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("08012a00"));
+}
+
+TEST_F(OneofTest, DeserializationTest)
+{
+    OneofMessage test;
+    test.deserialize(serializer.get(), QByteArray::fromHex("100a1a026162"));
+    EXPECT_EQ(test.payloadCase(), OneofMessage::PayloadCase::PayloadString);
+    EXPECT_EQ(test.payloadString(), QString("ab"));
+    EXPECT_EQ(test.payloadInt(), 0);
+
+    OneofMessage second;
+    second.deserialize(serializer.get(), QByteArray::fromHex("39000000000000f83f"));
+    EXPECT_EQ(second.payloadCase(), OneofMessage::PayloadCase::NotSet);
+    EXPECT_EQ(second.secondChoiceCase(), OneofMessage::SecondChoiceCase::SecondDouble);
+    EXPECT_EQ(second.secondDouble(), 1.5);
+}
+
+TEST_F(OneofTest, JsonSerializationTest)
+{
+    QProtobufJsonSerializer jsonSerializer;
+    OneofMessage test;
+    test.setPayloadString("ab");
+    test.setPayloadInt(0);
+    EXPECT_STREQ(QString::fromUtf8(test.serialize(&jsonSerializer)).toStdString().c_str(),
+                 "{\"plainInt\":0,\"payloadInt\":0}");
+
+    OneofMessage restored;
+    restored.deserialize(&jsonSerializer, "{\"payloadString\":\"ab\",\"payloadEnum\":\"ONEOF_VALUE\"}");
+    EXPECT_EQ(restored.payloadCase(), OneofMessage::PayloadCase::PayloadEnum);
+    EXPECT_EQ(restored.payloadEnum(), OneofEnumGadget::ONEOF_VALUE);
+}
+
+TEST_F(OneofTest, CopyTest)
+{
+    OneofMessage test;
+    test.setPayloadString("qwerty");
+    test.setSecondDouble(2.0);
+
+    OneofMessage copy(test);
+    EXPECT_EQ(copy.payloadCase(), OneofMessage::PayloadCase::PayloadString);
+    EXPECT_EQ(copy.payloadString(), QString("qwerty"));
+    EXPECT_TRUE(copy == test);
+
+    OneofMessage assigned;
+    assigned.setPayloadInt(1);
+    EXPECT_FALSE(assigned == test);
+    assigned = test;
+    EXPECT_EQ(assigned.payloadCase(), OneofMessage::PayloadCase::PayloadString);
+    EXPECT_FALSE(assigned.hasPayloadInt());
+    EXPECT_TRUE(assigned == test);
+
+    OneofMessage moved(std::move(assigned));
+    EXPECT_EQ(moved.payloadCase(), OneofMessage::PayloadCase::PayloadString);
+    EXPECT_EQ(assigned.payloadCase(), OneofMessage::PayloadCase::NotSet);
+    EXPECT_EQ(moved.serialize(serializer.get()).toHex(), QByteArray("1a06717765727479390000000000000040"));
+}
+
+TEST_F(OneofTest, StorageAccessTest)
+{
+    QProtobufOneof oneof;
+    const QProtobufOneof &constOneof = oneof;
+    EXPECT_EQ(constOneof.constData<int>(2), nullptr);
+    EXPECT_EQ(constOneof.value<int>(2), 0);
+    EXPECT_EQ(constOneof.fieldNumber(), 0);
+
+    *oneof.data<int>(2) = 5;
+    EXPECT_TRUE(oneof.holds(2));
+    ASSERT_NE(constOneof.constData<int>(2), nullptr);
+    EXPECT_EQ(*constOneof.constData<int>(2), 5);
+}
+
+TEST_F(OneofTest, MessagePointerTest)
+{
+    OneofMessage test;
+    EXPECT_EQ(test.payloadMessage_p(), nullptr);
+    EXPECT_EQ(test.property("payloadMessage").value<OneofSubMessage *>(), nullptr);
+    EXPECT_EQ(test.payloadCase(), OneofMessage::PayloadCase::NotSet);
+
+    test.setPayloadMessage(OneofSubMessage(3));
+    OneofMessage copy(test);
+    ASSERT_NE(copy.payloadMessage_p(), nullptr);
+    EXPECT_NE(copy.payloadMessage_p(), test.payloadMessage_p());
+
+    copy.payloadMessage_p()->setTestFieldInt(4);
+    EXPECT_EQ(test.payloadMessage().testFieldInt(), 3);
+    EXPECT_EQ(copy.payloadMessage().testFieldInt(), 4);
+}
+
+}
+}
@@ -0,0 +1,165 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "presencetest.qpb.h"
+
+#include "../test_protobuf/serializationtest.h"
+
+#include <QBuffer>
+
+using namespace qtprotobufnamespace::presence::tests;
+
+namespace QtProtobuf {
+namespace tests {
+
+using PresenceTest = SerializationTest;
+
+TEST_F(PresenceTest, HasAndClearTest)
+{
+    PresenceMessage test;
+    EXPECT_FALSE(test.hasOptionalInt());
+    EXPECT_FALSE(test.hasOptionalString());
+
+    test.setOptionalInt(0);
+    EXPECT_TRUE(test.hasOptionalInt());
+    EXPECT_EQ(test.optionalInt(), 0);
+
+    test.setOptionalString("qwerty");
+    EXPECT_TRUE(test.hasOptionalString());
+
+    test.clearOptionalString();
+    EXPECT_FALSE(test.hasOptionalString());
+    EXPECT_TRUE(test.optionalString().isEmpty());
+
+    test.setPlainInt(5);
+    test.clearPlainInt();
+    EXPECT_EQ(test.plainInt(), 0);
+
+    test.setSubMessage(PresenceSubMessage(1));
+    EXPECT_TRUE(test.hasSubMessage());
+    test.clearSubMessage();
+    EXPECT_FALSE(test.hasSubMessage());
+}
+
+TEST_F(PresenceTest, UnsetFieldsSerializationTest)
+{
+    PresenceMessage test;
+    EXPECT_TRUE(test.serialize(serializer.get()).isEmpty());
+
+    test.setPlainInt(0);
+    test.setRepeatedInt({});
+    EXPECT_TRUE(test.serialize(serializer.get()).isEmpty());
+}
+
+TEST_F(PresenceTest, ImplicitPresenceTest)
+{
+    PresenceMessage test;
+    const quint32 *bits = PresenceMessage::protobufMetaObject.presenceInfo->bits(static_cast<const QObject *>(&test));
+    const quint32 plainIntBit = 1u << 4;
+    const quint32 repeatedIntBit = 1u << 6;
+
+    test.setPlainInt(5);
+    EXPECT_NE(bits[0] & plainIntBit, 0u);
+    test.setPlainInt(0);
+    EXPECT_EQ(bits[0] & plainIntBit, 0u);
+
+    test.setRepeatedInt({1});
+    EXPECT_NE(bits[0] & repeatedIntBit, 0u);
+    test.setRepeatedInt({});
+    EXPECT_EQ(bits[0] & repeatedIntBit, 0u);
+
+    test.setSubMessage(PresenceSubMessage());
+    EXPECT_TRUE(test.hasSubMessage());
+    EXPECT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("3200"));
+}
+
+TEST_F(PresenceTest, DefaultValueSerializationTest)
+{
+    PresenceMessage test;
+    test.setOptionalInt(0);
+    EXPECT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("0800"));
+
+    test.clearOptionalInt();
+    test.setOptionalString({});
+    EXPECT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("1200"));
+
+    test.clearOptionalString();
+    test.setOptionalDouble(0.0);
+    EXPECT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("190000000000000000"));
+
+    test.clearOptionalDouble();
+    test.setOptionalEnum(PresenceEnumGadget::PRESENCE_DEFAULT);
+    EXPECT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("2000"));
+}
+
+TEST_F(PresenceTest, SparseSerializationTest)
+{
+    PresenceMessage test;
+    test.setOptionalInt(-1);
+    test.setPlainInt(0);
+    test.setRepeatedInt({1, 2});
+    EXPECT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("08013a020204"));
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    ASSERT_TRUE(test.serializeTo(serializer.get(), &buffer));
+    EXPECT_EQ(data.toHex(), QByteArray("08013a020204"));
+}
+
+TEST_F(PresenceTest, DeserializationTest)
+{
+    PresenceMessage test;
+    test.deserialize(serializer.get(), QByteArray::fromHex("08001200"));
+    EXPECT_TRUE(test.hasOptionalInt());
+    EXPECT_EQ(test.optionalInt(), 0);
+    EXPECT_TRUE(test.hasOptionalString());
+    EXPECT_FALSE(test.hasOptionalDouble());
+    EXPECT_FALSE(test.hasOptionalEnum());
+    EXPECT_EQ(test.serialize(serializer.get()).toHex(), QByteArray("08001200"));
+}
+
+TEST_F(PresenceTest, CopyTest)
+{
+    PresenceMessage test;
+    test.setOptionalInt(0);
+    test.setPlainInt(3);
+
+    PresenceMessage copy(test);
+    EXPECT_TRUE(copy.hasOptionalInt());
+    EXPECT_FALSE(copy.hasOptionalString());
+    EXPECT_EQ(copy.plainInt(), 3);
+
+    PresenceMessage assigned;
+    assigned.setOptionalString("qwerty");
+    assigned = test;
+    EXPECT_TRUE(assigned.hasOptionalInt());
+    EXPECT_FALSE(assigned.hasOptionalString());
+    EXPECT_TRUE(assigned.optionalString().isEmpty());
+    EXPECT_EQ(assigned.serialize(serializer.get()).toHex(), QByteArray("08002806"));
+}
+
+}
+}
@@ -0,0 +1,75 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "shareddatatest.qpb.h"
+
+#include "../test_protobuf/serializationtest.h"
+
+#include <type_traits>
+
+using namespace qtprotobufnamespace::shareddata::tests;
+
+namespace QtProtobuf {
+namespace tests {
+
+using SharedDataGadgetTest = SerializationTest;
+
+TEST_F(SharedDataGadgetTest, GadgetMessageTypeTest)
+{
+    ASSERT_FALSE((std::is_base_of<QObject, SharedComplexMessage>::value));
+    ASSERT_FALSE(SharedComplexMessage::protobufMetaObject.staticMetaObject.inherits(&QObject::staticMetaObject));
+}
+
+TEST_F(SharedDataGadgetTest, CopyDetachTest)
+{
+    SharedComplexMessage test(10, SharedSimpleMessage{15, {"fifteen"}}, {1, 2, 3});
+    SharedComplexMessage copy(test);
+    EXPECT_TRUE(copy == test);
+    EXPECT_EQ(&copy.testComplexField(), &test.testComplexField());
+
+    copy.setTestFieldInt(11);
+    copy.setTestComplexField(SharedSimpleMessage{16, {"sixteen"}});
+    EXPECT_EQ(test.testFieldInt(), 10);
+    EXPECT_EQ(test.testComplexField().testFieldInt(), 15);
+    EXPECT_EQ(copy.testFieldInt(), 11);
+    EXPECT_EQ(copy.testComplexField().testFieldInt(), 16);
+}
+
+TEST_F(SharedDataGadgetTest, SerializationTest)
+{
+    SharedComplexMessage test(10, SharedSimpleMessage{15, {}}, {});
+    SharedComplexMessage copy(test);
+    ASSERT_EQ(copy.serialize(serializer.get()).toHex(), QByteArray("080a1202081e"));
+    EXPECT_EQ(&copy.testComplexField(), &test.testComplexField());
+
+    SharedComplexMessage result;
+    result.deserialize(serializer.get(), QByteArray::fromHex("080a1202081e1a020204"));
+    EXPECT_EQ(result.testFieldInt(), 10);
+    EXPECT_EQ(result.testComplexField().testFieldInt(), 15);
+    EXPECT_EQ(result.testRepeatedInt(), QtProtobuf::sint32List({1, 2}));
+}
+
+}
+}
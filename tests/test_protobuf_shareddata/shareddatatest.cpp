@@ -0,0 +1,112 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "shareddatatest.qpb.h"
+
+#include "../test_protobuf/serializationtest.h"
+
+#include <QSignalSpy>
+
+using namespace qtprotobufnamespace::shareddata::tests;
+
+namespace QtProtobuf {
+namespace tests {
+
+using SharedDataTest = SerializationTest;
+
+TEST_F(SharedDataTest, CopyDetachTest)
+{
+    SharedComplexMessage test(10, SharedSimpleMessage{15, {"fifteen"}}, {1, 2, 3});
+    SharedComplexMessage copy(test);
+    EXPECT_TRUE(copy == test);
+
+    copy.setTestFieldInt(11);
+    copy.testRepeatedInt().append(4);
+    EXPECT_EQ(test.testFieldInt(), 10);
+    EXPECT_EQ(test.testRepeatedInt(), QtProtobuf::sint32List({1, 2, 3}));
+    EXPECT_EQ(copy.testFieldInt(), 11);
+    EXPECT_EQ(copy.testRepeatedInt(), QtProtobuf::sint32List({1, 2, 3, 4}));
+}
+
+TEST_F(SharedDataTest, NestedMessageDetachTest)
+{
+    SharedComplexMessage test(10, SharedSimpleMessage{15, {"fifteen"}}, {});
+    SharedComplexMessage copy(test);
+
+    copy.setTestComplexField(SharedSimpleMessage{16, {"sixteen"}});
+    EXPECT_EQ(test.testComplexField().testFieldInt(), 15);
+    EXPECT_EQ(copy.testComplexField().testFieldInt(), 16);
+
+    SharedComplexMessage pointerCopy(test);
+    EXPECT_EQ(pointerCopy.testComplexField_p(), test.testComplexField_p());
+    EXPECT_EQ(&pointerCopy.testComplexField(), &test.testComplexField());
+}
+
+TEST_F(SharedDataTest, AssignmentSignalsTest)
+{
+    SharedComplexMessage test(10, SharedSimpleMessage{15, {"fifteen"}}, {1});
+    SharedComplexMessage other(10, SharedSimpleMessage{16, {"sixteen"}}, {1});
+
+    QSignalSpy intSpy(&test, &SharedComplexMessage::testFieldIntChanged);
+    QSignalSpy complexSpy(&test, &SharedComplexMessage::testComplexFieldChanged);
+    QSignalSpy repeatedSpy(&test, &SharedComplexMessage::testRepeatedIntChanged);
+
+    test = other;
+    EXPECT_TRUE(test == other);
+    EXPECT_EQ(intSpy.count(), 0);
+    EXPECT_EQ(complexSpy.count(), 1);
+    EXPECT_EQ(repeatedSpy.count(), 0);
+
+    test = other;
+    EXPECT_EQ(complexSpy.count(), 1);
+}
+
+TEST_F(SharedDataTest, SerializationTest)
+{
+    SharedComplexMessage test(10, SharedSimpleMessage{15, {}}, {});
+    SharedComplexMessage copy(test);
+    ASSERT_EQ(copy.serialize(serializer.get()).toHex(), QByteArray("080a1202081e"));
+
+    SharedComplexMessage result;
+    result.deserialize(serializer.get(), QByteArray::fromHex("080a1202081e1a020204"));
+    EXPECT_EQ(result.testFieldInt(), 10);
+    EXPECT_EQ(result.testComplexField().testFieldInt(), 15);
+    EXPECT_EQ(result.testRepeatedInt(), QtProtobuf::sint32List({1, 2}));
+    EXPECT_EQ(test.testRepeatedInt().count(), 0);
+}
+
+TEST_F(SharedDataTest, SerializationSharingTest)
+{
+    SharedComplexMessage test(10, SharedSimpleMessage{15, {"fifteen"}}, {1, 2});
+    SharedComplexMessage copy(test);
+
+    copy.serialize(serializer.get());
+    test.serialize(serializer.get());
+    EXPECT_EQ(&copy.testComplexField(), &test.testComplexField());
+    EXPECT_EQ(copy.testComplexField_p(), test.testComplexField_p());
+}
+
+}
+}
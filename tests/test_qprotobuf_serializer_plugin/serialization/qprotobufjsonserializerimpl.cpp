@@ -32,7 +32,7 @@ QProtobufJsonSerializerImpl::QProtobufJsonSerializerImpl()
 {
 }
 
-QByteArray QProtobufJsonSerializerImpl::serializeMessage(const QObject *object,
+QByteArray QProtobufJsonSerializerImpl::serializeMessage(const void *object,
                                                          const QtProtobuf::QProtobufMetaObject &metaObject) const
 {
     Q_UNUSED(object)
@@ -40,7 +40,7 @@ QByteArray QProtobufJsonSerializerImpl::serializeMessage(const QObject *object,
     return QByteArray();
 }
 
-void QProtobufJsonSerializerImpl::deserializeMessage(QObject *object, const QtProtobuf::QProtobufMetaObject &metaObject,
+void QProtobufJsonSerializerImpl::deserializeMessage(void *object, const QtProtobuf::QProtobufMetaObject &metaObject,
                                                      const QByteArray &data) const
 {
     Q_UNUSED(object)
@@ -48,7 +48,7 @@ void QProtobufJsonSerializerImpl::deserializeMessage(QObject *object, const QtPr
     Q_UNUSED(metaObject)
 }
 
-QByteArray QProtobufJsonSerializerImpl::serializeObject(const QObject *object,
+QByteArray QProtobufJsonSerializerImpl::serializeObject(const void *object,
                                                         const QtProtobuf::QProtobufMetaObject &metaObject,
                                                         const QtProtobuf::QProtobufMetaProperty &/*metaProperty*/) const
 {
@@ -57,7 +57,7 @@ QByteArray QProtobufJsonSerializerImpl::serializeObject(const QObject *object,
     return QByteArray();
 }
 
-void QProtobufJsonSerializerImpl::deserializeObject(QObject *object,
+void QProtobufJsonSerializerImpl::deserializeObject(void *object,
                                                     const QtProtobuf::QProtobufMetaObject &metaObject,
                                                     QtProtobuf::QProtobufSelfcheckIterator &it) const
 {
@@ -66,7 +66,7 @@ void QProtobufJsonSerializerImpl::deserializeObject(QObject *object,
     Q_UNUSED(metaObject)
 }
 
-QByteArray QProtobufJsonSerializerImpl::serializeListObject(const QObject *object,
+QByteArray QProtobufJsonSerializerImpl::serializeListObject(const void *object,
                                                             const QtProtobuf::QProtobufMetaObject &metaObject,
                                                             const QtProtobuf::QProtobufMetaProperty &metaProperty) const
 {
@@ -76,7 +76,7 @@ QByteArray QProtobufJsonSerializerImpl::serializeListObject(const QObject *objec
     return QByteArray();
 }
 
-bool QProtobufJsonSerializerImpl::deserializeListObject(QObject *object,
+bool QProtobufJsonSerializerImpl::deserializeListObject(void *object,
                                                         const QtProtobuf::QProtobufMetaObject &metaObject,
                                                         QtProtobuf::QProtobufSelfcheckIterator &it) const
 {
@@ -35,7 +35,7 @@ QProtobufSerializerImpl::~QProtobufSerializerImpl()
 {
 }
 
-QByteArray QProtobufSerializerImpl::serializeMessage(const QObject *object,
+QByteArray QProtobufSerializerImpl::serializeMessage(const void *object,
                                                      const QtProtobuf::QProtobufMetaObject &metaObject) const
 {
     Q_UNUSED(object)
@@ -43,7 +43,7 @@ QByteArray QProtobufSerializerImpl::serializeMessage(const QObject *object,
     return QByteArray();
 }
 
-void QProtobufSerializerImpl::deserializeMessage(QObject *object,
+void QProtobufSerializerImpl::deserializeMessage(void *object,
                                                  const QtProtobuf::QProtobufMetaObject &metaObject,
                                                  const QByteArray &data) const
 {
@@ -52,7 +52,7 @@ void QProtobufSerializerImpl::deserializeMessage(QObject *object,
     Q_UNUSED(metaObject)
 }
 
-QByteArray QProtobufSerializerImpl::serializeObject(const QObject *object,
+QByteArray QProtobufSerializerImpl::serializeObject(const void *object,
                                                     const QtProtobuf::QProtobufMetaObject &metaObject,
                                                     const QtProtobuf::QProtobufMetaProperty &metaProperty) const
 {
@@ -62,7 +62,7 @@ QByteArray QProtobufSerializerImpl::serializeObject(const QObject *object,
     return QByteArray();
 }
 
-void QProtobufSerializerImpl::deserializeObject(QObject *object,
+void QProtobufSerializerImpl::deserializeObject(void *object,
                                                 const QtProtobuf::QProtobufMetaObject &metaObject,
                                                 QtProtobuf::QProtobufSelfcheckIterator &it) const
 {
@@ -71,14 +71,14 @@ void QProtobufSerializerImpl::deserializeObject(QObject *object,
     Q_UNUSED(metaObject)
 }
 
-QByteArray QProtobufSerializerImpl::serializeListObject(const QObject *object,
+QByteArray QProtobufSerializerImpl::serializeListObject(const void *object,
                                                         const QtProtobuf::QProtobufMetaObject &metaObject,
                                                         const QtProtobuf::QProtobufMetaProperty &metaProperty) const
 {
     return serializeObject(object, metaObject, metaProperty);
 }
 
-bool QProtobufSerializerImpl::deserializeListObject(QObject *object,
+bool QProtobufSerializerImpl::deserializeListObject(void *object,
                                                     const QtProtobuf::QProtobufMetaObject &metaObject,
                                                     QtProtobuf::QProtobufSelfcheckIterator &it) const
 {
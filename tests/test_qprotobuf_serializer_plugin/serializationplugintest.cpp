@@ -25,6 +25,7 @@
 
 #include "serializationplugintest.h"
 #include "qprotobufserializerregistry_p.h"
+#include "qabstractprotobufsinkserializer.h"
 
 using namespace QtProtobuf::tests;
 using namespace QtProtobuf;
@@ -78,3 +79,24 @@ TEST_F(SerializationPluginTest, UnknownPluginLoadedSerializeTest)
 {
     ASSERT_ANY_THROW(QProtobufSerializerRegistry::instance().getSerializer("SomeName", loadedTestPlugin));
 }
+
+TEST_F(SerializationPluginTest, SinkPluginPreferredTest)
+{
+    QString sinkPlugin = QProtobufSerializerRegistry::instance().loadPlugin("sinkserializationplugin");
+    ASSERT_STREQ(sinkPlugin.toStdString().c_str(), "TestSinkPlugin");
+    auto serializer = QProtobufSerializerRegistry::instance().getSerializer(ProtobufSerializator, sinkPlugin);
+    ASSERT_NE(serializer.get(), nullptr);
+    ASSERT_NE(dynamic_cast<QAbstractProtobufSinkSerializer *>(serializer.get()), nullptr);
+}
+
+#ifdef QT_PROTOBUF_COMPRESSION_PLUGIN
+TEST_F(SerializationPluginTest, CompressionPluginLoadTest)
+{
+    QString compressionPlugin = QProtobufSerializerRegistry::instance().loadPlugin("protobufcompression");
+    ASSERT_STREQ(compressionPlugin.toStdString().c_str(), "QtProtobufCompression");
+    ASSERT_TRUE(QProtobufSerializerRegistry::instance().pluginSerializers(compressionPlugin)
+                == QStringList({"protobuf", "protobuf-fast", "protobuf-best", "json"}));
+    ASSERT_NE(QProtobufSerializerRegistry::instance().getSerializer(ProtobufSerializator, compressionPlugin).get(), nullptr);
+    ASSERT_NE(QProtobufSerializerRegistry::instance().getSerializer(JsonSerializator, compressionPlugin).get(), nullptr);
+}
+#endif
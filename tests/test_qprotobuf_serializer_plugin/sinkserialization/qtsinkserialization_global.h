@@ -23,10 +23,12 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
-#include "qprotobufmetaobject.h"
-using namespace QtProtobuf;
-QProtobufMetaObject::QProtobufMetaObject(const QMetaObject &_staticMetaObject, const QProtobufPropertyOrdering &_propertyOrdering)
-    : staticMetaObject(_staticMetaObject)
-    , propertyOrdering(_propertyOrdering)
-{
-}
+#pragma once
+
+#include <QtCore/QtGlobal>
+
+#ifdef SINK_SERIALIZATION_LIB
+    #define SINKSERIALIZATIONSHARED_EXPORT Q_DECL_EXPORT
+#else
+    #define SINKSERIALIZATIONSHARED_EXPORT Q_DECL_IMPORT
+#endif
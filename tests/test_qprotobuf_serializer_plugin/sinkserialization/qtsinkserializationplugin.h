@@ -0,0 +1,50 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019 Alexey Edelev <semlanik@gmail.com>
+ *
+ * This file is part of QtProtobuf project https://git.semlanik.org/semlanik/qtprotobuf
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and
+ * to permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies
+ * or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ * PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ * FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <QObject>
+#include "qprotobufserializationplugininterface.h"
+#include "qtsinkserialization_global.h"
+
+/*!
+ * \private
+ * \brief The QtSinkSerializationPlugin class implements both generations of serialization plugin interface
+ */
+class SINKSERIALIZATIONSHARED_EXPORT QtSinkSerializationPlugin : public QObject,
+        QtProtobuf::QProtobufSerializationPluginInterface,
+        QtProtobuf::QProtobufSinkSerializationPluginInterface
+{
+    Q_OBJECT
+    Q_PLUGIN_METADATA(IID SinkSerializatorInterface_iid FILE "sinkserializeinfo.json")
+    Q_INTERFACES(QtProtobuf::QProtobufSerializationPluginInterface QtProtobuf::QProtobufSinkSerializationPluginInterface)
+
+public:
+    QtSinkSerializationPlugin() = default;
+    ~QtSinkSerializationPlugin() = default;
+
+    std::shared_ptr<QtProtobuf::QAbstractProtobufSerializer> serializer(const QString &serializerName) override;
+    std::shared_ptr<QtProtobuf::QAbstractProtobufSinkSerializer> sinkSerializer(const QString &serializerName) override;
+};